@@ -47,6 +47,7 @@ SERVICE_ARG_NATIVE_TYPES = {
     "string[]": cg.std_vector.template(cg.std_string),
 }
 CONF_ENCRYPTION = "encryption"
+CONF_BATCH_DELAY = "batch_delay"
 
 
 def validate_encryption_key(value):
@@ -71,6 +72,10 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Optional(
             CONF_REBOOT_TIMEOUT, default="15min"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_BATCH_DELAY): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(max=cv.TimePeriod(milliseconds=65535)),
+        ),
         cv.Optional(CONF_SERVICES): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(UserServiceTrigger),
@@ -107,6 +112,8 @@ async def to_code(config):
     cg.add(var.set_port(config[CONF_PORT]))
     cg.add(var.set_password(config[CONF_PASSWORD]))
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    if CONF_BATCH_DELAY in config:
+        cg.add(var.set_batch_delay(config[CONF_BATCH_DELAY]))
 
     for conf in config.get(CONF_SERVICES, []):
         template_args = []
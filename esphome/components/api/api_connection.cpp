@@ -79,13 +79,18 @@ void APIConnection::loop() {
     return;
   }
   if (this->next_close_) {
-    // requested a disconnect
+    // requested a disconnect, send the batched DisconnectResponse before closing
+    this->flush_batch_();
     this->helper_->close();
     this->remove_ = true;
     return;
   }
 
   APIError err = this->helper_->loop();
+  if (err == APIError::OK && this->batch_open_ &&
+      millis() - this->batch_started_ >= *this->parent_->get_batch_delay()) {
+    err = this->flush_batch_();
+  }
   if (err != APIError::OK) {
     on_fatal_error();
     ESP_LOGW(TAG, "%s: Socket operation failed: %s errno=%d", this->client_combined_info_.c_str(),
@@ -110,7 +115,12 @@ void APIConnection::loop() {
   } else {
     this->last_traffic_ = millis();
     // read a packet
-    this->read_message(buffer.data_len, buffer.type, &buffer.container[buffer.data_offset]);
+    {
+#ifdef USE_LOOP_PROFILER
+      LoopProfileGuard profile_guard{this->parent_->get_message_profile(buffer.type)};
+#endif
+      this->read_message(buffer.data_len, buffer.type, &buffer.container[buffer.data_offset]);
+    }
     if (this->remove_)
       return;
   }
@@ -151,7 +161,8 @@ void APIConnection::loop() {
 #ifdef USE_ESP32_CAMERA
   if (this->image_reader_.available() && this->helper_->can_write_without_blocking()) {
     uint32_t to_send = std::min((size_t) 1024, this->image_reader_.available());
-    auto buffer = this->create_buffer();
+    // key, data and done fields plus their tags take up at most 10 bytes next to the image data
+    auto buffer = this->create_buffer(to_send + 10);
     // fixed32 key = 1;
     buffer.encode_fixed32(1, esp32_camera::global_esp32_camera->get_object_id_hash());
     // bytes data = 2;
@@ -186,6 +197,25 @@ void APIConnection::loop() {
   }
 }
 
+uint32_t APIConnection::get_idle_loop_interval() {
+  if (this->remove_ || this->next_close_ || this->helper_->has_pending_data() ||
+      this->list_entities_iterator_.is_running() || this->initial_state_iterator_.is_running() ||
+      this->state_subs_at_ != -1)
+    return 0;
+#ifdef USE_ESP32_CAMERA
+  if (this->image_reader_.available())
+    return 0;
+#endif
+  if (this->batch_open_) {
+    const uint32_t elapsed = millis() - this->batch_started_;
+    const uint16_t batch_delay = *this->parent_->get_batch_delay();
+    return elapsed >= batch_delay ? 0 : batch_delay - elapsed;
+  }
+  // Incoming data wakes the loop through the socket, and the keepalive timing is coarser than the
+  // application's longest idle sleep.
+  return UINT32_MAX;
+}
+
 std::string get_default_unique_id(const std::string &component_type, EntityBase *entity) {
   return App.get_name() + component_type + entity->get_object_id();
 }
@@ -1172,11 +1202,15 @@ bool APIConnection::send_log_message(int level, const char *tag, const char *lin
     return false;
 
   // Send raw so that we don't copy too much
-  auto buffer = this->create_buffer();
+  const size_t line_length = strlen(line);
+  uint32_t msg_size = 0;
+  ProtoSize::add_uint32_field(msg_size, 1, static_cast<uint32_t>(level));
+  msg_size += ProtoSize::field(3, 2) + ProtoSize::varint(line_length) + line_length;
+  auto buffer = this->create_buffer(msg_size);
   // LogLevel level = 1;
   buffer.encode_uint32(1, static_cast<uint32_t>(level));
   // string message = 3;
-  buffer.encode_string(3, line, strlen(line));
+  buffer.encode_string(3, line, line_length);
   // SubscribeLogsResponse - 29
   return this->send_buffer(buffer, 29);
 }
@@ -1218,6 +1252,45 @@ ConnectResponse APIConnection::connect(const ConnectRequest &msg) {
   }
   return resp;
 }
+#ifdef USE_LOOP_PROFILER
+static void add_loop_profile_entry(LoopProfileResponse &resp, enums::LoopProfileSource source, const char *component,
+                                   uint32_t index, const LoopProfile &profile) {
+  if (profile.get_count() == 0)
+    return;
+  LoopProfileEntry entry;
+  entry.source = source;
+  entry.component = component;
+  entry.index = index;
+  entry.count = profile.get_count();
+  entry.min_us = profile.get_min_us();
+  entry.avg_us = profile.get_avg_us();
+  entry.max_us = profile.get_max_us();
+  entry.p99_us = profile.get_percentile_us(99);
+  resp.entries.push_back(entry);
+}
+LoopProfileResponse APIConnection::loop_profile(const LoopProfileRequest &msg) {
+  LoopProfileResponse resp;
+  uint32_t index = 0;
+  for (auto *component : App.get_components()) {
+    add_loop_profile_entry(resp, enums::LOOP_PROFILE_SOURCE_COMPONENT_LOOP, component->get_component_source(), index,
+                           component->get_loop_profile());
+    add_loop_profile_entry(resp, enums::LOOP_PROFILE_SOURCE_COMPONENT_SCHEDULER, component->get_component_source(),
+                           index, component->get_scheduler_profile());
+    if (msg.reset) {
+      component->get_loop_profile().reset();
+      component->get_scheduler_profile().reset();
+    }
+    index++;
+  }
+  // For API messages, the index is the message type.
+  for (auto &message : this->parent_->get_message_profiles()) {
+    add_loop_profile_entry(resp, enums::LOOP_PROFILE_SOURCE_API_MESSAGE, "api", message.message_type, message.profile);
+    if (msg.reset)
+      message.profile.reset();
+  }
+  return resp;
+}
+#endif
 DeviceInfoResponse APIConnection::device_info(const DeviceInfoRequest &msg) {
   DeviceInfoResponse resp{};
   resp.uses_password = this->parent_->uses_password();
@@ -1280,6 +1353,12 @@ void APIConnection::execute_service(const ExecuteServiceRequest &msg) {
 void APIConnection::subscribe_home_assistant_states(const SubscribeHomeAssistantStatesRequest &msg) {
   state_subs_at_ = 0;
 }
+APIError APIConnection::flush_batch_() {
+  if (!this->batch_open_)
+    return APIError::OK;
+  this->batch_open_ = false;
+  return this->helper_->flush_batch();
+}
 bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) {
   if (this->remove_)
     return false;
@@ -1302,7 +1381,14 @@ bool APIConnection::send_buffer(ProtoWriteBuffer buffer, uint32_t message_type)
     }
   }
 
-  APIError err = this->helper_->write_packet(message_type, buffer.get_buffer()->data(), buffer.get_buffer()->size());
+  if (!this->batch_open_ && this->parent_->get_batch_delay().has_value()) {
+    // Coalesce this and the following messages into one socket write, flushed from loop() after the batch delay
+    this->helper_->begin_batch();
+    this->batch_open_ = true;
+    this->batch_started_ = millis();
+  }
+
+  APIError err = this->helper_->write_protobuf_packet(message_type, buffer);
   if (err == APIError::WOULD_BLOCK)
     return false;
   if (err != APIError::OK) {
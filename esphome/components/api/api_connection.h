@@ -20,6 +20,8 @@ class APIConnection : public APIServerConnection {
 
   void start();
   void loop();
+  /// How long loop() can go without being called, see Component::get_idle_loop_interval().
+  uint32_t get_idle_loop_interval();
 
   bool send_list_info_done() {
     ListEntitiesDoneResponse resp;
@@ -148,6 +150,10 @@ class APIConnection : public APIServerConnection {
   void alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) override;
 #endif
 
+#ifdef USE_LOOP_PROFILER
+  LoopProfileResponse loop_profile(const LoopProfileRequest &msg) override;
+#endif
+
   void on_disconnect_response(const DisconnectResponse &value) override;
   void on_ping_response(const PingResponse &value) override {
     // we initiated ping
@@ -190,9 +196,13 @@ class APIConnection : public APIServerConnection {
   void on_fatal_error() override;
   void on_unauthenticated_access() override;
   void on_no_setup_connection() override;
-  ProtoWriteBuffer create_buffer() override {
+  ProtoWriteBuffer create_buffer(uint32_t reserve_size) override {
     // FIXME: ensure no recursive writes can happen
+    // Leave room for the frame header in front of the message, the frame helper fills it in place
+    const uint8_t header_padding = this->helper_->frame_header_padding();
     this->proto_write_buffer_.clear();
+    this->proto_write_buffer_.reserve(header_padding + reserve_size + this->helper_->frame_footer_size());
+    this->proto_write_buffer_.resize(header_padding);
     return {&this->proto_write_buffer_};
   }
   bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) override;
@@ -203,6 +213,8 @@ class APIConnection : public APIServerConnection {
   friend APIServer;
 
   bool send_(const void *buf, size_t len, bool force);
+  /// Send the frames of the open batch, if any, without waiting for the batch delay.
+  APIError flush_batch_();
 
   enum class ConnectionState {
     WAITING_FOR_HELLO,
@@ -229,6 +241,8 @@ class APIConnection : public APIServerConnection {
   bool state_subscription_{false};
   int log_subscription_{ESPHOME_LOG_LEVEL_NONE};
   uint32_t last_traffic_;
+  bool batch_open_{false};
+  uint32_t batch_started_{0};
   uint32_t next_ping_retry_{0};
   uint8_t ping_retries_{0};
   bool sent_ping_{false};
@@ -11,6 +11,11 @@ namespace esphome {
 namespace api {
 
 static const char *const TAG = "api.socket";
+/// Queued data is sent as soon as it fills a typical TCP segment, and no new messages are accepted while that much
+/// is still waiting for the socket.
+static const size_t TX_SEGMENT_SIZE = 1436;
+/// Maximum number of queued buffers handed to a single writev() call.
+static const int TX_IOV_MAX = 16;
 
 /// Is the given return value (from write syscalls) a wouldblock error?
 bool is_would_block(ssize_t ret) {
@@ -20,6 +25,48 @@ bool is_would_block(ssize_t ret) {
   return ret == 0;
 }
 
+/// Append the data of the I/O vectors, except for the first \p skip bytes, to the TX queue.
+static void queue_tx_buf(std::deque<SendBuffer> &queue, size_t &queued, const struct iovec *iov, int iovcnt,
+                         size_t skip) {
+  for (int i = 0; i < iovcnt; i++) {
+    if (skip >= iov[i].iov_len) {
+      skip -= iov[i].iov_len;
+      continue;
+    }
+    const uint8_t *begin = reinterpret_cast<const uint8_t *>(iov[i].iov_base) + skip;
+    const uint8_t *end = reinterpret_cast<const uint8_t *>(iov[i].iov_base) + iov[i].iov_len;
+    skip = 0;
+    // small frames share a buffer up to a segment, so a burst of state updates doesn't allocate one each
+    if (queue.empty() || queue.back().data.size() + (end - begin) > TX_SEGMENT_SIZE)
+      queue.emplace_back();
+    queue.back().data.insert(queue.back().data.end(), begin, end);
+    queued += end - begin;
+  }
+}
+/// Point the I/O vectors at the unsent data of the first buffers in the TX queue.
+static int tx_buf_to_iov(std::deque<SendBuffer> &queue, struct iovec *iov) {
+  int iovcnt = 0;
+  for (auto it = queue.begin(); it != queue.end() && iovcnt < TX_IOV_MAX; ++it, ++iovcnt) {
+    iov[iovcnt].iov_base = it->data.data() + it->offset;
+    iov[iovcnt].iov_len = it->data.size() - it->offset;
+  }
+  return iovcnt;
+}
+/// Remove \p sent bytes from the front of the TX queue, without moving any of the remaining data.
+static void consume_tx_buf(std::deque<SendBuffer> &queue, size_t &queued, size_t sent) {
+  queued -= sent;
+  while (sent != 0) {
+    SendBuffer &front = queue.front();
+    size_t available = front.data.size() - front.offset;
+    if (sent < available) {
+      front.offset += sent;
+      return;
+    }
+    sent -= available;
+    queue.pop_front();
+  }
+}
+
 const char *api_error_to_str(APIError err) {
   // not using switch to ensure compiler doesn't try to build a big table out of it
   if (err == APIError::OK) {
@@ -152,7 +199,7 @@ APIError APINoiseFrameHelper::loop() {
     return APIError::OK;
   if (err != APIError::OK)
     return err;
-  if (!tx_buf_.empty()) {
+  if (!tx_buf_.empty() && (!batching_ || tx_buf_size_ >= TX_SEGMENT_SIZE)) {
     err = try_send_tx_buf_();
     if (err != APIError::OK) {
       return err;
@@ -466,8 +513,21 @@ APIError APINoiseFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   buffer->type = type;
   return APIError::OK;
 }
-bool APINoiseFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+bool APINoiseFrameHelper::can_write_without_blocking() {
+  // Backpressure: refuse new messages while a full segment is still waiting for the socket
+  return state_ == State::DATA && tx_buf_size_ < TX_SEGMENT_SIZE;
+}
+bool APINoiseFrameHelper::has_pending_data() {
+  // same condition as loop() uses to send
+  return !tx_buf_.empty() && (!batching_ || tx_buf_size_ >= TX_SEGMENT_SIZE);
+}
+APIError APINoiseFrameHelper::flush_batch() {
+  batching_ = false;
+  if (tx_buf_.empty())
+    return APIError::OK;
+  return try_send_tx_buf_();
+}
+APIError APINoiseFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   int err;
   APIError aerr;
   aerr = state_action_();
@@ -479,28 +539,24 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
     return APIError::WOULD_BLOCK;
   }
 
-  size_t padding = 0;
-  size_t msg_len = 4 + payload_len + padding;
-  size_t frame_len = 3 + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
-  auto tmpbuf = std::unique_ptr<uint8_t[]>{new (std::nothrow) uint8_t[frame_len]};
-  if (tmpbuf == nullptr) {
-    HELPER_LOG("Could not allocate for writing packet");
-    return APIError::OUT_OF_MEMORY;
-  }
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  const uint8_t msg_offset = 3;
+  const uint8_t payload_offset = this->frame_header_padding();
+  size_t payload_len = raw_buffer->size() - payload_offset;
+  size_t msg_len = 4 + payload_len;
+  size_t frame_len = msg_offset + msg_len + noise_cipherstate_get_mac_length(send_cipher_);
+  // Make room for the MAC, the buffer was reserved with frame_footer_size() so this does not reallocate
+  raw_buffer->resize(frame_len);
+  uint8_t *tmpbuf = raw_buffer->data();
 
   tmpbuf[0] = 0x01;  // indicator
   // tmpbuf[1], tmpbuf[2] to be set later
-  const uint8_t msg_offset = 3;
-  const uint8_t payload_offset = msg_offset + 4;
   tmpbuf[msg_offset + 0] = (uint8_t) (type >> 8);  // type
   tmpbuf[msg_offset + 1] = (uint8_t) type;
   tmpbuf[msg_offset + 2] = (uint8_t) (payload_len >> 8);  // data_len
   tmpbuf[msg_offset + 3] = (uint8_t) payload_len;
-  // copy data
-  std::copy(payload, payload + payload_len, &tmpbuf[payload_offset]);
-  // fill padding with zeros
-  std::fill(&tmpbuf[payload_offset + payload_len], &tmpbuf[frame_len], 0);
 
+  // encrypt in place, the payload is already in position behind the header
   NoiseBuffer mbuf;
   noise_buffer_init(mbuf);
   noise_buffer_set_inout(mbuf, &tmpbuf[msg_offset], msg_len, frame_len - msg_offset);
@@ -523,29 +579,27 @@ APIError APINoiseFrameHelper::write_packet(uint16_t type, const uint8_t *payload
   return write_raw_(&iov, 1);
 }
 APIError APINoiseFrameHelper::try_send_tx_buf_() {
-  // try send from tx_buf
+  // try send from tx_buf, several queued buffers at a time
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
-    if (sent == -1) {
-      if (errno == EWOULDBLOCK || errno == EAGAIN)
-        break;
+    struct iovec iov[TX_IOV_MAX];
+    int iovcnt = tx_buf_to_iov(tx_buf_, iov);
+    ssize_t sent = socket_->writev(iov, iovcnt);
+    if (is_would_block(sent)) {
+      break;
+    } else if (sent == -1) {
       state_ = State::FAILED;
       HELPER_LOG("Socket write failed with errno %d", errno);
       return APIError::SOCKET_WRITE_FAILED;
-    } else if (sent == 0) {
-      break;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    consume_tx_buf(tx_buf_, tx_buf_size_, sent);
   }
 
   return APIError::OK;
 }
 /** Write the data to the socket, or buffer it a write would block
  *
- * @param data The data to write
- * @param len The length of data
+ * @param iov The data to write
+ * @param iovcnt The number of I/O vectors in iov
  */
 APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (iovcnt == 0)
@@ -561,6 +615,15 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
     total_write_len += iov[i].iov_len;
   }
 
+  if (batching_) {
+    // hold the frame back, it is sent together with the rest of the batch
+    queue_tx_buf(tx_buf_, tx_buf_size_, iov, iovcnt, 0);
+    if (tx_buf_size_ < TX_SEGMENT_SIZE)
+      return APIError::OK;
+    // the batch fills a TCP segment already, send it now
+    return try_send_tx_buf_();
+  }
+
   if (!tx_buf_.empty()) {
     // try to empty tx_buf_ first
     aerr = try_send_tx_buf_();
@@ -570,20 +633,14 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
 
   if (!tx_buf_.empty()) {
     // tx buf not empty, can't write now because then stream would be inconsistent
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-    }
+    queue_tx_buf(tx_buf_, tx_buf_size_, iov, iovcnt, 0);
     return APIError::OK;
   }
 
   ssize_t sent = socket_->writev(iov, iovcnt);
   if (is_would_block(sent)) {
     // operation would block, add buffer to tx_buf
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-    }
+    queue_tx_buf(tx_buf_, tx_buf_size_, iov, iovcnt, 0);
     return APIError::OK;
   } else if (sent == -1) {
     // an error occurred
@@ -592,16 +649,7 @@ APIError APINoiseFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
     return APIError::SOCKET_WRITE_FAILED;
   } else if ((size_t) sent != total_write_len) {
     // partially sent, add end to tx_buf
-    size_t to_consume = sent;
-    for (int i = 0; i < iovcnt; i++) {
-      if (to_consume >= iov[i].iov_len) {
-        to_consume -= iov[i].iov_len;
-      } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-        to_consume = 0;
-      }
-    }
+    queue_tx_buf(tx_buf_, tx_buf_size_, iov, iovcnt, sent);
     return APIError::OK;
   }
   // fully sent
@@ -772,8 +820,8 @@ APIError APIPlaintextFrameHelper::loop() {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
-  // try send pending TX data
-  if (!tx_buf_.empty()) {
+  // try send pending TX data, unless it is held back for a batch
+  if (!tx_buf_.empty() && (!batching_ || tx_buf_size_ >= TX_SEGMENT_SIZE)) {
     APIError err = try_send_tx_buf_();
     if (err != APIError::OK) {
       return err;
@@ -902,32 +950,48 @@ APIError APIPlaintextFrameHelper::read_packet(ReadPacketBuffer *buffer) {
   buffer->type = rx_header_parsed_type_;
   return APIError::OK;
 }
-bool APIPlaintextFrameHelper::can_write_without_blocking() { return state_ == State::DATA && tx_buf_.empty(); }
-APIError APIPlaintextFrameHelper::write_packet(uint16_t type, const uint8_t *payload, size_t payload_len) {
+bool APIPlaintextFrameHelper::can_write_without_blocking() {
+  // Backpressure: refuse new messages while a full segment is still waiting for the socket
+  return state_ == State::DATA && tx_buf_size_ < TX_SEGMENT_SIZE;
+}
+bool APIPlaintextFrameHelper::has_pending_data() {
+  // same condition as loop() uses to send
+  return !tx_buf_.empty() && (!batching_ || tx_buf_size_ >= TX_SEGMENT_SIZE);
+}
+APIError APIPlaintextFrameHelper::flush_batch() {
+  batching_ = false;
+  if (tx_buf_.empty())
+    return APIError::OK;
+  return try_send_tx_buf_();
+}
+APIError APIPlaintextFrameHelper::write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) {
   if (state_ != State::DATA) {
     return APIError::BAD_STATE;
   }
 
-  std::vector<uint8_t> header;
-  header.push_back(0x00);
-  ProtoVarInt(payload_len).encode(header);
-  ProtoVarInt(type).encode(header);
+  std::vector<uint8_t> *raw_buffer = buffer.get_buffer();
+  const uint8_t padding = this->frame_header_padding();
+  size_t payload_len = raw_buffer->size() - padding;
 
-  struct iovec iov[2];
-  iov[0].iov_base = &header[0];
-  iov[0].iov_len = header.size();
-  if (payload_len == 0) {
-    return write_raw_(iov, 1);
-  }
-  iov[1].iov_base = const_cast<uint8_t *>(payload);
-  iov[1].iov_len = payload_len;
+  // The header has a variable length, so place it right before the payload at the end of the reserved space
+  ProtoVarInt len_varint(payload_len);
+  ProtoVarInt type_varint(type);
+  uint8_t header_len = 1 + len_varint.size() + type_varint.size();
+  uint8_t *header = raw_buffer->data() + padding - header_len;
+  header[0] = 0x00;
+  type_varint.encode_to(len_varint.encode_to(&header[1]));
 
-  return write_raw_(iov, 2);
+  struct iovec iov;
+  iov.iov_base = header;
+  iov.iov_len = header_len + payload_len;
+  return write_raw_(&iov, 1);
 }
 APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
-  // try send from tx_buf
+  // try send from tx_buf, several queued buffers at a time
   while (state_ != State::CLOSED && !tx_buf_.empty()) {
-    ssize_t sent = socket_->write(tx_buf_.data(), tx_buf_.size());
+    struct iovec iov[TX_IOV_MAX];
+    int iovcnt = tx_buf_to_iov(tx_buf_, iov);
+    ssize_t sent = socket_->writev(iov, iovcnt);
     if (is_would_block(sent)) {
       break;
     } else if (sent == -1) {
@@ -935,17 +999,15 @@ APIError APIPlaintextFrameHelper::try_send_tx_buf_() {
       HELPER_LOG("Socket write failed with errno %d", errno);
       return APIError::SOCKET_WRITE_FAILED;
     }
-    // TODO: inefficient if multiple packets in txbuf
-    // replace with deque of buffers
-    tx_buf_.erase(tx_buf_.begin(), tx_buf_.begin() + sent);
+    consume_tx_buf(tx_buf_, tx_buf_size_, sent);
   }
 
   return APIError::OK;
 }
 /** Write the data to the socket, or buffer it a write would block
  *
- * @param data The data to write
- * @param len The length of data
+ * @param iov The data to write
+ * @param iovcnt The number of I/O vectors in iov
  */
 APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt) {
   if (iovcnt == 0)
@@ -961,6 +1023,15 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
     total_write_len += iov[i].iov_len;
   }
 
+  if (batching_) {
+    // hold the frame back, it is sent together with the rest of the batch
+    queue_tx_buf(tx_buf_, tx_buf_size_, iov, iovcnt, 0);
+    if (tx_buf_size_ < TX_SEGMENT_SIZE)
+      return APIError::OK;
+    // the batch fills a TCP segment already, send it now
+    return try_send_tx_buf_();
+  }
+
   if (!tx_buf_.empty()) {
     // try to empty tx_buf_ first
     aerr = try_send_tx_buf_();
@@ -970,20 +1041,14 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
 
   if (!tx_buf_.empty()) {
     // tx buf not empty, can't write now because then stream would be inconsistent
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-    }
+    queue_tx_buf(tx_buf_, tx_buf_size_, iov, iovcnt, 0);
     return APIError::OK;
   }
 
   ssize_t sent = socket_->writev(iov, iovcnt);
   if (is_would_block(sent)) {
     // operation would block, add buffer to tx_buf
-    for (int i = 0; i < iovcnt; i++) {
-      tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base),
-                     reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-    }
+    queue_tx_buf(tx_buf_, tx_buf_size_, iov, iovcnt, 0);
     return APIError::OK;
   } else if (sent == -1) {
     // an error occurred
@@ -992,16 +1057,7 @@ APIError APIPlaintextFrameHelper::write_raw_(const struct iovec *iov, int iovcnt
     return APIError::SOCKET_WRITE_FAILED;
   } else if ((size_t) sent != total_write_len) {
     // partially sent, add end to tx_buf
-    size_t to_consume = sent;
-    for (int i = 0; i < iovcnt; i++) {
-      if (to_consume >= iov[i].iov_len) {
-        to_consume -= iov[i].iov_len;
-      } else {
-        tx_buf_.insert(tx_buf_.end(), reinterpret_cast<uint8_t *>(iov[i].iov_base) + to_consume,
-                       reinterpret_cast<uint8_t *>(iov[i].iov_base) + iov[i].iov_len);
-        to_consume = 0;
-      }
-    }
+    queue_tx_buf(tx_buf_, tx_buf_size_, iov, iovcnt, sent);
     return APIError::OK;
   }
   // fully sent
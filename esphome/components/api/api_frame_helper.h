@@ -12,6 +12,7 @@
 
 #include "api_noise_context.h"
 #include "esphome/components/socket/socket.h"
+#include "proto.h"
 
 namespace esphome {
 namespace api {
@@ -23,6 +24,13 @@ struct ReadPacketBuffer {
   size_t data_len;
 };
 
+/// Outgoing data that could not be written to the socket yet.
+struct SendBuffer {
+  std::vector<uint8_t> data;
+  /// Number of bytes at the start of data that have been sent already.
+  size_t offset{0};
+};
+
 struct PacketBuffer {
   const std::vector<uint8_t> container;
   uint16_t type;
@@ -65,7 +73,21 @@ class APIFrameHelper {
   virtual APIError loop() = 0;
   virtual APIError read_packet(ReadPacketBuffer *buffer) = 0;
   virtual bool can_write_without_blocking() = 0;
-  virtual APIError write_packet(uint16_t type, const uint8_t *data, size_t len) = 0;
+  /// Whether loop() has frames to send that the socket did not take yet. Frames held back for a batch don't count.
+  virtual bool has_pending_data() = 0;
+  /** Write a packet whose payload was encoded into \p buffer after frame_header_padding() reserved bytes.
+   *
+   * The frame header is filled in place in front of the payload, so the payload is never copied.
+   */
+  virtual APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) = 0;
+  /// Number of bytes to reserve in front of a payload for the frame header.
+  virtual uint8_t frame_header_padding() = 0;
+  /// Number of bytes to reserve behind a payload for the frame footer.
+  virtual uint8_t frame_footer_size() = 0;
+  /// Hold back written frames until flush_batch(), so that they go out in a single socket write.
+  virtual void begin_batch() = 0;
+  /// Send the frames held back since begin_batch().
+  virtual APIError flush_batch() = 0;
   virtual std::string getpeername() = 0;
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
   virtual APIError close() = 0;
@@ -84,7 +106,16 @@ class APINoiseFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  bool has_pending_data() override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  // indicator (1) + encrypted size (2) + type (2) + data length (2)
+  uint8_t frame_header_padding() override { return 7; }
+  // MAC of the encrypted message
+  uint8_t frame_footer_size() override {
+    return this->send_cipher_ == nullptr ? 0 : noise_cipherstate_get_mac_length(this->send_cipher_);
+  }
+  void begin_batch() override { this->batching_ = true; }
+  APIError flush_batch() override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -116,7 +147,9 @@ class APINoiseFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
+  std::deque<SendBuffer> tx_buf_;
+  size_t tx_buf_size_{0};
+  bool batching_{false};
   std::vector<uint8_t> prologue_;
 
   std::shared_ptr<APINoiseContext> ctx_;
@@ -147,7 +180,13 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   APIError loop() override;
   APIError read_packet(ReadPacketBuffer *buffer) override;
   bool can_write_without_blocking() override;
-  APIError write_packet(uint16_t type, const uint8_t *payload, size_t len) override;
+  bool has_pending_data() override;
+  APIError write_protobuf_packet(uint16_t type, ProtoWriteBuffer buffer) override;
+  // indicator (1) + payload size varint (up to 3) + type varint (up to 2)
+  uint8_t frame_header_padding() override { return 6; }
+  uint8_t frame_footer_size() override { return 0; }
+  void begin_batch() override { this->batching_ = true; }
+  APIError flush_batch() override;
   std::string getpeername() override { return this->socket_->getpeername(); }
   int getpeername(struct sockaddr *addr, socklen_t *addrlen) override {
     return this->socket_->getpeername(addr, addrlen);
@@ -177,7 +216,9 @@ class APIPlaintextFrameHelper : public APIFrameHelper {
   std::vector<uint8_t> rx_buf_;
   size_t rx_buf_len_ = 0;
 
-  std::vector<uint8_t> tx_buf_;
+  std::deque<SendBuffer> tx_buf_;
+  size_t tx_buf_size_{0};
+  bool batching_{false};
 
   enum class State {
     INITIALIZE = 1,
@@ -537,6 +537,20 @@ template<> const char *proto_enum_to_string<enums::TextMode>(enums::TextMode val
   }
 }
 #endif
+#ifdef HAS_PROTO_MESSAGE_DUMP
+template<> const char *proto_enum_to_string<enums::LoopProfileSource>(enums::LoopProfileSource value) {
+  switch (value) {
+    case enums::LOOP_PROFILE_SOURCE_COMPONENT_LOOP:
+      return "LOOP_PROFILE_SOURCE_COMPONENT_LOOP";
+    case enums::LOOP_PROFILE_SOURCE_COMPONENT_SCHEDULER:
+      return "LOOP_PROFILE_SOURCE_COMPONENT_SCHEDULER";
+    case enums::LOOP_PROFILE_SOURCE_API_MESSAGE:
+      return "LOOP_PROFILE_SOURCE_API_MESSAGE";
+    default:
+      return "UNKNOWN";
+  }
+}
+#endif
 bool HelloRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
   switch (field_id) {
     case 2: {
@@ -566,6 +580,11 @@ void HelloRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->api_version_major);
   buffer.encode_uint32(3, this->api_version_minor);
 }
+void HelloRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->client_info);
+  ProtoSize::add_uint32_field(total_size, 2, this->api_version_major);
+  ProtoSize::add_uint32_field(total_size, 3, this->api_version_minor);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HelloRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -620,6 +639,12 @@ void HelloResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(3, this->server_info);
   buffer.encode_string(4, this->name);
 }
+void HelloResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->api_version_major);
+  ProtoSize::add_uint32_field(total_size, 2, this->api_version_minor);
+  ProtoSize::add_string_field(total_size, 3, this->server_info);
+  ProtoSize::add_string_field(total_size, 4, this->name);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HelloResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -655,6 +680,9 @@ bool ConnectRequest::decode_length(uint32_t field_id, ProtoLengthDelimited value
   }
 }
 void ConnectRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_string(1, this->password); }
+void ConnectRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->password);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ConnectRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -676,6 +704,9 @@ bool ConnectResponse::decode_varint(uint32_t field_id, ProtoVarInt value) {
   }
 }
 void ConnectResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->invalid_password); }
+void ConnectResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->invalid_password);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ConnectResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -687,22 +718,27 @@ void ConnectResponse::dump_to(std::string &out) const {
 }
 #endif
 void DisconnectRequest::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DisconnectRequest::dump_to(std::string &out) const { out.append("DisconnectRequest {}"); }
 #endif
 void DisconnectResponse::encode(ProtoWriteBuffer buffer) const {}
+void DisconnectResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DisconnectResponse::dump_to(std::string &out) const { out.append("DisconnectResponse {}"); }
 #endif
 void PingRequest::encode(ProtoWriteBuffer buffer) const {}
+void PingRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void PingRequest::dump_to(std::string &out) const { out.append("PingRequest {}"); }
 #endif
 void PingResponse::encode(ProtoWriteBuffer buffer) const {}
+void PingResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void PingResponse::dump_to(std::string &out) const { out.append("PingResponse {}"); }
 #endif
 void DeviceInfoRequest::encode(ProtoWriteBuffer buffer) const {}
+void DeviceInfoRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DeviceInfoRequest::dump_to(std::string &out) const { out.append("DeviceInfoRequest {}"); }
 #endif
@@ -805,6 +841,25 @@ void DeviceInfoResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(17, this->voice_assistant_feature_flags);
   buffer.encode_string(16, this->suggested_area);
 }
+void DeviceInfoResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->uses_password);
+  ProtoSize::add_string_field(total_size, 2, this->name);
+  ProtoSize::add_string_field(total_size, 3, this->mac_address);
+  ProtoSize::add_string_field(total_size, 4, this->esphome_version);
+  ProtoSize::add_string_field(total_size, 5, this->compilation_time);
+  ProtoSize::add_string_field(total_size, 6, this->model);
+  ProtoSize::add_bool_field(total_size, 7, this->has_deep_sleep);
+  ProtoSize::add_string_field(total_size, 8, this->project_name);
+  ProtoSize::add_string_field(total_size, 9, this->project_version);
+  ProtoSize::add_uint32_field(total_size, 10, this->webserver_port);
+  ProtoSize::add_uint32_field(total_size, 11, this->legacy_bluetooth_proxy_version);
+  ProtoSize::add_uint32_field(total_size, 15, this->bluetooth_proxy_feature_flags);
+  ProtoSize::add_string_field(total_size, 12, this->manufacturer);
+  ProtoSize::add_string_field(total_size, 13, this->friendly_name);
+  ProtoSize::add_uint32_field(total_size, 14, this->legacy_voice_assistant_version);
+  ProtoSize::add_uint32_field(total_size, 17, this->voice_assistant_feature_flags);
+  ProtoSize::add_string_field(total_size, 16, this->suggested_area);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DeviceInfoResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -885,14 +940,17 @@ void DeviceInfoResponse::dump_to(std::string &out) const {
 }
 #endif
 void ListEntitiesRequest::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesRequest::dump_to(std::string &out) const { out.append("ListEntitiesRequest {}"); }
 #endif
 void ListEntitiesDoneResponse::encode(ProtoWriteBuffer buffer) const {}
+void ListEntitiesDoneResponse::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesDoneResponse::dump_to(std::string &out) const { out.append("ListEntitiesDoneResponse {}"); }
 #endif
 void SubscribeStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeStatesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeStatesRequest::dump_to(std::string &out) const { out.append("SubscribeStatesRequest {}"); }
 #endif
@@ -961,6 +1019,17 @@ void ListEntitiesBinarySensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(8, this->icon);
   buffer.encode_enum<enums::EntityCategory>(9, this->entity_category);
 }
+void ListEntitiesBinarySensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->device_class);
+  ProtoSize::add_bool_field(total_size, 6, this->is_status_binary_sensor);
+  ProtoSize::add_bool_field(total_size, 7, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 8, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 9, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesBinarySensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1033,6 +1102,11 @@ void BinarySensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void BinarySensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->state);
+  ProtoSize::add_bool_field(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BinarySensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1132,6 +1206,20 @@ void ListEntitiesCoverResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(11, this->entity_category);
   buffer.encode_bool(12, this->supports_stop);
 }
+void ListEntitiesCoverResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 5, this->assumed_state);
+  ProtoSize::add_bool_field(total_size, 6, this->supports_position);
+  ProtoSize::add_bool_field(total_size, 7, this->supports_tilt);
+  ProtoSize::add_string_field(total_size, 8, this->device_class);
+  ProtoSize::add_bool_field(total_size, 9, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 10, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 11, this->entity_category);
+  ProtoSize::add_bool_field(total_size, 12, this->supports_stop);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesCoverResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1226,6 +1314,13 @@ void CoverStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(4, this->tilt);
   buffer.encode_enum<enums::CoverOperation>(5, this->current_operation);
 }
+void CoverStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::LegacyCoverState>(total_size, 2, this->legacy_state);
+  ProtoSize::add_float_field(total_size, 3, this->position);
+  ProtoSize::add_float_field(total_size, 4, this->tilt);
+  ProtoSize::add_enum_field<enums::CoverOperation>(total_size, 5, this->current_operation);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CoverStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1309,6 +1404,16 @@ void CoverCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(7, this->tilt);
   buffer.encode_bool(8, this->stop);
 }
+void CoverCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->has_legacy_command);
+  ProtoSize::add_enum_field<enums::LegacyCoverCommand>(total_size, 3, this->legacy_command);
+  ProtoSize::add_bool_field(total_size, 4, this->has_position);
+  ProtoSize::add_float_field(total_size, 5, this->position);
+  ProtoSize::add_bool_field(total_size, 6, this->has_tilt);
+  ProtoSize::add_float_field(total_size, 7, this->tilt);
+  ProtoSize::add_bool_field(total_size, 8, this->stop);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CoverCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1432,6 +1537,22 @@ void ListEntitiesFanResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_string(12, it, true);
   }
 }
+void ListEntitiesFanResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 5, this->supports_oscillation);
+  ProtoSize::add_bool_field(total_size, 6, this->supports_speed);
+  ProtoSize::add_bool_field(total_size, 7, this->supports_direction);
+  ProtoSize::add_int32_field(total_size, 8, this->supported_speed_count);
+  ProtoSize::add_bool_field(total_size, 9, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 10, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 11, this->entity_category);
+  for (const auto &it : this->supported_preset_modes) {
+    ProtoSize::add_string_field(total_size, 12, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesFanResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1545,6 +1666,15 @@ void FanStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_int32(6, this->speed_level);
   buffer.encode_string(7, this->preset_mode);
 }
+void FanStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->state);
+  ProtoSize::add_bool_field(total_size, 3, this->oscillating);
+  ProtoSize::add_enum_field<enums::FanSpeed>(total_size, 4, this->speed);
+  ProtoSize::add_enum_field<enums::FanDirection>(total_size, 5, this->direction);
+  ProtoSize::add_int32_field(total_size, 6, this->speed_level);
+  ProtoSize::add_string_field(total_size, 7, this->preset_mode);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void FanStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1666,6 +1796,21 @@ void FanCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(12, this->has_preset_mode);
   buffer.encode_string(13, this->preset_mode);
 }
+void FanCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->has_state);
+  ProtoSize::add_bool_field(total_size, 3, this->state);
+  ProtoSize::add_bool_field(total_size, 4, this->has_speed);
+  ProtoSize::add_enum_field<enums::FanSpeed>(total_size, 5, this->speed);
+  ProtoSize::add_bool_field(total_size, 6, this->has_oscillating);
+  ProtoSize::add_bool_field(total_size, 7, this->oscillating);
+  ProtoSize::add_bool_field(total_size, 8, this->has_direction);
+  ProtoSize::add_enum_field<enums::FanDirection>(total_size, 9, this->direction);
+  ProtoSize::add_bool_field(total_size, 10, this->has_speed_level);
+  ProtoSize::add_int32_field(total_size, 11, this->speed_level);
+  ProtoSize::add_bool_field(total_size, 12, this->has_preset_mode);
+  ProtoSize::add_string_field(total_size, 13, this->preset_mode);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void FanCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1825,6 +1970,27 @@ void ListEntitiesLightResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(14, this->icon);
   buffer.encode_enum<enums::EntityCategory>(15, this->entity_category);
 }
+void ListEntitiesLightResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  for (const auto &it : this->supported_color_modes) {
+    ProtoSize::add_enum_field<enums::ColorMode>(total_size, 12, it, true);
+  }
+  ProtoSize::add_bool_field(total_size, 5, this->legacy_supports_brightness);
+  ProtoSize::add_bool_field(total_size, 6, this->legacy_supports_rgb);
+  ProtoSize::add_bool_field(total_size, 7, this->legacy_supports_white_value);
+  ProtoSize::add_bool_field(total_size, 8, this->legacy_supports_color_temperature);
+  ProtoSize::add_float_field(total_size, 9, this->min_mireds);
+  ProtoSize::add_float_field(total_size, 10, this->max_mireds);
+  for (const auto &it : this->effects) {
+    ProtoSize::add_string_field(total_size, 11, it, true);
+  }
+  ProtoSize::add_bool_field(total_size, 13, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 14, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 15, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesLightResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -1983,6 +2149,21 @@ void LightStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(13, this->warm_white);
   buffer.encode_string(9, this->effect);
 }
+void LightStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->state);
+  ProtoSize::add_float_field(total_size, 3, this->brightness);
+  ProtoSize::add_enum_field<enums::ColorMode>(total_size, 11, this->color_mode);
+  ProtoSize::add_float_field(total_size, 10, this->color_brightness);
+  ProtoSize::add_float_field(total_size, 4, this->red);
+  ProtoSize::add_float_field(total_size, 5, this->green);
+  ProtoSize::add_float_field(total_size, 6, this->blue);
+  ProtoSize::add_float_field(total_size, 7, this->white);
+  ProtoSize::add_float_field(total_size, 8, this->color_temperature);
+  ProtoSize::add_float_field(total_size, 12, this->cold_white);
+  ProtoSize::add_float_field(total_size, 13, this->warm_white);
+  ProtoSize::add_string_field(total_size, 9, this->effect);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LightStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2206,6 +2387,35 @@ void LightCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(18, this->has_effect);
   buffer.encode_string(19, this->effect);
 }
+void LightCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->has_state);
+  ProtoSize::add_bool_field(total_size, 3, this->state);
+  ProtoSize::add_bool_field(total_size, 4, this->has_brightness);
+  ProtoSize::add_float_field(total_size, 5, this->brightness);
+  ProtoSize::add_bool_field(total_size, 22, this->has_color_mode);
+  ProtoSize::add_enum_field<enums::ColorMode>(total_size, 23, this->color_mode);
+  ProtoSize::add_bool_field(total_size, 20, this->has_color_brightness);
+  ProtoSize::add_float_field(total_size, 21, this->color_brightness);
+  ProtoSize::add_bool_field(total_size, 6, this->has_rgb);
+  ProtoSize::add_float_field(total_size, 7, this->red);
+  ProtoSize::add_float_field(total_size, 8, this->green);
+  ProtoSize::add_float_field(total_size, 9, this->blue);
+  ProtoSize::add_bool_field(total_size, 10, this->has_white);
+  ProtoSize::add_float_field(total_size, 11, this->white);
+  ProtoSize::add_bool_field(total_size, 12, this->has_color_temperature);
+  ProtoSize::add_float_field(total_size, 13, this->color_temperature);
+  ProtoSize::add_bool_field(total_size, 24, this->has_cold_white);
+  ProtoSize::add_float_field(total_size, 25, this->cold_white);
+  ProtoSize::add_bool_field(total_size, 26, this->has_warm_white);
+  ProtoSize::add_float_field(total_size, 27, this->warm_white);
+  ProtoSize::add_bool_field(total_size, 14, this->has_transition_length);
+  ProtoSize::add_uint32_field(total_size, 15, this->transition_length);
+  ProtoSize::add_bool_field(total_size, 16, this->has_flash_length);
+  ProtoSize::add_uint32_field(total_size, 17, this->flash_length);
+  ProtoSize::add_bool_field(total_size, 18, this->has_effect);
+  ProtoSize::add_string_field(total_size, 19, this->effect);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LightCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2417,6 +2627,21 @@ void ListEntitiesSensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(12, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(13, this->entity_category);
 }
+void ListEntitiesSensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_string_field(total_size, 6, this->unit_of_measurement);
+  ProtoSize::add_int32_field(total_size, 7, this->accuracy_decimals);
+  ProtoSize::add_bool_field(total_size, 8, this->force_update);
+  ProtoSize::add_string_field(total_size, 9, this->device_class);
+  ProtoSize::add_enum_field<enums::SensorStateClass>(total_size, 10, this->state_class);
+  ProtoSize::add_enum_field<enums::SensorLastResetType>(total_size, 11, this->legacy_last_reset_type);
+  ProtoSize::add_bool_field(total_size, 12, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 13, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2506,6 +2731,11 @@ void SensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void SensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_float_field(total_size, 2, this->state);
+  ProtoSize::add_bool_field(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2591,6 +2821,17 @@ void ListEntitiesSwitchResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(8, this->entity_category);
   buffer.encode_string(9, this->device_class);
 }
+void ListEntitiesSwitchResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_bool_field(total_size, 6, this->assumed_state);
+  ProtoSize::add_bool_field(total_size, 7, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 8, this->entity_category);
+  ProtoSize::add_string_field(total_size, 9, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSwitchResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2658,6 +2899,10 @@ void SwitchStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
+void SwitchStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SwitchStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2697,6 +2942,10 @@ void SwitchCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_bool(2, this->state);
 }
+void SwitchCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SwitchCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2772,6 +3021,16 @@ void ListEntitiesTextSensorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
   buffer.encode_string(8, this->device_class);
 }
+void ListEntitiesTextSensorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_bool_field(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_string_field(total_size, 8, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesTextSensorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2846,6 +3105,11 @@ void TextSensorStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void TextSensorStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 2, this->state);
+  ProtoSize::add_bool_field(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TextSensorStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2883,6 +3147,10 @@ void SubscribeLogsRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::LogLevel>(1, this->level);
   buffer.encode_bool(2, this->dump_config);
 }
+void SubscribeLogsRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum_field<enums::LogLevel>(total_size, 1, this->level);
+  ProtoSize::add_bool_field(total_size, 2, this->dump_config);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2926,6 +3194,11 @@ void SubscribeLogsResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(3, this->message);
   buffer.encode_bool(4, this->send_failed);
 }
+void SubscribeLogsResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum_field<enums::LogLevel>(total_size, 1, this->level);
+  ProtoSize::add_string_field(total_size, 3, this->message);
+  ProtoSize::add_bool_field(total_size, 4, this->send_failed);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeLogsResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -2945,6 +3218,7 @@ void SubscribeLogsResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeHomeassistantServicesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeassistantServicesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeassistantServicesRequest::dump_to(std::string &out) const {
   out.append("SubscribeHomeassistantServicesRequest {}");
@@ -2968,6 +3242,10 @@ void HomeassistantServiceMap::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->key);
   buffer.encode_string(2, this->value);
 }
+void HomeassistantServiceMap::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 2, this->value);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeassistantServiceMap::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3027,6 +3305,19 @@ void HomeassistantServiceResponse::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_bool(5, this->is_event);
 }
+void HomeassistantServiceResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->service);
+  for (const auto &it : this->data) {
+    ProtoSize::add_message_field<HomeassistantServiceMap>(total_size, 2, it, true);
+  }
+  for (const auto &it : this->data_template) {
+    ProtoSize::add_message_field<HomeassistantServiceMap>(total_size, 3, it, true);
+  }
+  for (const auto &it : this->variables) {
+    ProtoSize::add_message_field<HomeassistantServiceMap>(total_size, 4, it, true);
+  }
+  ProtoSize::add_bool_field(total_size, 5, this->is_event);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeassistantServiceResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3060,6 +3351,7 @@ void HomeassistantServiceResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeHomeAssistantStatesRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeHomeAssistantStatesRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeAssistantStatesRequest::dump_to(std::string &out) const {
   out.append("SubscribeHomeAssistantStatesRequest {}");
@@ -3083,6 +3375,10 @@ void SubscribeHomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const
   buffer.encode_string(1, this->entity_id);
   buffer.encode_string(2, this->attribute);
 }
+void SubscribeHomeAssistantStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->entity_id);
+  ProtoSize::add_string_field(total_size, 2, this->attribute);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeHomeAssistantStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3120,6 +3416,11 @@ void HomeAssistantStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_string(3, this->attribute);
 }
+void HomeAssistantStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->entity_id);
+  ProtoSize::add_string_field(total_size, 2, this->state);
+  ProtoSize::add_string_field(total_size, 3, this->attribute);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void HomeAssistantStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3139,6 +3440,7 @@ void HomeAssistantStateResponse::dump_to(std::string &out) const {
 }
 #endif
 void GetTimeRequest::encode(ProtoWriteBuffer buffer) const {}
+void GetTimeRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void GetTimeRequest::dump_to(std::string &out) const { out.append("GetTimeRequest {}"); }
 #endif
@@ -3153,6 +3455,9 @@ bool GetTimeResponse::decode_32bit(uint32_t field_id, Proto32Bit value) {
   }
 }
 void GetTimeResponse::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->epoch_seconds); }
+void GetTimeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->epoch_seconds);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void GetTimeResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3188,6 +3493,10 @@ void ListEntitiesServicesArgument::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_enum<enums::ServiceArgType>(2, this->type);
 }
+void ListEntitiesServicesArgument::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_enum_field<enums::ServiceArgType>(total_size, 2, this->type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesServicesArgument::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3233,6 +3542,13 @@ void ListEntitiesServicesResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<ListEntitiesServicesArgument>(3, it, true);
   }
 }
+void ListEntitiesServicesResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  for (const auto &it : this->args) {
+    ProtoSize::add_message_field<ListEntitiesServicesArgument>(total_size, 3, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesServicesResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3327,6 +3643,25 @@ void ExecuteServiceArgument::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_string(9, it, true);
   }
 }
+void ExecuteServiceArgument::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->bool_);
+  ProtoSize::add_int32_field(total_size, 2, this->legacy_int);
+  ProtoSize::add_float_field(total_size, 3, this->float_);
+  ProtoSize::add_string_field(total_size, 4, this->string_);
+  ProtoSize::add_sint32_field(total_size, 5, this->int_);
+  for (const auto it : this->bool_array) {
+    ProtoSize::add_bool_field(total_size, 6, it, true);
+  }
+  for (const auto &it : this->int_array) {
+    ProtoSize::add_sint32_field(total_size, 7, it, true);
+  }
+  for (const auto &it : this->float_array) {
+    ProtoSize::add_float_field(total_size, 8, it, true);
+  }
+  for (const auto &it : this->string_array) {
+    ProtoSize::add_string_field(total_size, 9, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ExecuteServiceArgument::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3408,6 +3743,12 @@ void ExecuteServiceRequest::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<ExecuteServiceArgument>(2, it, true);
   }
 }
+void ExecuteServiceRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  for (const auto &it : this->args) {
+    ProtoSize::add_message_field<ExecuteServiceArgument>(total_size, 2, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ExecuteServiceRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3480,6 +3821,15 @@ void ListEntitiesCameraResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(6, this->icon);
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
 }
+void ListEntitiesCameraResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 5, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 6, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 7, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesCameraResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3550,6 +3900,11 @@ void CameraImageResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->data);
   buffer.encode_bool(3, this->done);
 }
+void CameraImageResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 2, this->data);
+  ProtoSize::add_bool_field(total_size, 3, this->done);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CameraImageResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3587,6 +3942,10 @@ void CameraImageRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(1, this->single);
   buffer.encode_bool(2, this->stream);
 }
+void CameraImageRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->single);
+  ProtoSize::add_bool_field(total_size, 2, this->stream);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void CameraImageRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3758,6 +4117,45 @@ void ListEntitiesClimateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(24, this->visual_min_humidity);
   buffer.encode_float(25, this->visual_max_humidity);
 }
+void ListEntitiesClimateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_bool_field(total_size, 5, this->supports_current_temperature);
+  ProtoSize::add_bool_field(total_size, 6, this->supports_two_point_target_temperature);
+  for (const auto &it : this->supported_modes) {
+    ProtoSize::add_enum_field<enums::ClimateMode>(total_size, 7, it, true);
+  }
+  ProtoSize::add_float_field(total_size, 8, this->visual_min_temperature);
+  ProtoSize::add_float_field(total_size, 9, this->visual_max_temperature);
+  ProtoSize::add_float_field(total_size, 10, this->visual_target_temperature_step);
+  ProtoSize::add_bool_field(total_size, 11, this->legacy_supports_away);
+  ProtoSize::add_bool_field(total_size, 12, this->supports_action);
+  for (const auto &it : this->supported_fan_modes) {
+    ProtoSize::add_enum_field<enums::ClimateFanMode>(total_size, 13, it, true);
+  }
+  for (const auto &it : this->supported_swing_modes) {
+    ProtoSize::add_enum_field<enums::ClimateSwingMode>(total_size, 14, it, true);
+  }
+  for (const auto &it : this->supported_custom_fan_modes) {
+    ProtoSize::add_string_field(total_size, 15, it, true);
+  }
+  for (const auto &it : this->supported_presets) {
+    ProtoSize::add_enum_field<enums::ClimatePreset>(total_size, 16, it, true);
+  }
+  for (const auto &it : this->supported_custom_presets) {
+    ProtoSize::add_string_field(total_size, 17, it, true);
+  }
+  ProtoSize::add_bool_field(total_size, 18, this->disabled_by_default);
+  ProtoSize::add_string_field(total_size, 19, this->icon);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 20, this->entity_category);
+  ProtoSize::add_float_field(total_size, 21, this->visual_current_temperature_step);
+  ProtoSize::add_bool_field(total_size, 22, this->supports_current_humidity);
+  ProtoSize::add_bool_field(total_size, 23, this->supports_target_humidity);
+  ProtoSize::add_float_field(total_size, 24, this->visual_min_humidity);
+  ProtoSize::add_float_field(total_size, 25, this->visual_max_humidity);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesClimateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -3978,6 +4376,23 @@ void ClimateStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(14, this->current_humidity);
   buffer.encode_float(15, this->target_humidity);
 }
+void ClimateStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::ClimateMode>(total_size, 2, this->mode);
+  ProtoSize::add_float_field(total_size, 3, this->current_temperature);
+  ProtoSize::add_float_field(total_size, 4, this->target_temperature);
+  ProtoSize::add_float_field(total_size, 5, this->target_temperature_low);
+  ProtoSize::add_float_field(total_size, 6, this->target_temperature_high);
+  ProtoSize::add_bool_field(total_size, 7, this->unused_legacy_away);
+  ProtoSize::add_enum_field<enums::ClimateAction>(total_size, 8, this->action);
+  ProtoSize::add_enum_field<enums::ClimateFanMode>(total_size, 9, this->fan_mode);
+  ProtoSize::add_enum_field<enums::ClimateSwingMode>(total_size, 10, this->swing_mode);
+  ProtoSize::add_string_field(total_size, 11, this->custom_fan_mode);
+  ProtoSize::add_enum_field<enums::ClimatePreset>(total_size, 12, this->preset);
+  ProtoSize::add_string_field(total_size, 13, this->custom_preset);
+  ProtoSize::add_float_field(total_size, 14, this->current_humidity);
+  ProtoSize::add_float_field(total_size, 15, this->target_humidity);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ClimateStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4186,6 +4601,31 @@ void ClimateCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(22, this->has_target_humidity);
   buffer.encode_float(23, this->target_humidity);
 }
+void ClimateCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->has_mode);
+  ProtoSize::add_enum_field<enums::ClimateMode>(total_size, 3, this->mode);
+  ProtoSize::add_bool_field(total_size, 4, this->has_target_temperature);
+  ProtoSize::add_float_field(total_size, 5, this->target_temperature);
+  ProtoSize::add_bool_field(total_size, 6, this->has_target_temperature_low);
+  ProtoSize::add_float_field(total_size, 7, this->target_temperature_low);
+  ProtoSize::add_bool_field(total_size, 8, this->has_target_temperature_high);
+  ProtoSize::add_float_field(total_size, 9, this->target_temperature_high);
+  ProtoSize::add_bool_field(total_size, 10, this->unused_has_legacy_away);
+  ProtoSize::add_bool_field(total_size, 11, this->unused_legacy_away);
+  ProtoSize::add_bool_field(total_size, 12, this->has_fan_mode);
+  ProtoSize::add_enum_field<enums::ClimateFanMode>(total_size, 13, this->fan_mode);
+  ProtoSize::add_bool_field(total_size, 14, this->has_swing_mode);
+  ProtoSize::add_enum_field<enums::ClimateSwingMode>(total_size, 15, this->swing_mode);
+  ProtoSize::add_bool_field(total_size, 16, this->has_custom_fan_mode);
+  ProtoSize::add_string_field(total_size, 17, this->custom_fan_mode);
+  ProtoSize::add_bool_field(total_size, 18, this->has_preset);
+  ProtoSize::add_enum_field<enums::ClimatePreset>(total_size, 19, this->preset);
+  ProtoSize::add_bool_field(total_size, 20, this->has_custom_preset);
+  ProtoSize::add_string_field(total_size, 21, this->custom_preset);
+  ProtoSize::add_bool_field(total_size, 22, this->has_target_humidity);
+  ProtoSize::add_float_field(total_size, 23, this->target_humidity);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ClimateCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4374,6 +4814,21 @@ void ListEntitiesNumberResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::NumberMode>(12, this->mode);
   buffer.encode_string(13, this->device_class);
 }
+void ListEntitiesNumberResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_float_field(total_size, 6, this->min_value);
+  ProtoSize::add_float_field(total_size, 7, this->max_value);
+  ProtoSize::add_float_field(total_size, 8, this->step);
+  ProtoSize::add_bool_field(total_size, 9, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 10, this->entity_category);
+  ProtoSize::add_string_field(total_size, 11, this->unit_of_measurement);
+  ProtoSize::add_enum_field<enums::NumberMode>(total_size, 12, this->mode);
+  ProtoSize::add_string_field(total_size, 13, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesNumberResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4465,6 +4920,11 @@ void NumberStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void NumberStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_float_field(total_size, 2, this->state);
+  ProtoSize::add_bool_field(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void NumberStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4503,6 +4963,10 @@ void NumberCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_float(2, this->state);
 }
+void NumberCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_float_field(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void NumberCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4581,6 +5045,18 @@ void ListEntitiesSelectResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(7, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(8, this->entity_category);
 }
+void ListEntitiesSelectResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  for (const auto &it : this->options) {
+    ProtoSize::add_string_field(total_size, 6, it, true);
+  }
+  ProtoSize::add_bool_field(total_size, 7, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 8, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesSelectResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4657,6 +5133,11 @@ void SelectStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void SelectStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 2, this->state);
+  ProtoSize::add_bool_field(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SelectStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4700,6 +5181,10 @@ void SelectCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
 }
+void SelectCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SelectCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4790,6 +5275,19 @@ void ListEntitiesLockResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(10, this->requires_code);
   buffer.encode_string(11, this->code_format);
 }
+void ListEntitiesLockResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_bool_field(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_bool_field(total_size, 8, this->assumed_state);
+  ProtoSize::add_bool_field(total_size, 9, this->supports_open);
+  ProtoSize::add_bool_field(total_size, 10, this->requires_code);
+  ProtoSize::add_string_field(total_size, 11, this->code_format);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesLockResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4865,6 +5363,10 @@ void LockStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::LockState>(2, this->state);
 }
+void LockStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::LockState>(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LockStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -4920,6 +5422,12 @@ void LockCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->has_code);
   buffer.encode_string(4, this->code);
 }
+void LockCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::LockCommand>(total_size, 2, this->command);
+  ProtoSize::add_bool_field(total_size, 3, this->has_code);
+  ProtoSize::add_string_field(total_size, 4, this->code);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void LockCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5003,6 +5511,16 @@ void ListEntitiesButtonResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
   buffer.encode_string(8, this->device_class);
 }
+void ListEntitiesButtonResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_bool_field(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_string_field(total_size, 8, this->device_class);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesButtonResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5053,6 +5571,9 @@ bool ButtonCommandRequest::decode_32bit(uint32_t field_id, Proto32Bit value) {
   }
 }
 void ButtonCommandRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_fixed32(1, this->key); }
+void ButtonCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ButtonCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5124,6 +5645,16 @@ void ListEntitiesMediaPlayerResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
   buffer.encode_bool(8, this->supports_pause);
 }
+void ListEntitiesMediaPlayerResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_bool_field(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_bool_field(total_size, 8, this->supports_pause);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesMediaPlayerResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5197,6 +5728,12 @@ void MediaPlayerStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_float(3, this->volume);
   buffer.encode_bool(4, this->muted);
 }
+void MediaPlayerStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::MediaPlayerState>(total_size, 2, this->state);
+  ProtoSize::add_float_field(total_size, 3, this->volume);
+  ProtoSize::add_bool_field(total_size, 4, this->muted);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void MediaPlayerStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5276,6 +5813,15 @@ void MediaPlayerCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(6, this->has_media_url);
   buffer.encode_string(7, this->media_url);
 }
+void MediaPlayerCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->has_command);
+  ProtoSize::add_enum_field<enums::MediaPlayerCommand>(total_size, 3, this->command);
+  ProtoSize::add_bool_field(total_size, 4, this->has_volume);
+  ProtoSize::add_float_field(total_size, 5, this->volume);
+  ProtoSize::add_bool_field(total_size, 6, this->has_media_url);
+  ProtoSize::add_string_field(total_size, 7, this->media_url);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void MediaPlayerCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5325,6 +5871,9 @@ bool SubscribeBluetoothLEAdvertisementsRequest::decode_varint(uint32_t field_id,
 void SubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->flags);
 }
+void SubscribeBluetoothLEAdvertisementsRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->flags);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeBluetoothLEAdvertisementsRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5367,6 +5916,13 @@ void BluetoothServiceData::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_string(3, this->data);
 }
+void BluetoothServiceData::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->uuid);
+  for (const auto &it : this->legacy_data) {
+    ProtoSize::add_uint32_field(total_size, 2, it, true);
+  }
+  ProtoSize::add_string_field(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothServiceData::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5443,6 +5999,21 @@ void BluetoothLEAdvertisementResponse::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_uint32(7, this->address_type);
 }
+void BluetoothLEAdvertisementResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_string_field(total_size, 2, this->name);
+  ProtoSize::add_sint32_field(total_size, 3, this->rssi);
+  for (const auto &it : this->service_uuids) {
+    ProtoSize::add_string_field(total_size, 4, it, true);
+  }
+  for (const auto &it : this->service_data) {
+    ProtoSize::add_message_field<BluetoothServiceData>(total_size, 5, it, true);
+  }
+  for (const auto &it : this->manufacturer_data) {
+    ProtoSize::add_message_field<BluetoothServiceData>(total_size, 6, it, true);
+  }
+  ProtoSize::add_uint32_field(total_size, 7, this->address_type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLEAdvertisementResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5520,6 +6091,12 @@ void BluetoothLERawAdvertisement::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->address_type);
   buffer.encode_string(4, this->data);
 }
+void BluetoothLERawAdvertisement::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_sint32_field(total_size, 2, this->rssi);
+  ProtoSize::add_uint32_field(total_size, 3, this->address_type);
+  ProtoSize::add_string_field(total_size, 4, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLERawAdvertisement::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5560,6 +6137,11 @@ void BluetoothLERawAdvertisementsResponse::encode(ProtoWriteBuffer buffer) const
     buffer.encode_message<BluetoothLERawAdvertisement>(1, it, true);
   }
 }
+void BluetoothLERawAdvertisementsResponse::calculate_size(uint32_t &total_size) const {
+  for (const auto &it : this->advertisements) {
+    ProtoSize::add_message_field<BluetoothLERawAdvertisement>(total_size, 1, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothLERawAdvertisementsResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5600,6 +6182,12 @@ void BluetoothDeviceRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->has_address_type);
   buffer.encode_uint32(4, this->address_type);
 }
+void BluetoothDeviceRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_enum_field<enums::BluetoothDeviceRequestType>(total_size, 2, this->request_type);
+  ProtoSize::add_bool_field(total_size, 3, this->has_address_type);
+  ProtoSize::add_uint32_field(total_size, 4, this->address_type);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5652,6 +6240,12 @@ void BluetoothDeviceConnectionResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->mtu);
   buffer.encode_int32(4, this->error);
 }
+void BluetoothDeviceConnectionResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_bool_field(total_size, 2, this->connected);
+  ProtoSize::add_uint32_field(total_size, 3, this->mtu);
+  ProtoSize::add_int32_field(total_size, 4, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceConnectionResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5688,6 +6282,9 @@ bool BluetoothGATTGetServicesRequest::decode_varint(uint32_t field_id, ProtoVarI
   }
 }
 void BluetoothGATTGetServicesRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_uint64(1, this->address); }
+void BluetoothGATTGetServicesRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5719,6 +6316,12 @@ void BluetoothGATTDescriptor::encode(ProtoWriteBuffer buffer) const {
   }
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTDescriptor::calculate_size(uint32_t &total_size) const {
+  for (const auto &it : this->uuid) {
+    ProtoSize::add_uint64_field(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTDescriptor::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5775,6 +6378,16 @@ void BluetoothGATTCharacteristic::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTDescriptor>(4, it, true);
   }
 }
+void BluetoothGATTCharacteristic::calculate_size(uint32_t &total_size) const {
+  for (const auto &it : this->uuid) {
+    ProtoSize::add_uint64_field(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+  ProtoSize::add_uint32_field(total_size, 3, this->properties);
+  for (const auto &it : this->descriptors) {
+    ProtoSize::add_message_field<BluetoothGATTDescriptor>(total_size, 4, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTCharacteristic::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5837,6 +6450,15 @@ void BluetoothGATTService::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTCharacteristic>(3, it, true);
   }
 }
+void BluetoothGATTService::calculate_size(uint32_t &total_size) const {
+  for (const auto &it : this->uuid) {
+    ProtoSize::add_uint64_field(total_size, 1, it, true);
+  }
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+  for (const auto &it : this->characteristics) {
+    ProtoSize::add_message_field<BluetoothGATTCharacteristic>(total_size, 3, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTService::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5887,6 +6509,12 @@ void BluetoothGATTGetServicesResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<BluetoothGATTService>(2, it, true);
   }
 }
+void BluetoothGATTGetServicesResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  for (const auto &it : this->services) {
+    ProtoSize::add_message_field<BluetoothGATTService>(total_size, 2, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5917,6 +6545,9 @@ bool BluetoothGATTGetServicesDoneResponse::decode_varint(uint32_t field_id, Prot
 void BluetoothGATTGetServicesDoneResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
 }
+void BluetoothGATTGetServicesDoneResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTGetServicesDoneResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5946,6 +6577,10 @@ void BluetoothGATTReadRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTReadRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -5991,6 +6626,11 @@ void BluetoothGATTReadResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTReadResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+  ProtoSize::add_string_field(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6045,6 +6685,12 @@ void BluetoothGATTWriteRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(3, this->response);
   buffer.encode_string(4, this->data);
 }
+void BluetoothGATTWriteRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+  ProtoSize::add_bool_field(total_size, 3, this->response);
+  ProtoSize::add_string_field(total_size, 4, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6087,6 +6733,10 @@ void BluetoothGATTReadDescriptorRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTReadDescriptorRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTReadDescriptorRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6132,6 +6782,11 @@ void BluetoothGATTWriteDescriptorRequest::encode(ProtoWriteBuffer buffer) const
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTWriteDescriptorRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+  ProtoSize::add_string_field(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteDescriptorRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6175,6 +6830,11 @@ void BluetoothGATTNotifyRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_bool(3, this->enable);
 }
+void BluetoothGATTNotifyRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+  ProtoSize::add_bool_field(total_size, 3, this->enable);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6224,6 +6884,11 @@ void BluetoothGATTNotifyDataResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_string(3, this->data);
 }
+void BluetoothGATTNotifyDataResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+  ProtoSize::add_string_field(total_size, 3, this->data);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyDataResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6245,6 +6910,7 @@ void BluetoothGATTNotifyDataResponse::dump_to(std::string &out) const {
 }
 #endif
 void SubscribeBluetoothConnectionsFreeRequest::encode(ProtoWriteBuffer buffer) const {}
+void SubscribeBluetoothConnectionsFreeRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeBluetoothConnectionsFreeRequest::dump_to(std::string &out) const {
   out.append("SubscribeBluetoothConnectionsFreeRequest {}");
@@ -6268,6 +6934,10 @@ void BluetoothConnectionsFreeResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->free);
   buffer.encode_uint32(2, this->limit);
 }
+void BluetoothConnectionsFreeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->free);
+  ProtoSize::add_uint32_field(total_size, 2, this->limit);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothConnectionsFreeResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6307,6 +6977,11 @@ void BluetoothGATTErrorResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->handle);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothGATTErrorResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+  ProtoSize::add_int32_field(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTErrorResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6346,6 +7021,10 @@ void BluetoothGATTWriteResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTWriteResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTWriteResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6380,6 +7059,10 @@ void BluetoothGATTNotifyResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint64(1, this->address);
   buffer.encode_uint32(2, this->handle);
 }
+void BluetoothGATTNotifyResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_uint32_field(total_size, 2, this->handle);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothGATTNotifyResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6419,6 +7102,11 @@ void BluetoothDevicePairingResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->paired);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDevicePairingResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_bool_field(total_size, 2, this->paired);
+  ProtoSize::add_int32_field(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDevicePairingResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6462,6 +7150,11 @@ void BluetoothDeviceUnpairingResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->success);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDeviceUnpairingResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_bool_field(total_size, 2, this->success);
+  ProtoSize::add_int32_field(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceUnpairingResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6483,6 +7176,7 @@ void BluetoothDeviceUnpairingResponse::dump_to(std::string &out) const {
 }
 #endif
 void UnsubscribeBluetoothLEAdvertisementsRequest::encode(ProtoWriteBuffer buffer) const {}
+void UnsubscribeBluetoothLEAdvertisementsRequest::calculate_size(uint32_t &total_size) const {}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void UnsubscribeBluetoothLEAdvertisementsRequest::dump_to(std::string &out) const {
   out.append("UnsubscribeBluetoothLEAdvertisementsRequest {}");
@@ -6511,6 +7205,11 @@ void BluetoothDeviceClearCacheResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(2, this->success);
   buffer.encode_int32(3, this->error);
 }
+void BluetoothDeviceClearCacheResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint64_field(total_size, 1, this->address);
+  ProtoSize::add_bool_field(total_size, 2, this->success);
+  ProtoSize::add_int32_field(total_size, 3, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void BluetoothDeviceClearCacheResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6549,6 +7248,10 @@ void SubscribeVoiceAssistantRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(1, this->subscribe);
   buffer.encode_uint32(2, this->flags);
 }
+void SubscribeVoiceAssistantRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->subscribe);
+  ProtoSize::add_uint32_field(total_size, 2, this->flags);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void SubscribeVoiceAssistantRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6593,6 +7296,11 @@ void VoiceAssistantAudioSettings::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(2, this->auto_gain);
   buffer.encode_float(3, this->volume_multiplier);
 }
+void VoiceAssistantAudioSettings::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->noise_suppression_level);
+  ProtoSize::add_uint32_field(total_size, 2, this->auto_gain);
+  ProtoSize::add_float_field(total_size, 3, this->volume_multiplier);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantAudioSettings::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6653,6 +7361,13 @@ void VoiceAssistantRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_message<VoiceAssistantAudioSettings>(4, this->audio_settings);
   buffer.encode_string(5, this->wake_word_phrase);
 }
+void VoiceAssistantRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->start);
+  ProtoSize::add_string_field(total_size, 2, this->conversation_id);
+  ProtoSize::add_uint32_field(total_size, 3, this->flags);
+  ProtoSize::add_message_field<VoiceAssistantAudioSettings>(total_size, 4, this->audio_settings);
+  ProtoSize::add_string_field(total_size, 5, this->wake_word_phrase);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6698,6 +7413,10 @@ void VoiceAssistantResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(1, this->port);
   buffer.encode_bool(2, this->error);
 }
+void VoiceAssistantResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_uint32_field(total_size, 1, this->port);
+  ProtoSize::add_bool_field(total_size, 2, this->error);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6731,6 +7450,10 @@ void VoiceAssistantEventData::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->name);
   buffer.encode_string(2, this->value);
 }
+void VoiceAssistantEventData::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->name);
+  ProtoSize::add_string_field(total_size, 2, this->value);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantEventData::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6771,6 +7494,12 @@ void VoiceAssistantEventResponse::encode(ProtoWriteBuffer buffer) const {
     buffer.encode_message<VoiceAssistantEventData>(2, it, true);
   }
 }
+void VoiceAssistantEventResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum_field<enums::VoiceAssistantEvent>(total_size, 1, this->event_type);
+  for (const auto &it : this->data) {
+    ProtoSize::add_message_field<VoiceAssistantEventData>(total_size, 2, it, true);
+  }
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantEventResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6811,6 +7540,10 @@ void VoiceAssistantAudio::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(1, this->data);
   buffer.encode_bool(2, this->end);
 }
+void VoiceAssistantAudio::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->data);
+  ProtoSize::add_bool_field(total_size, 2, this->end);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void VoiceAssistantAudio::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6895,6 +7628,18 @@ void ListEntitiesAlarmControlPanelResponse::encode(ProtoWriteBuffer buffer) cons
   buffer.encode_bool(9, this->requires_code);
   buffer.encode_bool(10, this->requires_code_to_arm);
 }
+void ListEntitiesAlarmControlPanelResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_bool_field(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_uint32_field(total_size, 8, this->supported_features);
+  ProtoSize::add_bool_field(total_size, 9, this->requires_code);
+  ProtoSize::add_bool_field(total_size, 10, this->requires_code_to_arm);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesAlarmControlPanelResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -6967,6 +7712,10 @@ void AlarmControlPanelStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_enum<enums::AlarmControlPanelState>(2, this->state);
 }
+void AlarmControlPanelStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::AlarmControlPanelState>(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void AlarmControlPanelStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7017,6 +7766,11 @@ void AlarmControlPanelCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_enum<enums::AlarmControlPanelStateCommand>(2, this->command);
   buffer.encode_string(3, this->code);
 }
+void AlarmControlPanelCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_enum_field<enums::AlarmControlPanelStateCommand>(total_size, 2, this->command);
+  ProtoSize::add_string_field(total_size, 3, this->code);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void AlarmControlPanelCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7111,6 +7865,19 @@ void ListEntitiesTextResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(10, this->pattern);
   buffer.encode_enum<enums::TextMode>(11, this->mode);
 }
+void ListEntitiesTextResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_bool_field(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 7, this->entity_category);
+  ProtoSize::add_uint32_field(total_size, 8, this->min_length);
+  ProtoSize::add_uint32_field(total_size, 9, this->max_length);
+  ProtoSize::add_string_field(total_size, 10, this->pattern);
+  ProtoSize::add_enum_field<enums::TextMode>(total_size, 11, this->mode);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesTextResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7199,6 +7966,11 @@ void TextStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_string(2, this->state);
   buffer.encode_bool(3, this->missing_state);
 }
+void TextStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 2, this->state);
+  ProtoSize::add_bool_field(total_size, 3, this->missing_state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TextStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7242,6 +8014,10 @@ void TextCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_fixed32(1, this->key);
   buffer.encode_string(2, this->state);
 }
+void TextCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_string_field(total_size, 2, this->state);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TextCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7312,6 +8088,15 @@ void ListEntitiesDateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(6, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
 }
+void ListEntitiesDateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_bool_field(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 7, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesDateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7386,6 +8171,13 @@ void DateStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(4, this->month);
   buffer.encode_uint32(5, this->day);
 }
+void DateStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->missing_state);
+  ProtoSize::add_uint32_field(total_size, 3, this->year);
+  ProtoSize::add_uint32_field(total_size, 4, this->month);
+  ProtoSize::add_uint32_field(total_size, 5, this->day);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DateStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7450,6 +8242,12 @@ void DateCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->month);
   buffer.encode_uint32(4, this->day);
 }
+void DateCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_uint32_field(total_size, 2, this->year);
+  ProtoSize::add_uint32_field(total_size, 3, this->month);
+  ProtoSize::add_uint32_field(total_size, 4, this->day);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void DateCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7531,6 +8329,15 @@ void ListEntitiesTimeResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_bool(6, this->disabled_by_default);
   buffer.encode_enum<enums::EntityCategory>(7, this->entity_category);
 }
+void ListEntitiesTimeResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_string_field(total_size, 1, this->object_id);
+  ProtoSize::add_fixed32_field(total_size, 2, this->key);
+  ProtoSize::add_string_field(total_size, 3, this->name);
+  ProtoSize::add_string_field(total_size, 4, this->unique_id);
+  ProtoSize::add_string_field(total_size, 5, this->icon);
+  ProtoSize::add_bool_field(total_size, 6, this->disabled_by_default);
+  ProtoSize::add_enum_field<enums::EntityCategory>(total_size, 7, this->entity_category);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void ListEntitiesTimeResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7605,6 +8412,13 @@ void TimeStateResponse::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(4, this->minute);
   buffer.encode_uint32(5, this->second);
 }
+void TimeStateResponse::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_bool_field(total_size, 2, this->missing_state);
+  ProtoSize::add_uint32_field(total_size, 3, this->hour);
+  ProtoSize::add_uint32_field(total_size, 4, this->minute);
+  ProtoSize::add_uint32_field(total_size, 5, this->second);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TimeStateResponse::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7669,6 +8483,12 @@ void TimeCommandRequest::encode(ProtoWriteBuffer buffer) const {
   buffer.encode_uint32(3, this->minute);
   buffer.encode_uint32(4, this->second);
 }
+void TimeCommandRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_fixed32_field(total_size, 1, this->key);
+  ProtoSize::add_uint32_field(total_size, 2, this->hour);
+  ProtoSize::add_uint32_field(total_size, 3, this->minute);
+  ProtoSize::add_uint32_field(total_size, 4, this->second);
+}
 #ifdef HAS_PROTO_MESSAGE_DUMP
 void TimeCommandRequest::dump_to(std::string &out) const {
   __attribute__((unused)) char buffer[64];
@@ -7695,6 +8515,170 @@ void TimeCommandRequest::dump_to(std::string &out) const {
   out.append("}");
 }
 #endif
+bool LoopProfileRequest::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->reset = value.as_bool();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void LoopProfileRequest::encode(ProtoWriteBuffer buffer) const { buffer.encode_bool(1, this->reset); }
+void LoopProfileRequest::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_bool_field(total_size, 1, this->reset);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void LoopProfileRequest::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("LoopProfileRequest {\n");
+  out.append("  reset: ");
+  out.append(YESNO(this->reset));
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool LoopProfileEntry::decode_varint(uint32_t field_id, ProtoVarInt value) {
+  switch (field_id) {
+    case 1: {
+      this->source = value.as_enum<enums::LoopProfileSource>();
+      return true;
+    }
+    case 3: {
+      this->index = value.as_uint32();
+      return true;
+    }
+    case 4: {
+      this->count = value.as_uint32();
+      return true;
+    }
+    case 5: {
+      this->min_us = value.as_uint32();
+      return true;
+    }
+    case 6: {
+      this->avg_us = value.as_uint32();
+      return true;
+    }
+    case 7: {
+      this->max_us = value.as_uint32();
+      return true;
+    }
+    case 8: {
+      this->p99_us = value.as_uint32();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+bool LoopProfileEntry::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 2: {
+      this->component = value.as_string();
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void LoopProfileEntry::encode(ProtoWriteBuffer buffer) const {
+  buffer.encode_enum<enums::LoopProfileSource>(1, this->source);
+  buffer.encode_string(2, this->component);
+  buffer.encode_uint32(3, this->index);
+  buffer.encode_uint32(4, this->count);
+  buffer.encode_uint32(5, this->min_us);
+  buffer.encode_uint32(6, this->avg_us);
+  buffer.encode_uint32(7, this->max_us);
+  buffer.encode_uint32(8, this->p99_us);
+}
+void LoopProfileEntry::calculate_size(uint32_t &total_size) const {
+  ProtoSize::add_enum_field<enums::LoopProfileSource>(total_size, 1, this->source);
+  ProtoSize::add_string_field(total_size, 2, this->component);
+  ProtoSize::add_uint32_field(total_size, 3, this->index);
+  ProtoSize::add_uint32_field(total_size, 4, this->count);
+  ProtoSize::add_uint32_field(total_size, 5, this->min_us);
+  ProtoSize::add_uint32_field(total_size, 6, this->avg_us);
+  ProtoSize::add_uint32_field(total_size, 7, this->max_us);
+  ProtoSize::add_uint32_field(total_size, 8, this->p99_us);
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void LoopProfileEntry::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("LoopProfileEntry {\n");
+  out.append("  source: ");
+  out.append(proto_enum_to_string<enums::LoopProfileSource>(this->source));
+  out.append("\n");
+
+  out.append("  component: ");
+  out.append("'").append(this->component).append("'");
+  out.append("\n");
+
+  out.append("  index: ");
+  sprintf(buffer, "%" PRIu32, this->index);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  count: ");
+  sprintf(buffer, "%" PRIu32, this->count);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  min_us: ");
+  sprintf(buffer, "%" PRIu32, this->min_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  avg_us: ");
+  sprintf(buffer, "%" PRIu32, this->avg_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  max_us: ");
+  sprintf(buffer, "%" PRIu32, this->max_us);
+  out.append(buffer);
+  out.append("\n");
+
+  out.append("  p99_us: ");
+  sprintf(buffer, "%" PRIu32, this->p99_us);
+  out.append(buffer);
+  out.append("\n");
+  out.append("}");
+}
+#endif
+bool LoopProfileResponse::decode_length(uint32_t field_id, ProtoLengthDelimited value) {
+  switch (field_id) {
+    case 1: {
+      this->entries.push_back(value.as_message<LoopProfileEntry>());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+void LoopProfileResponse::encode(ProtoWriteBuffer buffer) const {
+  for (auto &it : this->entries) {
+    buffer.encode_message<LoopProfileEntry>(1, it, true);
+  }
+}
+void LoopProfileResponse::calculate_size(uint32_t &total_size) const {
+  for (const auto &it : this->entries) {
+    ProtoSize::add_message_field<LoopProfileEntry>(total_size, 1, it, true);
+  }
+}
+#ifdef HAS_PROTO_MESSAGE_DUMP
+void LoopProfileResponse::dump_to(std::string &out) const {
+  __attribute__((unused)) char buffer[64];
+  out.append("LoopProfileResponse {\n");
+  for (const auto &it : this->entries) {
+    out.append("  entries: ");
+    it.dump_to(out);
+    out.append("\n");
+  }
+  out.append("}");
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
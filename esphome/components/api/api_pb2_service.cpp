@@ -557,6 +557,16 @@ bool APIServerConnectionBase::send_time_state_response(const TimeStateResponse &
 #endif
 #ifdef USE_DATETIME_TIME
 #endif
+#ifdef USE_LOOP_PROFILER
+#endif
+#ifdef USE_LOOP_PROFILER
+bool APIServerConnectionBase::send_loop_profile_response(const LoopProfileResponse &msg) {
+#ifdef HAS_PROTO_MESSAGE_DUMP
+  ESP_LOGVV(TAG, "send_loop_profile_response: %s", msg.dump().c_str());
+#endif
+  return this->send_message_<LoopProfileResponse>(msg, 108);
+}
+#endif
 bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) {
   switch (msg_type) {
     case 1: {
@@ -1019,6 +1029,17 @@ bool APIServerConnectionBase::read_message(uint32_t msg_size, uint32_t msg_type,
       ESP_LOGVV(TAG, "on_voice_assistant_audio: %s", msg.dump().c_str());
 #endif
       this->on_voice_assistant_audio(msg);
+#endif
+      break;
+    }
+    case 107: {
+#ifdef USE_LOOP_PROFILER
+      LoopProfileRequest msg;
+      msg.decode(msg_data, msg_size);
+#ifdef HAS_PROTO_MESSAGE_DUMP
+      ESP_LOGVV(TAG, "on_loop_profile_request: %s", msg.dump().c_str());
+#endif
+      this->on_loop_profile_request(msg);
 #endif
       break;
     }
@@ -1483,6 +1504,22 @@ void APIServerConnection::on_alarm_control_panel_command_request(const AlarmCont
   this->alarm_control_panel_command(msg);
 }
 #endif
+#ifdef USE_LOOP_PROFILER
+void APIServerConnection::on_loop_profile_request(const LoopProfileRequest &msg) {
+  if (!this->is_connection_setup()) {
+    this->on_no_setup_connection();
+    return;
+  }
+  if (!this->is_authenticated()) {
+    this->on_unauthenticated_access();
+    return;
+  }
+  LoopProfileResponse ret = this->loop_profile(msg);
+  if (!this->send_loop_profile_response(ret)) {
+    this->on_fatal_error();
+  }
+}
+#endif
 
 }  // namespace api
 }  // namespace esphome
@@ -279,6 +279,12 @@ class APIServerConnectionBase : public ProtoService {
 #endif
 #ifdef USE_DATETIME_TIME
   virtual void on_time_command_request(const TimeCommandRequest &value){};
+#endif
+#ifdef USE_LOOP_PROFILER
+  virtual void on_loop_profile_request(const LoopProfileRequest &value){};
+#endif
+#ifdef USE_LOOP_PROFILER
+  bool send_loop_profile_response(const LoopProfileResponse &msg);
 #endif
  protected:
   bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) override;
@@ -376,6 +382,9 @@ class APIServerConnection : public APIServerConnectionBase {
 #endif
 #ifdef USE_ALARM_CONTROL_PANEL
   virtual void alarm_control_panel_command(const AlarmControlPanelCommandRequest &msg) = 0;
+#endif
+#ifdef USE_LOOP_PROFILER
+  virtual LoopProfileResponse loop_profile(const LoopProfileRequest &msg) = 0;
 #endif
  protected:
   void on_hello_request(const HelloRequest &msg) override;
@@ -469,6 +478,9 @@ class APIServerConnection : public APIServerConnectionBase {
 #ifdef USE_ALARM_CONTROL_PANEL
   void on_alarm_control_panel_command_request(const AlarmControlPanelCommandRequest &msg) override;
 #endif
+#ifdef USE_LOOP_PROFILER
+  void on_loop_profile_request(const LoopProfileRequest &msg) override;
+#endif
 };
 
 }  // namespace api
@@ -24,7 +24,7 @@ static const char *const TAG = "api";
 void APIServer::setup() {
   ESP_LOGCONFIG(TAG, "Setting up Home Assistant API server...");
   this->setup_controller();
-  socket_ = socket::socket_ip(SOCK_STREAM, 0);
+  socket_ = socket::socket_ip_loop_monitored(SOCK_STREAM, 0);
   if (socket_ == nullptr) {
     ESP_LOGW(TAG, "Could not create socket.");
     this->mark_failed();
@@ -135,6 +135,15 @@ void APIServer::loop() {
     }
   }
 }
+uint32_t APIServer::get_idle_loop_interval() {
+  // Without a monitored listening socket, new clients are only noticed by polling accept()
+  if (this->socket_ == nullptr || !this->socket_->is_loop_monitored())
+    return 0;
+  uint32_t interval = UINT32_MAX;
+  for (auto &client : this->clients_)
+    interval = std::min(interval, client->get_idle_loop_interval());
+  return interval;
+}
 void APIServer::dump_config() {
   ESP_LOGCONFIG(TAG, "API Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network::get_use_address().c_str(), this->port_);
@@ -343,9 +352,26 @@ void APIServer::request_time() {
 }
 #endif
 bool APIServer::is_connected() const { return !this->clients_.empty(); }
+
+#ifdef USE_LOOP_PROFILER
+LoopProfile *APIServer::get_message_profile(uint32_t message_type) {
+  for (auto &message : this->message_profiles_) {
+    if (message.message_type == message_type)
+      return &message.profile;
+  }
+  if (this->message_profiles_.size() >= MAX_MESSAGE_PROFILES)
+    return nullptr;
+  if (this->message_profiles_.empty())
+    this->message_profiles_.reserve(MAX_MESSAGE_PROFILES);
+  this->message_profiles_.push_back(MessageProfile{message_type, {}});
+  return &this->message_profiles_.back().profile;
+}
+#endif
 void APIServer::on_shutdown() {
   for (auto &c : this->clients_) {
     c->send_disconnect_request(DisconnectRequest());
+    // there is no loop() left to flush a batch after the batch delay
+    c->flush_batch_();
   }
   delay(10);
 }
@@ -9,6 +9,7 @@
 #include "esphome/core/controller.h"
 #include "esphome/core/defines.h"
 #include "esphome/core/log.h"
+#include "esphome/core/loop_profile.h"
 #include "list_entities.h"
 #include "subscribe_state.h"
 #include "user_services.h"
@@ -25,6 +26,7 @@ class APIServer : public Component, public Controller {
   uint16_t get_port() const;
   float get_setup_priority() const override;
   void loop() override;
+  uint32_t get_idle_loop_interval() override;
   void dump_config() override;
   void on_shutdown() override;
   bool check_password(const std::string &password) const;
@@ -32,6 +34,9 @@ class APIServer : public Component, public Controller {
   void set_port(uint16_t port);
   void set_password(const std::string &password);
   void set_reboot_timeout(uint32_t reboot_timeout);
+  /// Coalesce messages sent within this many milliseconds into a single socket write.
+  void set_batch_delay(uint16_t batch_delay) { this->batch_delay_ = batch_delay; }
+  const optional<uint16_t> &get_batch_delay() const { return this->batch_delay_; }
 
 #ifdef USE_API_NOISE
   void set_noise_psk(psk_t psk) { noise_ctx_->set_psk(psk); }
@@ -107,6 +112,18 @@ class APIServer : public Component, public Controller {
   const std::vector<HomeAssistantStateSubscription> &get_state_subs() const;
   const std::vector<UserServiceDescriptor *> &get_user_services() const { return this->user_services_; }
 
+#ifdef USE_LOOP_PROFILER
+  /// Maximum number of distinct API message types that are profiled.
+  static const uint8_t MAX_MESSAGE_PROFILES = 16;
+  struct MessageProfile {
+    uint32_t message_type;
+    LoopProfile profile;
+  };
+  /// Get the profile for handling the given message type, or nullptr if all profile slots are in use.
+  LoopProfile *get_message_profile(uint32_t message_type);
+  std::vector<MessageProfile> &get_message_profiles() { return this->message_profiles_; }
+#endif
+
   Trigger<std::string, std::string> *get_client_connected_trigger() const { return this->client_connected_trigger_; }
   Trigger<std::string, std::string> *get_client_disconnected_trigger() const {
     return this->client_disconnected_trigger_;
@@ -116,6 +133,7 @@ class APIServer : public Component, public Controller {
   std::unique_ptr<socket::Socket> socket_ = nullptr;
   uint16_t port_{6053};
   uint32_t reboot_timeout_{300000};
+  optional<uint16_t> batch_delay_{};
   uint32_t last_connected_{0};
   std::vector<std::unique_ptr<APIConnection>> clients_;
   std::string password_;
@@ -127,6 +145,9 @@ class APIServer : public Component, public Controller {
 #ifdef USE_API_NOISE
   std::shared_ptr<APINoiseContext> noise_ctx_ = std::make_shared<APINoiseContext>();
 #endif  // USE_API_NOISE
+#ifdef USE_LOOP_PROFILER
+  std::vector<MessageProfile> message_profiles_;
+#endif
 };
 
 extern APIServer *global_api_server;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -56,6 +56,21 @@ void ProtoMessage::decode(const uint8_t *buffer, size_t length) {
         i += field_length;
         break;
       }
+      case 1: {  // 64-bit
+        if (length - i < 8) {
+          ESP_LOGV(TAG, "Out-of-bounds Fixed64-bit at %" PRIu32, i);
+          error = true;
+          break;
+        }
+        uint64_t val = 0;
+        for (uint8_t j = 0; j < 8; j++)
+          val |= uint64_t(buffer[i + j]) << (8 * j);
+        if (!this->decode_64bit(field_id, Proto64Bit(val))) {
+          ESP_LOGV(TAG, "Cannot decode 64-bit field %" PRIu32 "!", field_id);
+        }
+        i += 8;
+        break;
+      }
       case 5: {  // 32-bit
         if (length - i < 4) {
           ESP_LOGV(TAG, "Out-of-bounds Fixed32-bit at %" PRIu32, i);
@@ -71,6 +71,23 @@ class ProtoVarInt {
       return static_cast<int64_t>(this->value_ >> 1);
     }
   }
+  /// Encode into \p out, which must have room for at least size() bytes. Returns a pointer past the last byte written.
+  uint8_t *encode_to(uint8_t *out) const {
+    uint64_t val = this->value_;
+    do {
+      uint8_t temp = val & 0x7F;
+      val >>= 7;
+      *out++ = val ? temp | 0x80 : temp;
+    } while (val);
+    return out;
+  }
+  /// Number of bytes this value takes up when encoded.
+  uint8_t size() const {
+    uint8_t bytes = 1;
+    for (uint64_t val = this->value_ >> 7; val != 0; val >>= 7)
+      bytes++;
+    return bytes;
+  }
   void encode(std::vector<uint8_t> &out) {
     uint64_t val = this->value_;
     if (val <= 0x7F) {
@@ -163,7 +180,7 @@ class ProtoWriteBuffer {
     this->buffer_->insert(this->buffer_->end(), data, data + len);
   }
   void encode_string(uint32_t field_id, const std::string &value, bool force = false) {
-    this->encode_string(field_id, value.data(), value.size());
+    this->encode_string(field_id, value.data(), value.size(), force);
   }
   void encode_bytes(uint32_t field_id, const uint8_t *data, size_t len, bool force = false) {
     this->encode_string(field_id, reinterpret_cast<const char *>(data), len, force);
@@ -200,7 +217,7 @@ class ProtoWriteBuffer {
     if (value == 0 && !force)
       return;
 
-    this->encode_field_raw(field_id, 5);
+    this->encode_field_raw(field_id, 1);
     this->write((value >> 0) & 0xFF);
     this->write((value >> 8) & 0xFF);
     this->write((value >> 16) & 0xFF);
@@ -222,7 +239,24 @@ class ProtoWriteBuffer {
       uint32_t raw;
     } val{};
     val.value = value;
-    this->encode_fixed32(field_id, val.raw);
+    this->encode_fixed32(field_id, val.raw, force);
+  }
+  void encode_double(uint32_t field_id, double value, bool force = false) {
+    if (value == 0.0 && !force)
+      return;
+
+    union {
+      double value;
+      uint64_t raw;
+    } val{};
+    val.value = value;
+    this->encode_fixed64(field_id, val.raw, force);
+  }
+  void encode_sfixed32(uint32_t field_id, int32_t value, bool force = false) {
+    this->encode_fixed32(field_id, static_cast<uint32_t>(value), force);
+  }
+  void encode_sfixed64(uint32_t field_id, int64_t value, bool force = false) {
+    this->encode_fixed64(field_id, static_cast<uint64_t>(value), force);
   }
   void encode_int32(uint32_t field_id, int32_t value, bool force = false) {
     if (value < 0) {
@@ -255,15 +289,11 @@ class ProtoWriteBuffer {
   }
   template<class C> void encode_message(uint32_t field_id, const C &value, bool force = false) {
     this->encode_field_raw(field_id, 2);
-    size_t begin = this->buffer_->size();
-
+    // The length prefix comes first, so size the nested message up front instead of moving it afterwards
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    this->encode_varint_raw(nested_length);
     value.encode(*this);
-
-    const uint32_t nested_length = this->buffer_->size() - begin;
-    // add size varint
-    std::vector<uint8_t> var;
-    ProtoVarInt(nested_length).encode(var);
-    this->buffer_->insert(this->buffer_->begin() + begin, var.begin(), var.end());
   }
   std::vector<uint8_t> *get_buffer() const { return buffer_; }
 
@@ -271,10 +301,99 @@ class ProtoWriteBuffer {
   std::vector<uint8_t> *buffer_;
 };
 
+/** Helpers for computing the encoded size of message fields, mirroring the encode_* methods of ProtoWriteBuffer.
+ *
+ * Each function adds the size of one field (tag included) to \p total_size, and skips default values unless
+ * \p force is set, exactly like the corresponding encoder.
+ */
+class ProtoSize {
+ public:
+  static uint32_t varint(uint64_t value) { return ProtoVarInt(value).size(); }
+  static uint32_t field(uint32_t field_id, uint32_t type) { return varint((field_id << 3) | (type & 0b111)); }
+
+  static void add_uint32_field(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_uint64_field(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 0) + varint(value);
+  }
+  static void add_int32_field(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    if (value < 0) {
+      // negative int32 is always 10 byte long
+      add_int64_field(total_size, field_id, value, force);
+      return;
+    }
+    add_uint32_field(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_int64_field(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    add_uint64_field(total_size, field_id, static_cast<uint64_t>(value), force);
+  }
+  static void add_sint32_field(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    add_uint32_field(total_size, field_id, value < 0 ? ~(value << 1) : value << 1, force);
+  }
+  static void add_sint64_field(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    add_uint64_field(total_size, field_id, value < 0 ? ~(value << 1) : value << 1, force);
+  }
+  static void add_bool_field(uint32_t &total_size, uint32_t field_id, bool value, bool force = false) {
+    if (!value && !force)
+      return;
+    total_size += field(field_id, 0) + 1;
+  }
+  template<typename T>
+  static void add_enum_field(uint32_t &total_size, uint32_t field_id, T value, bool force = false) {
+    add_uint32_field(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_fixed32_field(uint32_t &total_size, uint32_t field_id, uint32_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  static void add_fixed64_field(uint32_t &total_size, uint32_t field_id, uint64_t value, bool force = false) {
+    if (value == 0 && !force)
+      return;
+    total_size += field(field_id, 1) + 8;
+  }
+  static void add_sfixed32_field(uint32_t &total_size, uint32_t field_id, int32_t value, bool force = false) {
+    add_fixed32_field(total_size, field_id, static_cast<uint32_t>(value), force);
+  }
+  static void add_sfixed64_field(uint32_t &total_size, uint32_t field_id, int64_t value, bool force = false) {
+    add_fixed64_field(total_size, field_id, static_cast<uint64_t>(value), force);
+  }
+  static void add_double_field(uint32_t &total_size, uint32_t field_id, double value, bool force = false) {
+    if (value == 0.0 && !force)
+      return;
+    total_size += field(field_id, 1) + 8;
+  }
+  static void add_float_field(uint32_t &total_size, uint32_t field_id, float value, bool force = false) {
+    if (value == 0.0f && !force)
+      return;
+    total_size += field(field_id, 5) + 4;
+  }
+  static void add_string_field(uint32_t &total_size, uint32_t field_id, const std::string &value,
+                               bool force = false) {
+    if (value.empty() && !force)
+      return;
+    total_size += field(field_id, 2) + varint(value.size()) + value.size();
+  }
+  template<class C>
+  static void add_message_field(uint32_t &total_size, uint32_t field_id, const C &value, bool force = false) {
+    // Nested messages are always encoded, even when empty
+    uint32_t nested_length = 0;
+    value.calculate_size(nested_length);
+    total_size += field(field_id, 2) + varint(nested_length) + nested_length;
+  }
+};
+
 class ProtoMessage {
  public:
   virtual ~ProtoMessage() = default;
   virtual void encode(ProtoWriteBuffer buffer) const = 0;
+  /// Add the number of bytes encode() will write to \p total_size.
+  virtual void calculate_size(uint32_t &total_size) const = 0;
   void decode(const uint8_t *buffer, size_t length);
 #ifdef HAS_PROTO_MESSAGE_DUMP
   std::string dump() const;
@@ -298,12 +417,15 @@ class ProtoService {
   virtual void on_fatal_error() = 0;
   virtual void on_unauthenticated_access() = 0;
   virtual void on_no_setup_connection() = 0;
-  virtual ProtoWriteBuffer create_buffer() = 0;
+  /// Create a buffer for a message of \p reserve_size bytes; messages larger than that still fit, but may reallocate.
+  virtual ProtoWriteBuffer create_buffer(uint32_t reserve_size) = 0;
   virtual bool send_buffer(ProtoWriteBuffer buffer, uint32_t message_type) = 0;
   virtual bool read_message(uint32_t msg_size, uint32_t msg_type, uint8_t *msg_data) = 0;
 
   template<class C> bool send_message_(const C &msg, uint32_t message_type) {
-    auto buffer = this->create_buffer();
+    uint32_t msg_size = 0;
+    msg.calculate_size(msg_size);
+    auto buffer = this->create_buffer(msg_size);
     msg.encode(buffer);
     return this->send_buffer(buffer, message_type);
   }
@@ -1,6 +1,7 @@
 #include "debug_component.h"
 
 #include <algorithm>
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/helpers.h"
@@ -71,6 +72,8 @@ void DebugComponent::dump_config() {
 #ifdef USE_SENSOR
   LOG_SENSOR("  ", "Free space on heap", this->free_sensor_);
   LOG_SENSOR("  ", "Largest free heap block", this->block_sensor_);
+  LOG_SENSOR("  ", "Scheduler items", this->scheduler_items_sensor_);
+  LOG_SENSOR("  ", "Scheduler allocations", this->scheduler_allocations_sensor_);
 #if defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
   LOG_SENSOR("  ", "Heap fragmentation", this->fragmentation_sensor_);
 #endif  // defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
@@ -81,6 +84,8 @@ void DebugComponent::dump_config() {
 
   this->free_heap_ = get_free_heap();
   ESP_LOGD(TAG, "Free Heap Size: %" PRIu32 " bytes", this->free_heap_);
+  ESP_LOGD(TAG, "Scheduler: %zu items, %" PRIu32 " item allocations", App.scheduler.get_item_count(),
+           App.scheduler.get_item_allocations());
 
 #if defined(USE_ARDUINO) && (defined(USE_ESP32) || defined(USE_ESP8266))
   const char *flash_mode;
@@ -437,12 +442,37 @@ void DebugComponent::update() {
     this->max_loop_time_ = 0;
   }
 
+  if (this->scheduler_items_sensor_ != nullptr) {
+    this->scheduler_items_sensor_->publish_state(App.scheduler.get_item_count());
+  }
+
+  if (this->scheduler_allocations_sensor_ != nullptr) {
+    this->scheduler_allocations_sensor_->publish_state(App.scheduler.get_item_allocations());
+  }
+
 #ifdef USE_ESP32
   if (this->psram_sensor_ != nullptr) {
     this->psram_sensor_->publish_state(heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
   }
 #endif  // USE_ESP32
 #endif  // USE_SENSOR
+
+#ifdef USE_LOOP_PROFILER
+  // Report the component whose loop() took the longest since the profiles were last reset. They are shared with the
+  // API and Prometheus, so they are not reset here.
+  Component *slowest = nullptr;
+  for (auto *component : App.get_components()) {
+    if (slowest == nullptr || component->get_loop_profile().get_max_us() > slowest->get_loop_profile().get_max_us())
+      slowest = component;
+  }
+  if (slowest != nullptr && slowest->get_loop_profile().get_count() != 0) {
+    const LoopProfile &profile = slowest->get_loop_profile();
+    ESP_LOGD(TAG,
+             "Slowest loop so far: %s (%" PRIu32 " calls, avg %" PRIu32 " us, p99 %" PRIu32 " us, max %" PRIu32 " us)",
+             slowest->get_component_source(), profile.get_count(), profile.get_avg_us(), profile.get_percentile_us(99),
+             profile.get_max_us());
+  }
+#endif
 }
 
 float DebugComponent::get_setup_priority() const { return setup_priority::LATE; }
@@ -33,6 +33,12 @@ class DebugComponent : public PollingComponent {
   void set_fragmentation_sensor(sensor::Sensor *fragmentation_sensor) { fragmentation_sensor_ = fragmentation_sensor; }
 #endif
   void set_loop_time_sensor(sensor::Sensor *loop_time_sensor) { loop_time_sensor_ = loop_time_sensor; }
+  void set_scheduler_items_sensor(sensor::Sensor *scheduler_items_sensor) {
+    scheduler_items_sensor_ = scheduler_items_sensor;
+  }
+  void set_scheduler_allocations_sensor(sensor::Sensor *scheduler_allocations_sensor) {
+    scheduler_allocations_sensor_ = scheduler_allocations_sensor;
+  }
 #ifdef USE_ESP32
   void set_psram_sensor(sensor::Sensor *psram_sensor) { this->psram_sensor_ = psram_sensor; }
 #endif  // USE_ESP32
@@ -50,6 +56,8 @@ class DebugComponent : public PollingComponent {
   sensor::Sensor *fragmentation_sensor_{nullptr};
 #endif
   sensor::Sensor *loop_time_sensor_{nullptr};
+  sensor::Sensor *scheduler_items_sensor_{nullptr};
+  sensor::Sensor *scheduler_allocations_sensor_{nullptr};
 #ifdef USE_ESP32
   sensor::Sensor *psram_sensor_{nullptr};
 #endif  // USE_ESP32
@@ -12,12 +12,15 @@ from esphome.const import (
     UNIT_BYTES,
     ICON_COUNTER,
     ICON_TIMER,
+    STATE_CLASS_TOTAL_INCREASING,
 )
 from . import CONF_DEBUG_ID, DebugComponent
 
 DEPENDENCIES = ["debug"]
 
 CONF_PSRAM = "psram"
+CONF_SCHEDULER_ITEMS = "scheduler_items"
+CONF_SCHEDULER_ALLOCATIONS = "scheduler_allocations"
 
 CONFIG_SCHEMA = {
     cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
@@ -49,6 +52,17 @@ CONFIG_SCHEMA = {
         accuracy_decimals=0,
         entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
     ),
+    cv.Optional(CONF_SCHEDULER_ITEMS): sensor.sensor_schema(
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_SCHEDULER_ALLOCATIONS): sensor.sensor_schema(
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
     cv.Optional(CONF_PSRAM): cv.All(
         cv.only_on_esp32,
         cv.requires_component("psram"),
@@ -81,6 +95,14 @@ async def to_code(config):
         sens = await sensor.new_sensor(loop_time_conf)
         cg.add(debug_component.set_loop_time_sensor(sens))
 
+    if scheduler_items_conf := config.get(CONF_SCHEDULER_ITEMS):
+        sens = await sensor.new_sensor(scheduler_items_conf)
+        cg.add(debug_component.set_scheduler_items_sensor(sens))
+
+    if scheduler_allocations_conf := config.get(CONF_SCHEDULER_ALLOCATIONS):
+        sens = await sensor.new_sensor(scheduler_allocations_conf)
+        cg.add(debug_component.set_scheduler_allocations_sensor(sens))
+
     if psram_conf := config.get(CONF_PSRAM):
         sens = await sensor.new_sensor(psram_conf)
         cg.add(debug_component.set_psram_sensor(sens))
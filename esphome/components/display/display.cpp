@@ -85,6 +85,11 @@ void Display::draw_pixels_at(int x_start, int y_start, int w, int h, const uint8
   }
 }
 
+void Display::draw_span_at(int x, int y, int width, const Color *colors) {
+  for (int i = 0; i < width; i++)
+    this->draw_pixel_at(x + i, y, colors[i]);
+}
+
 void HOT Display::horizontal_line(int x, int y, int width, Color color) {
   // Future: Could be made more efficient by manipulating buffer directly in certain rotations.
   for (int i = x; i < x + width; i++)
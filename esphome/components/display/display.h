@@ -227,6 +227,14 @@ class Display : public PollingComponent {
   /// Set a single pixel at the specified coordinates to the given color.
   virtual void draw_pixel_at(int x, int y, Color color) = 0;
 
+  /** Draw \p width pixels with the given colors in a row, starting at [x,y] and going right.
+   *
+   * This is how fonts and images draw many pixels at once. The naive implementation here draws them one by one, display
+   * buffers override it to clip and rotate the whole row at once. Unlike draw_pixel_at(), this doesn't feed the
+   * watchdog, callers should do that every few rows.
+   */
+  virtual void draw_span_at(int x, int y, int width, const Color *colors);
+
   /** Given an array of pixels encoded in the nominated format, draw these into the display's buffer.
    * The naive implementation here will work in all cases, but can be overridden by sub-classes
    * in order to optimise the procedure.
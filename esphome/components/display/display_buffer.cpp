@@ -1,5 +1,8 @@
 #include "display_buffer.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <utility>
 
 #include "esphome/core/application.h"
@@ -10,6 +13,25 @@ namespace display {
 
 static const char *const TAG = "display";
 
+/// Changes this close to a dirty region are added to it, rather than getting their own region.
+static const int16_t DIRTY_MERGE_DISTANCE = 8;
+
+static bool regions_near(const Rect &a, const Rect &b, int16_t distance) {
+  return a.x <= b.x2() + distance && b.x <= a.x2() + distance && a.y <= b.y2() + distance &&
+         b.y <= a.y2() + distance;
+}
+
+static bool regions_overlap(const Rect &a, const Rect &b) {
+  return a.x < b.x2() && b.x < a.x2() && a.y < b.y2() && b.y < a.y2();
+}
+
+static int32_t region_area(const Rect &region) { return int32_t(region.w) * region.h; }
+
+// state of a tile, for init_tile_checksums_()
+static const uint8_t TILE_CHECKSUM_VALID = 1 << 0;
+static const uint8_t TILE_CHECKED = 1 << 1;
+static const uint8_t TILE_CHANGED = 1 << 2;
+
 void DisplayBuffer::init_internal_(uint32_t buffer_length) {
   ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
   this->buffer_ = allocator.allocate(buffer_length);
@@ -18,6 +40,142 @@ void DisplayBuffer::init_internal_(uint32_t buffer_length) {
     return;
   }
   this->clear();
+  // whatever the display showed before has to be replaced
+  this->mark_dirty_(Rect(0, 0, this->get_width_internal(), this->get_height_internal()));
+}
+
+void DisplayBuffer::init_tile_checksums_(uint8_t pixel_size) {
+  int tiles_x = (this->get_width_internal() + CHECKSUM_TILE_SIZE - 1) / CHECKSUM_TILE_SIZE;
+  int tiles_y = (this->get_height_internal() + CHECKSUM_TILE_SIZE - 1) / CHECKSUM_TILE_SIZE;
+  this->tile_checksums_.assign(tiles_x * tiles_y, 0);
+  this->tile_states_.assign(tiles_x * tiles_y, 0);
+  this->tile_pixel_size_ = pixel_size;
+}
+
+uint32_t DisplayBuffer::tile_checksum_(int tile_x, int tile_y) {
+  const int width = this->get_width_internal();
+  const int x = tile_x * CHECKSUM_TILE_SIZE;
+  const int y = tile_y * CHECKSUM_TILE_SIZE;
+  const size_t row_bytes = std::min<int>(CHECKSUM_TILE_SIZE, width - x) * this->tile_pixel_size_;
+  const int rows = std::min<int>(CHECKSUM_TILE_SIZE, this->get_height_internal() - y);
+  // FNV-1a over 32 bit words, followed by the remaining bytes of each row
+  uint32_t checksum = 2166136261UL;
+  for (int row = 0; row < rows; row++) {
+    const uint8_t *data = this->buffer_ + (size_t(y + row) * width + x) * this->tile_pixel_size_;
+    size_t i = 0;
+    for (; i + 4 <= row_bytes; i += 4) {
+      uint32_t word;
+      memcpy(&word, data + i, 4);
+      checksum = (checksum ^ word) * 16777619UL;
+    }
+    for (; i < row_bytes; i++)
+      checksum = (checksum ^ data[i]) * 16777619UL;
+  }
+  return checksum;
+}
+
+void DisplayBuffer::flush_changed_tiles_(const Rect &region, int tiles_x) {
+  const int tile_x1 = region.x / CHECKSUM_TILE_SIZE, tile_x2 = (region.x2() - 1) / CHECKSUM_TILE_SIZE;
+  const int tile_y1 = region.y / CHECKSUM_TILE_SIZE, tile_y2 = (region.y2() - 1) / CHECKSUM_TILE_SIZE;
+  for (int tile_y = tile_y1; tile_y <= tile_y2; tile_y++) {
+    // flush each run of changed tiles in this row of tiles, cut to the region
+    int run_start = -1;
+    for (int tile_x = tile_x1; tile_x <= tile_x2 + 1; tile_x++) {
+      bool changed = tile_x <= tile_x2 && (this->tile_states_[tile_y * tiles_x + tile_x] & TILE_CHANGED) != 0;
+      if (changed && run_start < 0)
+        run_start = tile_x;
+      if (changed || run_start < 0)
+        continue;
+      int16_t x1 = std::max<int>(region.x, run_start * CHECKSUM_TILE_SIZE);
+      int16_t y1 = std::max<int>(region.y, tile_y * CHECKSUM_TILE_SIZE);
+      int16_t x2 = std::min<int>(region.x2(), tile_x * CHECKSUM_TILE_SIZE);
+      int16_t y2 = std::min<int>(region.y2(), (tile_y + 1) * CHECKSUM_TILE_SIZE);
+      this->flush_region_(Rect(x1, y1, x2 - x1, y2 - y1));
+      run_start = -1;
+    }
+  }
+}
+
+void DisplayBuffer::mark_dirty_(const Rect &region) {
+  if (region.w <= 0 || region.h <= 0)
+    return;
+  for (uint8_t i = 0; i < this->dirty_region_count_; i++) {
+    if (regions_near(this->dirty_regions_[i], region, DIRTY_MERGE_DISTANCE)) {
+      this->dirty_regions_[i].extend(region);
+      this->last_dirty_region_ = i;
+      return;
+    }
+  }
+
+  if (this->dirty_region_count_ == MAX_DIRTY_REGIONS) {
+    // make room by merging the two regions that cover the least extra area together
+    uint8_t merge_a = 0, merge_b = 1;
+    int32_t least_waste = INT32_MAX;
+    for (uint8_t a = 0; a < this->dirty_region_count_; a++) {
+      for (uint8_t b = a + 1; b < this->dirty_region_count_; b++) {
+        Rect merged = this->dirty_regions_[a];
+        merged.extend(this->dirty_regions_[b]);
+        int32_t waste =
+            region_area(merged) - region_area(this->dirty_regions_[a]) - region_area(this->dirty_regions_[b]);
+        if (waste < least_waste) {
+          least_waste = waste;
+          merge_a = a;
+          merge_b = b;
+        }
+      }
+    }
+    this->dirty_regions_[merge_a].extend(this->dirty_regions_[merge_b]);
+    this->dirty_regions_[merge_b] = this->dirty_regions_[--this->dirty_region_count_];
+  }
+  this->last_dirty_region_ = this->dirty_region_count_;
+  this->dirty_regions_[this->dirty_region_count_++] = region;
+}
+
+void DisplayBuffer::flush_dirty_regions_() {
+  // regions that grew into each other would send the same pixels twice
+  bool merged;
+  do {
+    merged = false;
+    for (uint8_t a = 0; a < this->dirty_region_count_; a++) {
+      for (uint8_t b = a + 1; b < this->dirty_region_count_; b++) {
+        if (!regions_overlap(this->dirty_regions_[a], this->dirty_regions_[b]))
+          continue;
+        this->dirty_regions_[a].extend(this->dirty_regions_[b]);
+        this->dirty_regions_[b--] = this->dirty_regions_[--this->dirty_region_count_];
+        merged = true;
+      }
+    }
+  } while (merged);
+
+  if (this->tile_pixel_size_ == 0 || this->buffer_ == nullptr) {
+    for (uint8_t i = 0; i < this->dirty_region_count_; i++)
+      this->flush_region_(this->dirty_regions_[i]);
+  } else {
+    // find the tiles that changed since they were last flushed, before flushing anything
+    const int tiles_x = (this->get_width_internal() + CHECKSUM_TILE_SIZE - 1) / CHECKSUM_TILE_SIZE;
+    for (uint8_t i = 0; i < this->dirty_region_count_; i++) {
+      const Rect &region = this->dirty_regions_[i];
+      for (int tile_y = region.y / CHECKSUM_TILE_SIZE; tile_y <= (region.y2() - 1) / CHECKSUM_TILE_SIZE; tile_y++) {
+        for (int tile_x = region.x / CHECKSUM_TILE_SIZE; tile_x <= (region.x2() - 1) / CHECKSUM_TILE_SIZE; tile_x++) {
+          uint8_t &state = this->tile_states_[tile_y * tiles_x + tile_x];
+          if (state & TILE_CHECKED)
+            continue;
+          state |= TILE_CHECKED;
+          uint32_t checksum = this->tile_checksum_(tile_x, tile_y);
+          if ((state & TILE_CHECKSUM_VALID) && this->tile_checksums_[tile_y * tiles_x + tile_x] == checksum)
+            continue;
+          state |= TILE_CHECKSUM_VALID | TILE_CHANGED;
+          this->tile_checksums_[tile_y * tiles_x + tile_x] = checksum;
+        }
+      }
+    }
+    for (uint8_t i = 0; i < this->dirty_region_count_; i++)
+      this->flush_changed_tiles_(this->dirty_regions_[i], tiles_x);
+    for (auto &state : this->tile_states_)
+      state &= TILE_CHECKSUM_VALID;
+  }
+  this->dirty_region_count_ = 0;
+  this->last_dirty_region_ = 0;
 }
 
 int DisplayBuffer::get_width() {
@@ -68,5 +226,44 @@ void HOT DisplayBuffer::draw_pixel_at(int x, int y, Color color) {
   App.feed_wdt();
 }
 
+void HOT DisplayBuffer::draw_span_at(int x, int y, int width, const Color *colors) {
+  // clip the whole span first, like draw_pixel_at() does for each pixel
+  int x1 = std::max(x, 0);
+  int x2 = std::min(x + width, this->get_width());
+  if (y < 0 || y >= this->get_height())
+    return;
+  Rect clipping = this->get_clipping();
+  if (clipping.is_set()) {
+    if (y < clipping.y || y > clipping.y2())
+      return;
+    x1 = std::max<int>(x1, clipping.x);
+    x2 = std::min<int>(x2, clipping.x2() + 1);
+  }
+  if (x1 >= x2)
+    return;
+  colors += x1 - x;
+
+  const int width_internal = this->get_width_internal();
+  const int height_internal = this->get_height_internal();
+  switch (this->rotation_) {
+    case DISPLAY_ROTATION_0_DEGREES:
+      for (int i = x1; i < x2; i++)
+        this->draw_absolute_pixel_internal(i, y, *colors++);
+      break;
+    case DISPLAY_ROTATION_90_DEGREES:
+      for (int i = x1; i < x2; i++)
+        this->draw_absolute_pixel_internal(width_internal - y - 1, i, *colors++);
+      break;
+    case DISPLAY_ROTATION_180_DEGREES:
+      for (int i = x1; i < x2; i++)
+        this->draw_absolute_pixel_internal(width_internal - i - 1, height_internal - y - 1, *colors++);
+      break;
+    case DISPLAY_ROTATION_270_DEGREES:
+      for (int i = x1; i < x2; i++)
+        this->draw_absolute_pixel_internal(y, height_internal - i - 1, *colors++);
+      break;
+  }
+}
+
 }  // namespace display
 }  // namespace esphome
@@ -5,6 +5,7 @@
 
 #include "display.h"
 #include "display_color_utils.h"
+#include "rect.h"
 
 #include "esphome/core/component.h"
 #include "esphome/core/defines.h"
@@ -21,13 +22,54 @@ class DisplayBuffer : public Display {
 
   /// Set a single pixel at the specified coordinates to the given color.
   void draw_pixel_at(int x, int y, Color color) override;
+  void draw_span_at(int x, int y, int width, const Color *colors) override;
 
  protected:
+  /// Number of separate regions mark_dirty_() keeps track of, any further ones are merged into them.
+  static const uint8_t MAX_DIRTY_REGIONS = 8;
+  /// Width and height of the tiles compared by init_tile_checksums_().
+  static const uint8_t CHECKSUM_TILE_SIZE = 16;
+
   virtual void draw_absolute_pixel_internal(int x, int y, Color color) = 0;
 
   void init_internal_(uint32_t buffer_length);
 
+  /** Mark the pixel at \p x, \p y (without rotation) as changed since the last flush_dirty_regions_().
+   *
+   * Drivers call this for each pixel that actually changed in the buffer, so they only have to send those regions.
+   */
+  inline void mark_dirty_(int x, int y) ALWAYS_INLINE {
+    // consecutive pixels are mostly drawn next to each other
+    const Rect &last = this->dirty_regions_[this->last_dirty_region_];
+    if (this->dirty_region_count_ != 0 && x >= last.x && x < last.x2() && y >= last.y && y < last.y2())
+      return;
+    this->mark_dirty_(Rect(x, y, 1, 1));
+  }
+  /// Mark \p region (without rotation) as changed since the last flush_dirty_regions_().
+  void mark_dirty_(const Rect &region);
+  /** Only flush the parts of the changed regions that differ from what was flushed before.
+   *
+   * This keeps a checksum for every tile of the buffer, which has to store the pixels row by row with \p pixel_size
+   * bytes each. It catches pixels that were drawn again with the same color, like everything after an auto clear.
+   */
+  void init_tile_checksums_(uint8_t pixel_size);
+  /// Call flush_region_() for every changed region, and start over.
+  void flush_dirty_regions_();
+  /// Send \p region (without rotation) of the buffer to the display, for drivers using flush_dirty_regions_().
+  virtual void flush_region_(const Rect &region) {}
+
   uint8_t *buffer_{nullptr};
+  /// Changed regions, not overlapping after flush_dirty_regions_() merged them.
+  Rect dirty_regions_[MAX_DIRTY_REGIONS];
+  uint8_t dirty_region_count_{0};
+  uint8_t last_dirty_region_{0};
+  /// Checksum of every tile when it was last flushed, if init_tile_checksums_() was called.
+  std::vector<uint32_t> tile_checksums_;
+  std::vector<uint8_t> tile_states_;
+  uint8_t tile_pixel_size_{0};
+
+  uint32_t tile_checksum_(int tile_x, int tile_y);
+  void flush_changed_tiles_(const Rect &region, int tiles_x);
 };
 
 }  // namespace display
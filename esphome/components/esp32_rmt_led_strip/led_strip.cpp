@@ -6,6 +6,8 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 #include <esp_attr.h>
 
 namespace esphome {
@@ -17,19 +19,23 @@ static const uint32_t RMT_CLK_FREQ = 80000000;
 
 static const uint8_t RMT_CLK_DIV = 2;
 
+/// Time the data line has to stay low after a frame, before the next one.
+static const uint32_t RESET_TIME_US = 50;
+
+static const uint32_t TX_TIMEOUT_US = 1000000;
+
 void ESP32RMTLEDStripLightOutput::setup() {
   ESP_LOGCONFIG(TAG, "Setting up ESP32 LED Strip...");
 
   size_t buffer_size = this->get_buffer_size_();
 
-  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-  this->buf_ = allocator.allocate(buffer_size);
-  if (this->buf_ == nullptr) {
+  if (!this->frames_.allocate(buffer_size)) {
     ESP_LOGE(TAG, "Cannot allocate LED buffer!");
     this->mark_failed();
     return;
   }
 
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
   this->effect_data_ = allocator.allocate(this->num_leds_);
   if (this->effect_data_ == nullptr) {
     ESP_LOGE(TAG, "Cannot allocate effect data!");
@@ -37,8 +43,16 @@ void ESP32RMTLEDStripLightOutput::setup() {
     return;
   }
 
+#if !RMT_LED_STRIP_USE_TRANSLATOR
   ExternalRAMAllocator<rmt_item32_t> rmt_allocator(ExternalRAMAllocator<rmt_item32_t>::ALLOW_FAILURE);
   this->rmt_buf_ = rmt_allocator.allocate(buffer_size * 8);  // 8 bits per byte, 1 rmt_item32_t per bit
+#endif
+
+  // a frame takes the longest bit for every bit, followed by the reset time
+  uint32_t bit0 = this->bit0_.duration0 + this->bit0_.duration1;
+  uint32_t bit1 = this->bit1_.duration0 + this->bit1_.duration1;
+  uint32_t ticks_per_us = RMT_CLK_FREQ / RMT_CLK_DIV / 1000000;
+  this->frame_time_us_ = buffer_size * 8 * std::max(bit0, bit1) / ticks_per_us + RESET_TIME_US;
 
   rmt_config_t config;
   memset(&config, 0, sizeof(config));
@@ -63,8 +77,37 @@ void ESP32RMTLEDStripLightOutput::setup() {
     this->mark_failed();
     return;
   }
+#if RMT_LED_STRIP_USE_TRANSLATOR
+  rmt_translator_init(config.channel, ESP32RMTLEDStripLightOutput::translate_);
+  rmt_translator_set_context(config.channel, this);
+#endif
 }
 
+#if RMT_LED_STRIP_USE_TRANSLATOR
+void IRAM_ATTR ESP32RMTLEDStripLightOutput::translate_(const void *src, rmt_item32_t *dest, size_t src_size,
+                                                        size_t wanted_num, size_t *translated_size, size_t *item_num) {
+  ESP32RMTLEDStripLightOutput *strip;
+  rmt_translator_get_context(item_num, (void **) &strip);
+
+  size_t size = 0;
+  size_t num = 0;
+  const uint8_t *psrc = static_cast<const uint8_t *>(src);
+  rmt_item32_t *pdest = dest;
+  while (size < src_size && num < wanted_num) {
+    uint8_t b = *psrc;
+    for (int i = 0; i < 8; i++) {
+      pdest->val = b & (1 << (7 - i)) ? strip->bit1_.val : strip->bit0_.val;
+      pdest++;
+      num++;
+    }
+    size++;
+    psrc++;
+  }
+  *translated_size = size;
+  *item_num = num;
+}
+#endif
+
 void ESP32RMTLEDStripLightOutput::set_led_params(uint32_t bit0_high, uint32_t bit0_low, uint32_t bit1_high,
                                                  uint32_t bit1_low) {
   float ratio = (float) RMT_CLK_FREQ / RMT_CLK_DIV / 1e09f;
@@ -89,23 +132,31 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
     this->schedule_show();
     return;
   }
+  // the previous frame is sent in the background, wait for it (and the reset time after it) without blocking
+  if ((now - this->last_refresh_) < this->frame_time_us_ || rmt_wait_tx_done(this->channel_, 0) != ESP_OK) {
+    if (now - this->last_refresh_ > TX_TIMEOUT_US) {
+      ESP_LOGE(TAG, "RMT TX timeout");
+      this->status_set_warning();
+    }
+    this->schedule_show();
+    return;
+  }
   this->last_refresh_ = now;
   this->mark_shown_();
 
   ESP_LOGVV(TAG, "Writing RGB values to bus...");
 
-  if (rmt_wait_tx_done(this->channel_, pdMS_TO_TICKS(1000)) != ESP_OK) {
-    ESP_LOGE(TAG, "RMT TX timeout");
-    this->status_set_warning();
-    return;
-  }
-  delayMicroseconds(50);
+  this->frames_.swap();
 
-  size_t buffer_size = this->get_buffer_size_();
+#if RMT_LED_STRIP_USE_TRANSLATOR
+  // the RMT interrupt encodes the front frame while it's sent
+  esp_err_t error = rmt_write_sample(this->channel_, this->frames_.get_front(), this->frames_.get_size(), false);
+#else
+  size_t buffer_size = this->frames_.get_size();
 
   size_t size = 0;
   size_t len = 0;
-  uint8_t *psrc = this->buf_;
+  const uint8_t *psrc = this->frames_.get_front();
   rmt_item32_t *pdest = this->rmt_buf_;
   while (size < buffer_size) {
     uint8_t b = *psrc;
@@ -118,7 +169,9 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
     psrc++;
   }
 
-  if (rmt_write_items(this->channel_, this->rmt_buf_, len, false) != ESP_OK) {
+  esp_err_t error = rmt_write_items(this->channel_, this->rmt_buf_, len, false);
+#endif
+  if (error != ESP_OK) {
     ESP_LOGE(TAG, "RMT TX error");
     this->status_set_warning();
     return;
@@ -126,7 +179,7 @@ void ESP32RMTLEDStripLightOutput::write_state(light::LightState *state) {
   this->status_clear_warning();
 }
 
-light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index) const {
+bool ESP32RMTLEDStripLightOutput::get_pixel_layout_(PixelLayout *layout) const {
   int32_t r = 0, g = 0, b = 0;
   switch (this->rgb_order_) {
     case ORDER_RGB:
@@ -160,13 +213,29 @@ light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index
       b = 0;
       break;
   }
-  uint8_t multiplier = this->is_rgbw_ || this->is_wrgb_ ? 4 : 3;
-  uint8_t white = this->is_wrgb_ ? 0 : 3;
+  layout->buffer = this->frames_.get_back();
+  layout->stride = this->is_rgbw_ || this->is_wrgb_ ? 4 : 3;
+  layout->red = r + this->is_wrgb_;
+  layout->green = g + this->is_wrgb_;
+  layout->blue = b + this->is_wrgb_;
+  if (this->is_wrgb_) {
+    layout->white = 0;
+  } else if (this->is_rgbw_) {
+    layout->white = 3;
+  } else {
+    layout->white = -1;
+  }
+  return layout->buffer != nullptr;
+}
 
-  return {this->buf_ + (index * multiplier) + r + this->is_wrgb_,
-          this->buf_ + (index * multiplier) + g + this->is_wrgb_,
-          this->buf_ + (index * multiplier) + b + this->is_wrgb_,
-          this->is_rgbw_ || this->is_wrgb_ ? this->buf_ + (index * multiplier) + white : nullptr,
+light::ESPColorView ESP32RMTLEDStripLightOutput::get_view_internal(int32_t index) const {
+  PixelLayout layout;
+  this->get_pixel_layout_(&layout);
+  uint8_t *pixel = layout.buffer + index * layout.stride;
+  return {pixel + layout.red,
+          pixel + layout.green,
+          pixel + layout.blue,
+          layout.white >= 0 ? pixel + layout.white : nullptr,
           &this->effect_data_[index],
           &this->correction_};
 }
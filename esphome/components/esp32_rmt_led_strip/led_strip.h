@@ -2,6 +2,7 @@
 
 #ifdef USE_ESP32
 
+#include "esphome/components/light/addressable_frame_buffer.h"
 #include "esphome/components/light/addressable_light.h"
 #include "esphome/components/light/light_output.h"
 #include "esphome/core/color.h"
@@ -11,6 +12,10 @@
 #include <driver/gpio.h>
 #include <driver/rmt.h>
 #include <esp_err.h>
+#include <esp_idf_version.h>
+
+// With a translator the RMT interrupt encodes the frame while sending it, this needs its context (ESP-IDF 4.4+).
+#define RMT_LED_STRIP_USE_TRANSLATOR (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(4, 4, 0))
 
 namespace esphome {
 namespace esp32_rmt_led_strip {
@@ -63,12 +68,20 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
 
  protected:
   light::ESPColorView get_view_internal(int32_t index) const override;
+  bool get_pixel_layout_(PixelLayout *layout) const override;
 
   size_t get_buffer_size_() const { return this->num_leds_ * (this->is_rgbw_ || this->is_wrgb_ ? 4 : 3); }
 
-  uint8_t *buf_{nullptr};
+#if RMT_LED_STRIP_USE_TRANSLATOR
+  static void translate_(const void *src, rmt_item32_t *dest, size_t src_size, size_t wanted_num,
+                         size_t *translated_size, size_t *item_num);
+#endif
+
+  light::AddressableFrameBuffer frames_;
   uint8_t *effect_data_{nullptr};
+#if !RMT_LED_STRIP_USE_TRANSLATOR
   rmt_item32_t *rmt_buf_{nullptr};
+#endif
 
   uint8_t pin_;
   uint16_t num_leds_;
@@ -80,6 +93,8 @@ class ESP32RMTLEDStripLightOutput : public light::AddressableLight {
   rmt_channel_t channel_;
 
   uint32_t last_refresh_{0};
+  /// Time to send a frame, including the reset time after it.
+  uint32_t frame_time_us_{0};
   optional<uint32_t> max_refresh_rate_{};
 };
 
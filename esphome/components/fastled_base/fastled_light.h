@@ -228,6 +228,12 @@ class FastLEDLightOutput : public light::AddressableLight {
     return {&this->leds_[index].r,      &this->leds_[index].g, &this->leds_[index].b, nullptr,
             &this->effect_data_[index], &this->correction_};
   }
+  bool get_pixel_layout_(PixelLayout *layout) const override {
+    if (this->leds_ == nullptr)
+      return false;
+    *layout = {&this->leds_[0].r, sizeof(CRGB), 0, 1, 2, -1};
+    return true;
+  }
 
   CLEDController *controller_{nullptr};
   CRGB *leds_{nullptr};
@@ -51,6 +51,7 @@ GlyphData = font_ns.struct("GlyphData")
 
 CONF_BPP = "bpp"
 CONF_EXTRAS = "extras"
+CONF_CACHE_SIZE = "cache_size"
 CONF_FONTS = "fonts"
 
 
@@ -357,6 +358,7 @@ FONT_SCHEMA = cv.Schema(
                 }
             )
         ),
+        cv.Optional(CONF_CACHE_SIZE, default=0): cv.validate_bytes,
         cv.GenerateID(CONF_RAW_DATA_ID): cv.declare_id(cg.uint8),
         cv.GenerateID(CONF_RAW_GLYPH_ID): cv.declare_id(GlyphData),
     },
@@ -554,7 +556,7 @@ async def to_code(config):
 
     glyphs = cg.static_const_array(config[CONF_RAW_GLYPH_ID], glyph_initializer)
 
-    cg.new_Pvariable(
+    var = cg.new_Pvariable(
         config[CONF_ID],
         glyphs,
         len(glyph_initializer),
@@ -562,3 +564,5 @@ async def to_code(config):
         font_list[0].ascent + font_list[0].descent,
         bpp,
     )
+    if config[CONF_CACHE_SIZE] != 0:
+        cg.add(var.set_cache_size(config[CONF_CACHE_SIZE]))
@@ -1,5 +1,6 @@
 #include "font.h"
 
+#include "esphome/core/application.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 #include "esphome/core/color.h"
@@ -10,6 +11,9 @@ namespace font {
 
 static const char *const TAG = "font";
 
+/// Most pixels of a glyph row drawn at once.
+static const int MAX_SPAN_WIDTH = 64;
+
 const uint8_t *Glyph::get_char() const { return this->glyph_data_->a_char; }
 // Compare the char at the string position with this char.
 // Return true if this char is less than or equal the other.
@@ -100,13 +104,146 @@ void Font::measure(const char *str, int *width, int *x_offset, int *baseline, in
   *x_offset = min_x;
   *width = x - min_x;
 }
+const Color *Font::get_blended_colors_(Color color, Color background) {
+  const int bpp_max = (1 << this->bpp_) - 1;
+  if (!this->blended_colors_.empty() && this->blended_colors_[bpp_max] == color &&
+      this->blended_background_ == background)
+    return this->blended_colors_.data();
+  // blend the anti-aliased pixel values with the background once, rather than for every pixel
+  this->blended_colors_.resize(bpp_max + 1);
+  for (int value = 1; value < bpp_max; value++) {
+    const int on = value, off = bpp_max - value;
+    this->blended_colors_[value] = Color((color.r * on + background.r * off + bpp_max / 2) / bpp_max,
+                                         (color.g * on + background.g * off + bpp_max / 2) / bpp_max,
+                                         (color.b * on + background.b * off + bpp_max / 2) / bpp_max,
+                                         (color.w * on + background.w * off + bpp_max / 2) / bpp_max);
+  }
+  this->blended_colors_[bpp_max] = color;
+  this->blended_background_ = background;
+  return this->blended_colors_.data();
+}
+int Font::find_glyph_(const uint8_t *str, int *match_length) {
+  if (*str < this->ascii_glyphs_.size() && this->ascii_glyphs_[*str] != MULTI_CHAR_GLYPHS) {
+    *match_length = 1;
+    return this->ascii_glyphs_[*str];
+  }
+  return this->match_next_glyph(str, match_length);
+}
+void Font::set_cache_size(size_t size) {
+  this->cache_size_ = size;
+  this->cache_.clear();
+  this->cache_bytes_ = 0;
+  this->ascii_glyphs_.clear();
+  if (size == 0)
+    return;
+  // an ASCII character matches the glyph of itself, unless a longer glyph starts with it and may match instead
+  this->ascii_glyphs_.assign(128, -1);
+  for (size_t i = 0; i < this->glyphs_.size(); i++) {
+    const uint8_t *a_char = this->glyphs_[i].get_char();
+    if (a_char[0] == '\0' || a_char[0] >= 128)
+      continue;
+    if (a_char[1] != '\0') {
+      this->ascii_glyphs_[a_char[0]] = MULTI_CHAR_GLYPHS;
+    } else if (this->ascii_glyphs_[a_char[0]] != MULTI_CHAR_GLYPHS) {
+      this->ascii_glyphs_[a_char[0]] = i;
+    }
+  }
+  this->ascii_glyphs_['\0'] = -1;
+}
+
+/** Decode the visible pixels of a glyph, and pass each run of them within a row to \p on_span.
+ *
+ * The positions passed to on_span(x, y, width, colors) are relative to the position of the glyph.
+ */
+template<typename F> static void decode_glyph(const GlyphData *glyph, uint8_t bpp, const Color *blended, F &&on_span) {
+  const uint8_t bpp_max = (1 << bpp) - 1;
+  const uint8_t *data = glyph->data;
+  const int max_x = glyph->offset_x + glyph->width;
+  const int max_y = glyph->offset_y + glyph->height;
+  Color span[MAX_SPAN_WIDTH];
+
+  // the pixels are packed without padding, and bpp is a divisor of 8, so no pixel spans two bytes
+  uint8_t bits_left = 0;
+  uint8_t pixel_data = 0;
+  for (int glyph_y = glyph->offset_y; glyph_y != max_y; glyph_y++) {
+    int span_x = 0;
+    int span_width = 0;
+    for (int glyph_x = glyph->offset_x; glyph_x != max_x; glyph_x++) {
+      if (bits_left == 0) {
+        pixel_data = progmem_read_byte(data++);
+        bits_left = 8;
+      }
+      bits_left -= bpp;
+      uint8_t pixel = (pixel_data >> bits_left) & bpp_max;
+      if (pixel != 0) {
+        if (span_width == 0)
+          span_x = glyph_x;
+        span[span_width++] = blended[pixel];
+        if (span_width != MAX_SPAN_WIDTH)
+          continue;
+      }
+      if (span_width != 0) {
+        on_span(span_x, glyph_y, span_width, span);
+        span_width = 0;
+      }
+    }
+    if (span_width != 0)
+      on_span(span_x, glyph_y, span_width, span);
+  }
+}
+
+const Font::CachedGlyph *Font::get_cached_glyph_(int glyph_n, Color color, Color background, const Color *blended) {
+  // a 1 bpp glyph has no pixels blended with the background
+  if (this->bpp_ == 1)
+    background = Color::BLACK;
+  this->cache_clock_++;
+  for (auto &cached : this->cache_) {
+    if (cached.glyph == glyph_n && cached.color == color && cached.background == background) {
+      cached.last_used = this->cache_clock_;
+      this->cache_hits_++;
+      return &cached;
+    }
+  }
+  this->cache_misses_++;
+
+  CachedGlyph cached{};
+  cached.glyph = glyph_n;
+  cached.color = color;
+  cached.background = background;
+  cached.last_used = this->cache_clock_;
+  decode_glyph(this->glyphs_[glyph_n].get_glyph_data(), this->bpp_, blended,
+               [&cached](int x, int y, int width, const Color *colors) {
+                 cached.spans.push_back(CachedSpan{static_cast<int16_t>(x), static_cast<int16_t>(y),
+                                                   static_cast<uint16_t>(width)});
+                 cached.pixels.insert(cached.pixels.end(), colors, colors + width);
+               });
+  const size_t bytes = cached_glyph_bytes_(cached);
+  if (bytes > this->cache_size_)
+    return nullptr;
+  while (this->cache_bytes_ + bytes > this->cache_size_) {
+    auto oldest = this->cache_.begin();
+    for (auto it = this->cache_.begin(); it != this->cache_.end(); ++it) {
+      if (it->last_used < oldest->last_used)
+        oldest = it;
+    }
+    this->cache_bytes_ -= cached_glyph_bytes_(*oldest);
+    // the order of the entries doesn't matter, so move the last one into the gap
+    *oldest = std::move(this->cache_.back());
+    this->cache_.pop_back();
+  }
+  this->cache_bytes_ += bytes;
+  this->cache_.push_back(std::move(cached));
+  return &this->cache_.back();
+}
+
 void Font::print(int x_start, int y_start, display::Display *display, Color color, const char *text, Color background) {
+  const Color *blended = this->get_blended_colors_(color, background);
+
   int i = 0;
   int x_at = x_start;
-  int scan_x1, scan_y1, scan_width, scan_height;
   while (text[i] != '\0') {
     int match_length;
-    int glyph_n = this->match_next_glyph((const uint8_t *) text + i, &match_length);
+    int glyph_n = this->find_glyph_((const uint8_t *) text + i, &match_length);
     if (glyph_n < 0) {
       // Unknown char, skip
       ESP_LOGW(TAG, "Encountered character without representation in font: '%c'", text[i]);
@@ -121,42 +258,23 @@ void Font::print(int x_start, int y_start, display::Display *display, Color colo
     }
 
     const Glyph &glyph = this->get_glyphs()[glyph_n];
-    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
-
-    const uint8_t *data = glyph.glyph_data_->data;
-    const int max_x = x_at + scan_x1 + scan_width;
-    const int max_y = y_start + scan_y1 + scan_height;
-
-    uint8_t bitmask = 0;
-    uint8_t pixel_data = 0;
-    float bpp_max = (1 << this->bpp_) - 1;
-    for (int glyph_y = y_start + scan_y1; glyph_y != max_y; glyph_y++) {
-      for (int glyph_x = x_at + scan_x1; glyph_x != max_x; glyph_x++) {
-        uint8_t pixel = 0;
-        for (int bit_num = 0; bit_num != this->bpp_; bit_num++) {
-          if (bitmask == 0) {
-            pixel_data = progmem_read_byte(data++);
-            bitmask = 0x80;
-          }
-          pixel <<= 1;
-          if ((pixel_data & bitmask) != 0)
-            pixel |= 1;
-          bitmask >>= 1;
-        }
-        if (pixel == bpp_max) {
-          display->draw_pixel_at(glyph_x, glyph_y, color);
-        } else if (pixel != 0) {
-          float on = (float) pixel / bpp_max;
-          float off = 1.0 - on;
-          Color blended;
-          blended.r = color.r * on + background.r * off;
-          blended.g = color.r * on + background.g * off;
-          blended.b = color.r * on + background.b * off;
-          display->draw_pixel_at(glyph_x, glyph_y, blended);
-        }
+    const CachedGlyph *cached = nullptr;
+    if (this->cache_size_ != 0)
+      cached = this->get_cached_glyph_(glyph_n, color, background, blended);
+    if (cached != nullptr) {
+      const Color *pixels = cached->pixels.data();
+      for (const auto &span : cached->spans) {
+        display->draw_span_at(x_at + span.x, y_start + span.y, span.width, pixels);
+        pixels += span.width;
       }
+    } else {
+      // collect the visible pixels of each row, and draw each run of them at once
+      decode_glyph(glyph.glyph_data_, this->bpp_, blended, [&](int x, int y, int width, const Color *colors) {
+        display->draw_span_at(x_at + x, y_start + y, width, colors);
+      });
     }
     x_at += glyph.glyph_data_->width + glyph.glyph_data_->offset_x;
+    App.feed_wdt();
 
     i += match_length;
   }
@@ -59,11 +59,60 @@ class Font : public display::BaseFont {
 
   const std::vector<Glyph, ExternalRAMAllocator<Glyph>> &get_glyphs() const { return glyphs_; }
 
+  /** Keep the pixels of recently printed glyphs, up to \p size bytes, so printing them again in the same colors
+   * doesn't decode them again. The glyphs are evicted least recently used first, 0 disables the cache.
+   */
+  void set_cache_size(size_t size);
+  /// Number of glyphs printed from the cache, since boot.
+  uint32_t get_cache_hits() const { return this->cache_hits_; }
+  /// Number of glyphs that had to be decoded for the cache, since boot.
+  uint32_t get_cache_misses() const { return this->cache_misses_; }
+
  protected:
+  /// A run of visible pixels of a glyph, relative to the position of the glyph.
+  struct CachedSpan {
+    int16_t x;
+    int16_t y;
+    uint16_t width;
+  };
+  struct CachedGlyph {
+    int glyph;
+    Color color;
+    Color background;
+    /// Value of cache_clock_ when the glyph was last printed.
+    uint32_t last_used;
+    std::vector<CachedSpan, ExternalRAMAllocator<CachedSpan>> spans;
+    /// The colors of all spans, one after the other.
+    std::vector<Color, ExternalRAMAllocator<Color>> pixels;
+  };
+
+  /// Get the color to draw for each pixel value, for the last \p color and \p background.
+  const Color *get_blended_colors_(Color color, Color background);
+  /// Like match_next_glyph(), but looks up ASCII characters in a table when the cache is enabled.
+  int find_glyph_(const uint8_t *str, int *match_length);
+  /// Get the glyph from the cache, decoding it if it's missing. nullptr if it doesn't fit into the cache.
+  const CachedGlyph *get_cached_glyph_(int glyph_n, Color color, Color background, const Color *blended);
+  static size_t cached_glyph_bytes_(const CachedGlyph &cached) {
+    return sizeof(CachedGlyph) + cached.spans.size() * sizeof(CachedSpan) + cached.pixels.size() * sizeof(Color);
+  }
+
   std::vector<Glyph, ExternalRAMAllocator<Glyph>> glyphs_;
   int baseline_;
   int height_;
   uint8_t bpp_;  // bits per pixel
+  std::vector<Color> blended_colors_;
+  Color blended_background_;
+
+  size_t cache_size_{0};
+  size_t cache_bytes_{0};
+  uint32_t cache_clock_{0};
+  uint32_t cache_hits_{0};
+  uint32_t cache_misses_{0};
+  std::vector<CachedGlyph> cache_;
+  static const int16_t MULTI_CHAR_GLYPHS = -2;
+  /// Index of the glyph of each ASCII character, -1 for none, or MULTI_CHAR_GLYPHS if a glyph of several characters
+  /// starts with it and match_next_glyph() has to decide. Only filled when the cache is enabled.
+  std::vector<int16_t> ascii_glyphs_;
 };
 
 }  // namespace font
@@ -10,8 +10,6 @@
 namespace esphome {
 namespace i2s_audio {
 
-static const size_t BUFFER_SIZE = 512;
-
 static const char *const TAG = "i2s_audio.microphone";
 
 void I2SAudioMicrophone::setup() {
@@ -134,14 +132,6 @@ size_t I2SAudioMicrophone::read(int16_t *buf, size_t len) {
   }
 }
 
-void I2SAudioMicrophone::read_() {
-  std::vector<int16_t> samples;
-  samples.resize(BUFFER_SIZE);
-  size_t bytes_read = this->read(samples.data(), BUFFER_SIZE / sizeof(int16_t));
-  samples.resize(bytes_read / sizeof(int16_t));
-  this->data_callbacks_.call(samples);
-}
-
 void I2SAudioMicrophone::loop() {
   switch (this->state_) {
     case microphone::STATE_STOPPED:
@@ -150,12 +140,12 @@ void I2SAudioMicrophone::loop() {
       this->start_();
       break;
     case microphone::STATE_RUNNING:
-      if (this->data_callbacks_.size() > 0) {
-        this->read_();
-      }
+      this->run_pipeline_();
       break;
     case microphone::STATE_STOPPING:
-      this->stop_();
+      // the audio task may still be reading
+      if (this->stop_pipeline_())
+        this->stop_();
       break;
   }
 }
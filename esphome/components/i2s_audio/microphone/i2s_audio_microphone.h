@@ -22,6 +22,7 @@ class I2SAudioMicrophone : public I2SAudioIn, public microphone::Microphone, pub
   void set_pdm(bool pdm) { this->pdm_ = pdm; }
 
   size_t read(int16_t *buf, size_t len) override;
+  uint32_t get_sample_rate() const override { return this->sample_rate_; }
 
 #if SOC_I2S_SUPPORTS_ADC
   void set_adc_channel(adc1_channel_t channel) {
@@ -38,7 +39,6 @@ class I2SAudioMicrophone : public I2SAudioIn, public microphone::Microphone, pub
  protected:
   void start_();
   void stop_();
-  void read_();
 
   int8_t din_pin_{I2S_PIN_NO_CHANGE};
 #if SOC_I2S_SUPPORTS_ADC
@@ -38,16 +38,13 @@ void ILI9XXXDisplay::setup() {
 
   this->set_madctl();
   this->command(this->pre_invertcolors_ ? ILI9XXX_INVON : ILI9XXX_INVOFF);
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
 }
 
 void ILI9XXXDisplay::alloc_buffer_() {
   if (this->buffer_color_mode_ == BITS_16) {
     this->init_internal_(this->get_buffer_length_() * 2);
     if (this->buffer_ != nullptr) {
+      this->init_tile_checksums_(2);
       return;
     }
     this->buffer_color_mode_ = BITS_8;
@@ -55,7 +52,9 @@ void ILI9XXXDisplay::alloc_buffer_() {
   this->init_internal_(this->get_buffer_length_());
   if (this->buffer_ == nullptr) {
     this->mark_failed();
+    return;
   }
+  this->init_tile_checksums_(1);
 }
 
 void ILI9XXXDisplay::setup_pins_() {
@@ -112,35 +111,41 @@ void ILI9XXXDisplay::fill(Color color) {
   if (!this->check_buffer_())
     return;
   uint16_t new_color = 0;
-  this->x_low_ = 0;
-  this->y_low_ = 0;
-  this->x_high_ = this->get_width_internal() - 1;
-  this->y_high_ = this->get_height_internal() - 1;
+  size_t pixel_size = 1;
   switch (this->buffer_color_mode_) {
     case BITS_8_INDEXED:
       new_color = display::ColorUtil::color_to_index8_palette888(color, this->palette_);
       break;
     case BITS_16:
       new_color = display::ColorUtil::color_to_565(color);
-      {
-        const uint32_t buffer_length_16_bits = this->get_buffer_length_() * 2;
-        if (((uint8_t) (new_color >> 8)) == ((uint8_t) new_color)) {
-          // Upper and lower is equal can use quicker memset operation. Takes ~20ms.
-          memset(this->buffer_, (uint8_t) new_color, buffer_length_16_bits);
-        } else {
-          for (uint32_t i = 0; i < buffer_length_16_bits; i = i + 2) {
-            this->buffer_[i] = (uint8_t) (new_color >> 8);
-            this->buffer_[i + 1] = (uint8_t) new_color;
-          }
-        }
-      }
-      return;
+      pixel_size = 2;
       break;
     default:
       new_color = display::ColorUtil::color_to_332(color, display::ColorOrder::COLOR_ORDER_RGB);
       break;
   }
-  memset(this->buffer_, (uint8_t) new_color, this->get_buffer_length_());
+  // the first byte is the high byte of 16 bit colors
+  const uint8_t first = pixel_size == 2 ? new_color >> 8 : new_color;
+  const uint8_t second = new_color;
+  const size_t row_size = this->width_ * pixel_size;
+  // only mark the part of each row that actually changes, the rest doesn't have to be sent again
+  for (int y = 0; y < this->height_; y++) {
+    uint8_t *row = this->buffer_ + y * row_size;
+    int changed_low = this->width_, changed_high = -1;
+    for (int x = 0; x < this->width_; x++) {
+      uint8_t *pixel = row + x * pixel_size;
+      if (pixel[0] == first && (pixel_size == 1 || pixel[1] == second))
+        continue;
+      pixel[0] = first;
+      if (pixel_size == 2)
+        pixel[1] = second;
+      if (x < changed_low)
+        changed_low = x;
+      changed_high = x;
+    }
+    if (changed_high >= 0)
+      this->mark_dirty_(display::Rect(changed_low, y, changed_high - changed_low + 1, 1));
+  }
 }
 
 void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color) {
@@ -175,17 +180,8 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
     this->buffer_[pos] = new_color;
     updated = true;
   }
-  if (updated) {
-    // low and high watermark may speed up drawing from buffer
-    if (x < this->x_low_)
-      this->x_low_ = x;
-    if (y < this->y_low_)
-      this->y_low_ = y;
-    if (x > this->x_high_)
-      this->x_high_ = x;
-    if (y > this->y_high_)
-      this->y_high_ = y;
-  }
+  if (updated)
+    this->mark_dirty_(x, y);
 }
 
 void ILI9XXXDisplay::update() {
@@ -199,19 +195,19 @@ void ILI9XXXDisplay::update() {
     this->do_update_();
   } while (this->need_update_);
   this->prossing_update_ = false;
-  this->display_();
+  this->flush_dirty_regions_();
 }
 
-void ILI9XXXDisplay::display_() {
+void ILI9XXXDisplay::flush_region_(const display::Rect &region) {
   uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE];
-  // check if something was displayed
-  if ((this->x_high_ < this->x_low_) || (this->y_high_ < this->y_low_)) {
-    return;
-  }
+  uint16_t const x_low = region.x;
+  uint16_t const y_low = region.y;
+  uint16_t const x_high = region.x2() - 1;
+  uint16_t const y_high = region.y2() - 1;
 
   // we will only update the changed rows to the display
-  size_t const w = this->x_high_ - this->x_low_ + 1;
-  size_t const h = this->y_high_ - this->y_low_ + 1;
+  size_t const w = region.w;
+  size_t const h = region.h;
 
   size_t mhz = this->data_rate_ / 1000000;
   // estimate time for a single write
@@ -221,21 +217,20 @@ void ILI9XXXDisplay::display_() {
   ESP_LOGV(TAG,
            "Start display(xlow:%d, ylow:%d, xhigh:%d, yhigh:%d, width:%d, "
            "height:%zu, mode=%d, 18bit=%d, sw_time=%zuus, mw_time=%zuus)",
-           this->x_low_, this->y_low_, this->x_high_, this->y_high_, w, h, this->buffer_color_mode_,
-           this->is_18bitdisplay_, sw_time, mw_time);
+           x_low, y_low, x_high, y_high, w, h, this->buffer_color_mode_, this->is_18bitdisplay_, sw_time, mw_time);
   auto now = millis();
   if (this->buffer_color_mode_ == BITS_16 && !this->is_18bitdisplay_ && sw_time < mw_time) {
     // 16 bit mode maps directly to display format
     ESP_LOGV(TAG, "Doing single write of %zu bytes", this->width_ * h * 2);
-    set_addr_window_(0, this->y_low_, this->width_ - 1, this->y_high_);
-    this->write_array(this->buffer_ + this->y_low_ * this->width_ * 2, h * this->width_ * 2);
+    set_addr_window_(0, y_low, this->width_ - 1, y_high);
+    this->write_array(this->buffer_ + y_low * this->width_ * 2, h * this->width_ * 2);
   } else {
     ESP_LOGV(TAG, "Doing multiple write");
     size_t rem = h * w;  // remaining number of pixels to write
-    set_addr_window_(this->x_low_, this->y_low_, this->x_high_, this->y_high_);
+    set_addr_window_(x_low, y_low, x_high, y_high);
     size_t idx = 0;    // index into transfer_buffer
     size_t pixel = 0;  // pixel number offset
-    size_t pos = this->y_low_ * this->width_ + this->x_low_;
+    size_t pos = y_low * this->width_ + x_low;
     while (rem-- != 0) {
       uint16_t color_val;
       switch (this->buffer_color_mode_) {
@@ -277,11 +272,6 @@ void ILI9XXXDisplay::display_() {
   }
   this->end_data_();
   ESP_LOGV(TAG, "Data write took %dms", (unsigned) (millis() - now));
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
 }
 
 // note that this bypasses the buffer and writes directly to the display.
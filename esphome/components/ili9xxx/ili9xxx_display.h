@@ -98,7 +98,7 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   void setup_pins_();
 
   virtual void set_madctl();
-  void display_();
+  void flush_region_(const display::Rect &region) override;
   void init_lcd_();
   void set_addr_window_(uint16_t x, uint16_t y, uint16_t x2, uint16_t y2);
   void reset_();
@@ -108,10 +108,6 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   int16_t height_{0};  ///< Display height as modified by current rotation
   int16_t offset_x_{0};
   int16_t offset_y_{0};
-  uint16_t x_low_{0};
-  uint16_t y_low_{0};
-  uint16_t x_high_{0};
-  uint16_t y_high_{0};
   const uint8_t *palette_;
 
   ILI9XXXColorMode buffer_color_mode_{BITS_16};
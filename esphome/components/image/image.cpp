@@ -1,63 +1,76 @@
 #include "image.h"
 
+#include "esphome/core/application.h"
 #include "esphome/core/hal.h"
 
 namespace esphome {
 namespace image {
 
+/// Most pixels of an image row drawn at once.
+static const int MAX_SPAN_WIDTH = 64;
+
+/// Draw an image row by row, in runs of the pixels for which \p get_pixel returns true.
+template<typename F>
+static void draw_spans(display::Display *display, int x, int y, int width, int height, F &&get_pixel) {
+  Color span[MAX_SPAN_WIDTH];
+  for (int img_y = 0; img_y < height; img_y++) {
+    int span_x = 0;
+    int span_width = 0;
+    for (int img_x = 0; img_x < width; img_x++) {
+      if (get_pixel(img_x, img_y, &span[span_width])) {
+        if (span_width == 0)
+          span_x = img_x;
+        if (++span_width != MAX_SPAN_WIDTH)
+          continue;
+      }
+      if (span_width != 0) {
+        display->draw_span_at(x + span_x, y + img_y, span_width, span);
+        span_width = 0;
+      }
+    }
+    if (span_width != 0)
+      display->draw_span_at(x + span_x, y + img_y, span_width, span);
+    App.feed_wdt();
+  }
+}
+
 void Image::draw(int x, int y, display::Display *display, Color color_on, Color color_off) {
   switch (type_) {
-    case IMAGE_TYPE_BINARY: {
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          if (this->get_binary_pixel_(img_x, img_y)) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_on);
-          } else if (!this->transparent_) {
-            display->draw_pixel_at(x + img_x, y + img_y, color_off);
-          }
+    case IMAGE_TYPE_BINARY:
+      draw_spans(display, x, y, this->width_, this->height_, [&](int img_x, int img_y, Color *color) {
+        if (this->get_binary_pixel_(img_x, img_y)) {
+          *color = color_on;
+        } else if (!this->transparent_) {
+          *color = color_off;
+        } else {
+          return false;
         }
-      }
+        return true;
+      });
       break;
-    }
     case IMAGE_TYPE_GRAYSCALE:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_grayscale_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
+      draw_spans(display, x, y, this->width_, this->height_, [&](int img_x, int img_y, Color *color) {
+        *color = this->get_grayscale_pixel_(img_x, img_y);
+        return color->w >= 0x80;
+      });
       break;
     case IMAGE_TYPE_RGB565:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgb565_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
+      draw_spans(display, x, y, this->width_, this->height_, [&](int img_x, int img_y, Color *color) {
+        *color = this->get_rgb565_pixel_(img_x, img_y);
+        return color->w >= 0x80;
+      });
       break;
     case IMAGE_TYPE_RGB24:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgb24_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
+      draw_spans(display, x, y, this->width_, this->height_, [&](int img_x, int img_y, Color *color) {
+        *color = this->get_rgb24_pixel_(img_x, img_y);
+        return color->w >= 0x80;
+      });
       break;
     case IMAGE_TYPE_RGBA:
-      for (int img_x = 0; img_x < width_; img_x++) {
-        for (int img_y = 0; img_y < height_; img_y++) {
-          auto color = this->get_rgba_pixel_(img_x, img_y);
-          if (color.w >= 0x80) {
-            display->draw_pixel_at(x + img_x, y + img_y, color);
-          }
-        }
-      }
+      draw_spans(display, x, y, this->width_, this->height_, [&](int img_x, int img_y, Color *color) {
+        *color = this->get_rgba_pixel_(img_x, img_y);
+        return color->w >= 0x80;
+      });
       break;
   }
 }
@@ -19,6 +19,12 @@ static const char *const TAG = "json";
 static std::vector<char> global_json_build_buffer;  // NOLINT
 
 std::string build_json(const json_build_t &f) {
+  std::string output;
+  build_json(f, output);
+  return output;
+}
+
+void build_json(const json_build_t &f, std::string &output) {
   // Here we are allocating up to 5kb of memory,
   // with the heap size minus 2kb to be safe if less than 5kb
   // as we can not have a true dynamic sized document.
@@ -41,7 +47,8 @@ std::string build_json(const json_build_t &f) {
       ESP_LOGE(TAG,
                "Could not allocate memory for JSON document! Requested %u bytes, largest free heap block: %u bytes",
                request_size, free_heap);
-      return "{}";
+      output += "{}";
+      return;
     }
     JsonObject root = json_document.to<JsonObject>();
     f(root);
@@ -49,17 +56,44 @@ std::string build_json(const json_build_t &f) {
       if (request_size == free_heap) {
         ESP_LOGE(TAG, "Could not allocate memory for JSON document! Overflowed largest free heap block: %u bytes",
                  free_heap);
-        return "{}";
+        output += "{}";
+        return;
       }
       request_size = std::min(request_size * 2, free_heap);
       continue;
     }
     json_document.shrinkToFit();
     ESP_LOGV(TAG, "Size after shrink %u bytes", json_document.capacity());
-    std::string output;
     serializeJson(json_document, output);
-    return output;
+    return;
+  }
+}
+
+std::string build_json(const json_write_t &f) {
+  std::string output;
+  // most state messages fit, so this is usually the only allocation
+  output.reserve(128);
+  build_json(f, output);
+  return output;
+}
+
+void build_json(const json_write_t &f, std::string &output) {
+  JsonWriter writer(output);
+  writer.begin_object();
+  f(writer);
+  writer.end_object();
+}
+
+size_t build_json(char *buffer, size_t size, const json_write_t &f) {
+  JsonWriter writer(buffer, size);
+  writer.begin_object();
+  f(writer);
+  writer.end_object();
+  if (writer.overflowed()) {
+    ESP_LOGE(TAG, "JSON output doesn't fit into %zu bytes", size);
+    return 0;
   }
+  return writer.size();
 }
 
 void parse_json(const std::string &data, const json_parse_t &f) {
@@ -4,6 +4,8 @@
 
 #include "esphome/core/helpers.h"
 
+#include "json_writer.h"
+
 #define ARDUINOJSON_ENABLE_STD_STRING 1  // NOLINT
 
 #define ARDUINOJSON_USE_LONG_LONG 1  // NOLINT
@@ -19,8 +21,27 @@ using json_parse_t = std::function<void(JsonObject)>;
 /// Callback function typedef for building JsonObjects.
 using json_build_t = std::function<void(JsonObject)>;
 
+/// Callback function typedef for writing JSON objects with a JsonWriter.
+using json_write_t = std::function<void(JsonWriter &)>;
+
 /// Build a JSON string with the provided json build function.
 std::string build_json(const json_build_t &f);
+/// Build a JSON string with the provided json build function and append it to \p output.
+void build_json(const json_build_t &f, std::string &output);
+
+/** Build a JSON object string by streaming it out with the provided json write function.
+ *
+ * Unlike the JsonObject variant this doesn't allocate a document first, the output string is the only allocation.
+ */
+std::string build_json(const json_write_t &f);
+/// Write a JSON object with the provided json write function and append it to \p output.
+void build_json(const json_write_t &f, std::string &output);
+
+/** Write a JSON object with the provided json write function into the fixed \p buffer of \p size bytes.
+ *
+ * @return The length of the null terminated output, or 0 if it didn't fit.
+ */
+size_t build_json(char *buffer, size_t size, const json_write_t &f);
 
 /// Parse a JSON string and run the provided json parse function if it's valid.
 void parse_json(const std::string &data, const json_parse_t &f);
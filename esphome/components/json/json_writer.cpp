@@ -0,0 +1,181 @@
+#include "json_writer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "esphome/core/string_ref.h"
+
+namespace esphome {
+namespace json {
+
+JsonWriter::JsonWriter(char *buffer, size_t size) : buffer_(buffer), capacity_(size) {
+  if (size == 0) {
+    this->overflowed_ = true;
+  } else {
+    buffer[0] = '\0';
+  }
+}
+
+void JsonWriter::write_(const char *data, size_t len) {
+  if (this->string_ != nullptr) {
+    this->string_->append(data, len);
+    return;
+  }
+  if (this->overflowed_)
+    return;
+  // keep one byte for the null terminator
+  size_t available = this->capacity_ - this->size_ - 1;
+  if (len > available) {
+    len = available;
+    this->overflowed_ = true;
+  }
+  memcpy(this->buffer_ + this->size_, data, len);
+  this->size_ += len;
+  this->buffer_[this->size_] = '\0';
+}
+
+void JsonWriter::separate_() {
+  if (!this->first_)
+    this->write_(',');
+}
+
+void JsonWriter::begin_object() {
+  this->separate_();
+  this->write_('{');
+  this->first_ = true;
+}
+void JsonWriter::end_object() {
+  this->write_('}');
+  this->first_ = false;
+}
+void JsonWriter::begin_array() {
+  this->separate_();
+  this->write_('[');
+  this->first_ = true;
+}
+void JsonWriter::end_array() {
+  this->write_(']');
+  this->first_ = false;
+}
+
+void JsonWriter::key(const char *key) {
+  this->write_string_(key, strlen(key));
+  this->write_(':');
+  this->first_ = true;
+}
+
+void JsonWriter::value(const char *value) {
+  if (value == nullptr) {
+    this->null_value();
+    return;
+  }
+  this->write_string_(value, strlen(value));
+}
+
+void JsonWriter::value(const StringRef &value) { this->write_string_(value.c_str(), value.size()); }
+
+void JsonWriter::value(float value) {
+  if (!std::isfinite(value)) {
+    this->null_value();
+    return;
+  }
+  // use the shortest representation that still parses back to the same float
+  char buf[24];
+  snprintf(buf, sizeof(buf), "%.7g", value);
+  if (strtof(buf, nullptr) != value)
+    snprintf(buf, sizeof(buf), "%.9g", value);
+  this->write_value_(buf);
+}
+
+void JsonWriter::value(double value) {
+  if (!std::isfinite(value)) {
+    this->null_value();
+    return;
+  }
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.15g", value);
+  if (strtod(buf, nullptr) != value)
+    snprintf(buf, sizeof(buf), "%.17g", value);
+  this->write_value_(buf);
+}
+
+void JsonWriter::value(int64_t value) {
+  if (value >= 0) {
+    this->value(static_cast<uint64_t>(value));
+    return;
+  }
+  this->separate_();
+  this->write_('-');
+  this->first_ = true;
+  // negate in unsigned arithmetic, so that INT64_MIN doesn't overflow
+  this->value(~static_cast<uint64_t>(value) + 1);
+}
+
+void JsonWriter::value(uint64_t value) {
+  char buf[20];
+  char *start = buf + sizeof(buf);
+  do {
+    *--start = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  this->separate_();
+  this->write_(start, buf + sizeof(buf) - start);
+  this->first_ = false;
+}
+
+void JsonWriter::write_value_(const char *raw) {
+  this->separate_();
+  this->write_(raw, strlen(raw));
+  this->first_ = false;
+}
+
+void JsonWriter::write_string_(const char *value, size_t len) {
+  static const char *const HEX_DIGITS = "0123456789abcdef";
+  this->separate_();
+  this->write_('"');
+  // write runs of characters that need no escaping in one go
+  size_t start = 0;
+  for (size_t i = 0; i < len; i++) {
+    auto c = static_cast<uint8_t>(value[i]);
+    if (c >= 0x20 && c != '"' && c != '\\')
+      continue;
+    this->write_(value + start, i - start);
+    start = i + 1;
+    switch (c) {
+      case '"':
+        this->write_("\\\"", 2);
+        break;
+      case '\\':
+        this->write_("\\\\", 2);
+        break;
+      case '\b':
+        this->write_("\\b", 2);
+        break;
+      case '\f':
+        this->write_("\\f", 2);
+        break;
+      case '\n':
+        this->write_("\\n", 2);
+        break;
+      case '\r':
+        this->write_("\\r", 2);
+        break;
+      case '\t':
+        this->write_("\\t", 2);
+        break;
+      default: {
+        char escaped[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0xF]};
+        this->write_(escaped, sizeof(escaped));
+        break;
+      }
+    }
+  }
+  this->write_(value + start, len - start);
+  this->write_('"');
+  this->first_ = false;
+}
+
+}  // namespace json
+}  // namespace esphome
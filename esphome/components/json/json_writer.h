@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace esphome {
+
+class StringRef;
+
+namespace json {
+
+/** Streaming JSON writer that serializes straight into its output, without building a document first.
+ *
+ * The output is either a std::string that grows as needed, or a caller-provided fixed buffer that is always kept
+ * null terminated; writes that don't fit set overflowed(). Members are written in the order they are added, and
+ * unlike ArduinoJson adding the same key twice writes it twice. Members of the outermost object can be added with
+ * the same syntax as ArduinoJson, `root["key"] = value;`.
+ *
+ * Floats are written in their shortest form that parses back to the same value, NaN and infinity as null.
+ */
+class JsonWriter {
+ public:
+  /// Proxy returned by operator[], writes the member once it is assigned.
+  class Member {
+   public:
+    Member(JsonWriter *writer, const char *key) : writer_(writer), key_(key) {}
+    template<typename T> Member &operator=(const T &value) {
+      this->writer_->key(this->key_);
+      this->writer_->value(value);
+      return *this;
+    }
+
+   protected:
+    JsonWriter *writer_;
+    const char *key_;
+  };
+
+  /// Append to \p output.
+  explicit JsonWriter(std::string &output) : string_(&output) {}
+  /// Write to the fixed \p buffer of \p size bytes, including the null terminator.
+  JsonWriter(char *buffer, size_t size);
+
+  void begin_object();
+  void end_object();
+  void begin_array();
+  void end_array();
+  /// Write the key of the next object member.
+  void key(const char *key);
+  void key(const std::string &key) { this->key(key.c_str()); }
+
+  void value(const char *value);
+  void value(const std::string &value) { this->write_string_(value.data(), value.size()); }
+  void value(const StringRef &value);
+  void value(bool value) { this->write_value_(value ? "true" : "false"); }
+  void value(float value);
+  void value(double value);
+  void value(int64_t value);
+  void value(uint64_t value);
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type value(T v) {
+    this->value(static_cast<int64_t>(v));
+  }
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type value(T v) {
+    this->value(static_cast<uint64_t>(v));
+  }
+  template<typename T> typename std::enable_if<std::is_enum<T>::value>::type value(T v) {
+    this->value(static_cast<typename std::underlying_type<T>::type>(v));
+  }
+  void null_value() { this->write_value_("null"); }
+
+  Member operator[](const char *key) { return Member(this, key); }
+
+  /// Whether the fixed buffer was too small, the output is then truncated.
+  bool overflowed() const { return this->overflowed_; }
+  /// Number of bytes written to the fixed buffer, excluding the null terminator.
+  size_t size() const { return this->size_; }
+
+ protected:
+  void write_(const char *data, size_t len);
+  void write_(char c) { this->write_(&c, 1); }
+  /// Write a separator if this is not the first value in the current object or array.
+  void separate_();
+  void write_value_(const char *raw);
+  void write_string_(const char *value, size_t len);
+
+  std::string *string_{nullptr};
+  char *buffer_{nullptr};
+  size_t capacity_{0};
+  size_t size_{0};
+  bool overflowed_{false};
+  /// Whether the next value is the first one in its object or array, or directly follows a key.
+  bool first_{true};
+};
+
+}  // namespace json
+}  // namespace esphome
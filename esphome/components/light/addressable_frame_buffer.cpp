@@ -0,0 +1,28 @@
+#include "addressable_frame_buffer.h"
+#include "esphome/core/helpers.h"
+
+#include <cstring>
+#include <utility>
+
+namespace esphome {
+namespace light {
+
+bool AddressableFrameBuffer::allocate(size_t size) {
+  ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+  uint8_t *frames = allocator.allocate(size * 2);
+  if (frames == nullptr)
+    return false;
+  memset(frames, 0, size * 2);
+  this->back_ = frames;
+  this->front_ = frames + size;
+  this->size_ = size;
+  return true;
+}
+
+void AddressableFrameBuffer::swap() {
+  std::swap(this->back_, this->front_);
+  memcpy(this->back_, this->front_, this->size_);
+}
+
+}  // namespace light
+}  // namespace esphome
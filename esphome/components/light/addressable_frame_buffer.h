@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace light {
+
+/** Front and back frame of an addressable light driver, so that a frame can be sent while the next one is rendered.
+ *
+ * The views and effects of the light work on the back frame. To show it, the driver calls swap() once the previous
+ * frame has been sent: the back frame becomes the front frame, which the driver then sends in the background, and
+ * rendering continues on a copy of it, as effects build on the pixels they wrote before.
+ */
+class AddressableFrameBuffer {
+ public:
+  /// Allocate both frames with \p size bytes each, in external RAM if possible. Return false if that failed.
+  bool allocate(size_t size);
+
+  /// The frame to render into.
+  uint8_t *get_back() const { return this->back_; }
+  /// The frame that is being sent.
+  const uint8_t *get_front() const { return this->front_; }
+  size_t get_size() const { return this->size_; }
+
+  /// Make the back frame the front frame.
+  void swap();
+
+ protected:
+  uint8_t *back_{nullptr};
+  uint8_t *front_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace light
+}  // namespace esphome
@@ -1,6 +1,8 @@
 #include "addressable_light.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace light {
 
@@ -27,6 +29,79 @@ std::unique_ptr<LightTransformer> AddressableLight::create_default_transition()
   return make_unique<AddressableLightTransformer>(*this);
 }
 
+// On shorter strips it's cheaper to correct each pixel than to recalculate the lookup table on brightness changes.
+static const int32_t CORRECTION_TABLE_MIN_PIXELS = 64;
+
+void AddressableLight::set_pixels(int32_t index, const Color *colors, int32_t count) {
+  if (index < 0 || count <= 0 || index >= this->size())
+    return;
+  count = std::min(count, this->size() - index);
+
+  PixelLayout layout;
+  if (!this->get_pixel_layout_(&layout)) {
+    for (int32_t i = 0; i < count; i++)
+      this->get_view_internal(index + i).set(colors[i]);
+    return;
+  }
+
+  uint8_t *pixel = layout.buffer + index * layout.stride;
+  if (this->size() < CORRECTION_TABLE_MIN_PIXELS) {
+    for (int32_t i = 0; i < count; i++, pixel += layout.stride) {
+      Color corrected = this->correction_.color_correct(colors[i]);
+      pixel[layout.red] = corrected.red;
+      pixel[layout.green] = corrected.green;
+      pixel[layout.blue] = corrected.blue;
+      if (layout.white >= 0)
+        pixel[layout.white] = corrected.white;
+    }
+    return;
+  }
+
+  const uint8_t *table = this->correction_.get_correction_table();
+  const uint8_t *red = table, *green = table + 256, *blue = table + 512, *white = table + 768;
+  for (int32_t i = 0; i < count; i++, pixel += layout.stride) {
+    // load each color as one word and pick the channels from it
+    uint32_t color = colors[i].raw_32;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    pixel[layout.red] = red[color & 0xFF];
+    pixel[layout.green] = green[(color >> 8) & 0xFF];
+    pixel[layout.blue] = blue[(color >> 16) & 0xFF];
+    if (layout.white >= 0)
+      pixel[layout.white] = white[color >> 24];
+#else
+    pixel[layout.red] = red[color >> 24];
+    pixel[layout.green] = green[(color >> 16) & 0xFF];
+    pixel[layout.blue] = blue[(color >> 8) & 0xFF];
+    if (layout.white >= 0)
+      pixel[layout.white] = white[color & 0xFF];
+#endif
+  }
+}
+
+void AddressableLight::fill(int32_t index, int32_t count, const Color &color) {
+  if (index < 0 || count <= 0 || index >= this->size())
+    return;
+  count = std::min(count, this->size() - index);
+
+  PixelLayout layout;
+  if (!this->get_pixel_layout_(&layout)) {
+    for (int32_t i = 0; i < count; i++)
+      this->get_view_internal(index + i).set(color);
+    return;
+  }
+
+  // all pixels get the same value, so it only has to be corrected once
+  Color corrected = this->correction_.color_correct(color);
+  uint8_t *pixel = layout.buffer + index * layout.stride;
+  for (int32_t i = 0; i < count; i++, pixel += layout.stride) {
+    pixel[layout.red] = corrected.red;
+    pixel[layout.green] = corrected.green;
+    pixel[layout.blue] = corrected.blue;
+    if (layout.white >= 0)
+      pixel[layout.white] = corrected.white;
+  }
+}
+
 Color color_from_light_color_values(LightColorValues val) {
   auto r = to_uint8_scale(val.get_color_brightness() * val.get_red());
   auto g = to_uint8_scale(val.get_color_brightness() * val.get_green());
@@ -40,6 +40,15 @@ class AddressableLight : public LightOutput, public Component {
     return ESPRangeView(this, from, to);
   }
   ESPRangeView all() { return ESPRangeView(this, 0, this->size()); }
+  /** Set the \p count pixels starting at \p index to \p colors.
+   *
+   * This is much faster than setting the pixels one by one through ESPColorView, as long strips are corrected with a
+   * lookup table and written straight to the buffer of drivers that provide get_pixel_layout_(). The white channel
+   * is written too, the effect data is left alone.
+   */
+  void set_pixels(int32_t index, const Color *colors, int32_t count);
+  /// Set the \p count pixels starting at \p index to \p color.
+  void fill(int32_t index, int32_t count, const Color &color);
   ESPRangeIterator begin() { return this->all().begin(); }
   ESPRangeIterator end() { return this->all().end(); }
   void shift_left(int32_t amnt) {
@@ -97,6 +106,20 @@ class AddressableLight : public LightOutput, public Component {
   }
   virtual ESPColorView get_view_internal(int32_t index) const = 0;
 
+  /// Where the channels of each pixel are in the buffer of the driver.
+  struct PixelLayout {
+    uint8_t *buffer;
+    /// Bytes from one pixel to the next.
+    uint8_t stride;
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+    /// Offset of the white channel, -1 if there is none.
+    int8_t white;
+  };
+  /// Describe the pixel buffer for set_pixels() and fill(), return false to let them go through ESPColorView.
+  virtual bool get_pixel_layout_(PixelLayout *layout) const { return false; }
+
   bool effect_active_{false};
   ESPColorCorrection correction_{};
 #ifdef USE_POWER_SUPPLY
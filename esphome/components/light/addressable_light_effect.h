@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -81,10 +82,16 @@ class AddressableRainbowLightEffect : public AddressableLightEffect {
     hsv.saturation = 240;
     uint16_t hue = (millis() * this->speed_) % 0xFFFF;
     const uint16_t add = 0xFFFF / this->width_;
-    for (auto var : it) {
-      hsv.hue = hue >> 8;
-      var = hsv;
-      hue += add;
+    // render a chunk at a time, so that it can be corrected and written in one go
+    Color colors[32];
+    for (int32_t i = 0; i < it.size(); i += 32) {
+      int32_t count = std::min<int32_t>(32, it.size() - i);
+      for (int32_t j = 0; j < count; j++) {
+        hsv.hue = hue >> 8;
+        colors[j] = hsv.to_rgb();
+        hue += add;
+      }
+      it.set_pixels(i, colors, count);
     }
     it.schedule_show();
   }
@@ -6,6 +6,7 @@ namespace esphome {
 namespace light {
 
 void ESPColorCorrection::calculate_gamma_table(float gamma) {
+  this->correction_table_valid_ = false;
   for (uint16_t i = 0; i < 256; i++) {
     // corrected = val ^ gamma
     auto corrected = to_uint8_scale(gamma_correct(i / 255.0f, gamma));
@@ -23,5 +24,21 @@ void ESPColorCorrection::calculate_gamma_table(float gamma) {
   }
 }
 
+const uint8_t *ESPColorCorrection::get_correction_table() {
+  if (this->correction_table_ == nullptr)
+    this->correction_table_ = std::unique_ptr<uint8_t[]>(new uint8_t[4 * 256]);  // NOLINT
+  if (!this->correction_table_valid_) {
+    for (uint8_t channel = 0; channel < 4; channel++) {
+      uint8_t *table = this->correction_table_.get() + channel * 256;
+      for (uint16_t i = 0; i < 256; i++) {
+        uint8_t res = esp_scale8(esp_scale8(i, this->max_brightness_.raw[channel]), this->local_brightness_);
+        table[i] = this->gamma_table_[res];
+      }
+    }
+    this->correction_table_valid_ = true;
+  }
+  return this->correction_table_.get();
+}
+
 }  // namespace light
 }  // namespace esphome
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include "esphome/core/color.h"
 
 namespace esphome {
@@ -8,9 +10,23 @@ namespace light {
 class ESPColorCorrection {
  public:
   ESPColorCorrection() : max_brightness_(255, 255, 255, 255) {}
-  void set_max_brightness(const Color &max_brightness) { this->max_brightness_ = max_brightness; }
-  void set_local_brightness(uint8_t local_brightness) { this->local_brightness_ = local_brightness; }
+  void set_max_brightness(const Color &max_brightness) {
+    this->max_brightness_ = max_brightness;
+    this->correction_table_valid_ = false;
+  }
+  void set_local_brightness(uint8_t local_brightness) {
+    if (local_brightness == this->local_brightness_)
+      return;
+    this->local_brightness_ = local_brightness;
+    this->correction_table_valid_ = false;
+  }
   void calculate_gamma_table(float gamma);
+  /** Get a table with the corrected value of every channel value, as computed by the color_correct_*() methods.
+   *
+   * The table holds 256 entries for red, then green, blue and white. It's allocated on first use and recalculated
+   * when the brightness or gamma change, which is worth it when correcting many colors at once.
+   */
+  const uint8_t *get_correction_table();
   inline Color color_correct(Color color) const ALWAYS_INLINE {
     // corrected = (uncorrected * max_brightness * local_brightness) ^ gamma
     return Color(this->color_correct_red(color.red), this->color_correct_green(color.green),
@@ -71,6 +87,8 @@ class ESPColorCorrection {
   uint8_t gamma_reverse_table_[256];
   Color max_brightness_;
   uint8_t local_brightness_{255};
+  std::unique_ptr<uint8_t[]> correction_table_;
+  bool correction_table_valid_{false};
 };
 
 }  // namespace light
@@ -17,11 +17,7 @@ ESPColorView ESPRangeView::operator[](int32_t index) const {
 ESPRangeIterator ESPRangeView::begin() { return {*this, this->begin_}; }
 ESPRangeIterator ESPRangeView::end() { return {*this, this->end_}; }
 
-void ESPRangeView::set(const Color &color) {
-  for (int32_t i = this->begin_; i < this->end_; i++) {
-    (*this->parent_)[i] = color;
-  }
-}
+void ESPRangeView::set(const Color &color) { this->parent_->fill(this->begin_, this->end_ - this->begin_, color); }
 
 void ESPRangeView::set_red(uint8_t red) {
   for (auto c : *this)
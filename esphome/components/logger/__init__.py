@@ -21,6 +21,7 @@ from esphome.const import (
     PLATFORM_RTL87XX,
     PLATFORM_ESP32,
     PLATFORM_ESP8266,
+    PLATFORM_HOST,
     PLATFORM_RP2040,
 )
 from esphome.core import CORE, EsphomeError, Lambda, coroutine_with_priority
@@ -166,6 +167,7 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_TASK_LOG_BUFFER_SIZE = "task_log_buffer_size"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -212,6 +214,9 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(
                 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True
             ): cv.All(cv.only_on_esp8266, cv.boolean),
+            cv.SplitDefault(CONF_TASK_LOG_BUFFER_SIZE, esp32=768, host=768): cv.All(
+                cv.only_on([PLATFORM_ESP32, PLATFORM_HOST]), cv.validate_bytes
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
@@ -233,6 +238,10 @@ async def to_code(config):
     for tag, level in config[CONF_LOGS].items():
         cg.add(log.set_log_level(tag, LOG_LEVELS[level]))
 
+    if task_log_buffer_size := config.get(CONF_TASK_LOG_BUFFER_SIZE):
+        cg.add_define("USE_LOGGER_TASK_LOG_BUFFER")
+        cg.add(log.init_task_log_buffer(task_log_buffer_size))
+
     level = config[CONF_LEVEL]
     cg.add_define("USE_LOGGER")
     this_severity = LOG_LEVEL_SEVERITY.index(level)
@@ -43,7 +43,17 @@ void Logger::write_header_(int level, const char *tag, int line) {
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
-  if (level > this->level_for(tag) || recursion_guard_)
+  if (level > this->level_for(tag))
+    return;
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  if (this->is_other_task_()) {
+    // don't touch the shared transmit buffer, the main loop forwards the message later
+    if (this->task_log_buffer_->push(level, tag, line, format, args))
+      App.wake_loop_any_context();
+    return;
+  }
+#endif
+  if (recursion_guard_)
     return;
 
   recursion_guard_ = true;
@@ -86,17 +96,61 @@ void Logger::log_vprintf_(int level, const char *tag, int line, const __FlashStr
 #endif
 
 int HOT Logger::level_for(const char *tag) {
-  // Uses std::vector<> for low memory footprint, though the vector
-  // could be sorted to minimize lookup times. This feature isn't used that
-  // much anyway so it doesn't matter too much.
+  // Uses std::vector<> for low memory footprint. The tag hashes are computed up front,
+  // so only a matching tag needs a string compare.
+  if (this->log_levels_.empty())
+    return ESPHOME_LOG_LEVEL;
+  uint32_t hash = fnv1_hash(tag);
   for (auto &it : this->log_levels_) {
-    if (it.tag == tag) {
+    if (it.hash == hash && it.tag == tag) {
       return it.level;
     }
   }
   return ESPHOME_LOG_LEVEL;
 }
 
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+void Logger::init_task_log_buffer(size_t size) {
+  // called while setting up, so from the main loop task
+#ifdef USE_ESP32
+  this->main_task_ = xTaskGetCurrentTaskHandle();
+#endif
+#ifdef USE_HOST
+  this->main_thread_ = pthread_self();
+#endif
+  this->task_log_buffer_ = make_unique<TaskLogBuffer>(size);
+}
+
+bool HOT Logger::is_other_task_() const {
+  if (this->task_log_buffer_ == nullptr)
+    return false;
+#ifdef USE_ESP32
+  return xTaskGetCurrentTaskHandle() != this->main_task_;
+#endif
+#ifdef USE_HOST
+  return !pthread_equal(pthread_self(), this->main_thread_);
+#endif
+}
+
+void Logger::process_task_log_buffer_() {
+  uint32_t dropped = this->task_log_buffer_->take_dropped();
+  if (dropped != 0)
+    ESP_LOGW(TAG, "Dropped %" PRIu32 " messages logged from other tasks, the task log buffer was full", dropped);
+
+  const TaskLogBuffer::Record *record;
+  while ((record = this->task_log_buffer_->front()) != nullptr) {
+    this->recursion_guard_ = true;
+    this->reset_buffer_();
+    this->write_header_(record->level, record->tag, record->line);
+    this->write_to_buffer_(record->text(), strlen(record->text()));
+    this->write_footer_();
+    this->log_message_(record->level, record->tag);
+    this->recursion_guard_ = false;
+    this->task_log_buffer_->pop();
+  }
+}
+#endif
+
 void HOT Logger::log_message_(int level, const char *tag, int offset) {
   // remove trailing newline
   if (this->tx_buffer_[this->tx_buffer_at_ - 1] == '\n') {
@@ -129,9 +183,13 @@ Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate
   this->tx_buffer_ = new char[this->tx_buffer_size_ + 1];  // NOLINT
 }
 
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_TASK_LOG_BUFFER)
 void Logger::loop() {
-#ifdef USE_ARDUINO
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  if (this->task_log_buffer_ != nullptr)
+    this->process_task_log_buffer_();
+#endif
+#if defined(USE_LOGGER_USB_CDC) && defined(USE_ARDUINO)
   if (this->uart_ != UART_SELECTION_USB_CDC) {
     return;
   }
@@ -145,11 +203,20 @@ void Logger::loop() {
   opened = !opened;
 #endif
 }
+uint32_t Logger::get_idle_loop_interval() {
+#if defined(USE_LOGGER_USB_CDC) && defined(USE_ARDUINO)
+  // whether the USB CDC port got opened can only be polled
+  if (this->uart_ == UART_SELECTION_USB_CDC)
+    return 0;
+#endif
+  // messages buffered from other tasks wake the loop
+  return UINT32_MAX;
+}
 #endif
 
 void Logger::set_baud_rate(uint32_t baud_rate) { this->baud_rate_ = baud_rate; }
 void Logger::set_log_level(const std::string &tag, int log_level) {
-  this->log_levels_.push_back(LogLevelOverride{tag, log_level});
+  this->log_levels_.push_back(LogLevelOverride{tag, fnv1_hash(tag), log_level});
 }
 
 #if defined(USE_ESP32) || defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_LIBRETINY)
@@ -7,6 +7,17 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+#include "task_log_buffer.h"
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+#ifdef USE_HOST
+#include <pthread.h>
+#endif
+#endif  // USE_LOGGER_TASK_LOG_BUFFER
+
 #ifdef USE_ARDUINO
 #if defined(USE_ESP8266) || defined(USE_ESP32)
 #include <HardwareSerial.h>
@@ -56,8 +67,13 @@ enum UARTSelection {
 class Logger : public Component {
  public:
   explicit Logger(uint32_t baud_rate, size_t tx_buffer_size);
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_TASK_LOG_BUFFER)
   void loop() override;
+  uint32_t get_idle_loop_interval() override;
+#endif
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  /// Buffer messages logged from tasks other than the main loop in a ring of \p size bytes.
+  void init_task_log_buffer(size_t size);
 #endif
   /// Manually set the baud rate for serial, set to 0 to disable.
   void set_baud_rate(uint32_t baud_rate);
@@ -100,6 +116,12 @@ class Logger : public Component {
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
   void write_msg_(const char *msg);
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  /// Whether the calling task is not the one running the main loop.
+  bool is_other_task_() const;
+  /// Forward the messages buffered by other tasks.
+  void process_task_log_buffer_();
+#endif
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
   inline int buffer_remaining_capacity_() const { return this->tx_buffer_size_ - this->tx_buffer_at_; }
@@ -161,12 +183,23 @@ class Logger : public Component {
 #endif
   struct LogLevelOverride {
     std::string tag;
+    /// fnv1_hash() of the tag, compared first so that other tags don't need a string compare.
+    uint32_t hash;
     int level;
   };
   std::vector<LogLevelOverride> log_levels_;
   CallbackManager<void(int, const char *, const char *)> log_callback_{};
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+  std::unique_ptr<TaskLogBuffer> task_log_buffer_;
+#ifdef USE_ESP32
+  TaskHandle_t main_task_{nullptr};
+#endif
+#ifdef USE_HOST
+  pthread_t main_thread_{};
+#endif
+#endif
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -0,0 +1,86 @@
+#include "task_log_buffer.h"
+
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace logger {
+
+TaskLogBuffer::TaskLogBuffer(size_t size) {
+  // round the number of units up to a power of two, so positions can wrap around freely
+  uint32_t units = 2;
+  while (units * sizeof(Record) < size)
+    units <<= 1;
+  this->records_ = std::unique_ptr<Record[]>(new Record[units]);  // NOLINT
+  memset(static_cast<void *>(this->records_.get()), 0, units * sizeof(Record));
+  this->mask_ = units - 1;
+}
+
+bool TaskLogBuffer::push(int level, const char *tag, int line, const char *format, va_list args) {
+  // measure the message first, so it can be formatted in place without a temporary buffer
+  va_list args_copy;
+  va_copy(args_copy, args);
+  int length = vsnprintf(nullptr, 0, format, args_copy);
+  va_end(args_copy);
+  if (length < 0)
+    return false;
+
+  const uint32_t capacity = this->mask_ + 1;
+  const uint32_t units = 1 + (length + sizeof(Record)) / sizeof(Record);  // header, text and null terminator
+  if (units > capacity || units > UINT16_MAX) {
+    this->dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  uint32_t head = this->head_.load(std::memory_order_relaxed);
+  uint32_t padding;
+  do {
+    uint32_t offset = head & this->mask_;
+    padding = offset + units > capacity ? capacity - offset : 0;
+    if (head + padding + units - this->tail_.load(std::memory_order_acquire) > capacity) {
+      this->dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while (!this->head_.compare_exchange_weak(head, head + padding + units, std::memory_order_acq_rel,
+                                              std::memory_order_relaxed));
+
+  if (padding != 0) {
+    Record *pad = this->at_(head);
+    pad->level = PADDING_LEVEL;
+    pad->units.store(padding, std::memory_order_release);
+  }
+  Record *record = this->at_(head + padding);
+  record->level = level;
+  record->line = line;
+  record->tag = tag;
+  vsnprintf(const_cast<char *>(record->text()), length + 1, format, args);
+  record->units.store(units, std::memory_order_release);
+  return true;
+}
+
+const TaskLogBuffer::Record *TaskLogBuffer::front() {
+  while (true) {
+    Record *record = this->at_(this->tail_.load(std::memory_order_relaxed));
+    if (record->units.load(std::memory_order_acquire) == 0)
+      return nullptr;
+    if (record->level != PADDING_LEVEL)
+      return record;
+    this->pop();
+  }
+}
+
+void TaskLogBuffer::pop() {
+  uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+  Record *record = this->at_(tail);
+  uint32_t units = record->units.load(std::memory_order_relaxed);
+  // clear the whole record, a later record header may start anywhere inside it
+  memset(static_cast<void *>(record), 0, units * sizeof(Record));
+  this->tail_.store(tail + units, std::memory_order_release);
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_TASK_LOG_BUFFER
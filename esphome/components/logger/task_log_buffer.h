@@ -0,0 +1,67 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_TASK_LOG_BUFFER
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace esphome {
+namespace logger {
+
+/** Lock-free multi-producer, single-consumer ring of log records.
+ *
+ * Tasks other than the main loop format their messages straight into this ring instead of the logger's shared
+ * transmit buffer, and the main loop forwards them to the UART and the log listeners later on. Producers reserve
+ * space by advancing the head with a compare-and-swap, so a task never blocks on another one; when the ring is full
+ * the message is dropped and counted instead.
+ *
+ * Space is handed out in units of one record header. A record that does not fit before the end of the ring is
+ * preceded by a padding record covering the rest of it, so message text is always contiguous.
+ */
+class TaskLogBuffer {
+ public:
+  struct Record {
+    /// Record length in units, written last by the producer. Zero while the record is still being written.
+    std::atomic<uint16_t> units;
+    uint8_t level;
+    uint16_t line;
+    const char *tag;
+
+    const char *text() const { return reinterpret_cast<const char *>(this + 1); }
+  };
+
+  explicit TaskLogBuffer(size_t size);
+
+  /// Format a message into the ring. Safe to call from any task. Returns false if the message was dropped.
+  bool push(int level, const char *tag, int line, const char *format, va_list args);
+
+  /// Get the oldest complete record, or nullptr if there is none. Main loop only.
+  const Record *front();
+  /// Release the record returned by front(). Main loop only.
+  void pop();
+
+  /// Get and reset the number of messages dropped because the ring was full.
+  uint32_t take_dropped() { return this->dropped_.exchange(0, std::memory_order_relaxed); }
+
+ protected:
+  Record *at_(uint32_t position) { return &this->records_[position & this->mask_]; }
+
+  static constexpr uint8_t PADDING_LEVEL = 0xFF;
+
+  std::unique_ptr<Record[]> records_;
+  uint32_t mask_;
+  /// Positions are counted in units and only ever increase; they are mapped to the ring with mask_.
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_TASK_LOG_BUFFER
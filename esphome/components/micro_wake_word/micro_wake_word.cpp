@@ -30,7 +30,7 @@ static const char *const TAG = "micro_wake_word";
 static const size_t SAMPLE_RATE_HZ = 16000;  // 16 kHz
 static const size_t BUFFER_LENGTH = 500;     // 0.5 seconds
 static const size_t BUFFER_SIZE = SAMPLE_RATE_HZ / 1000 * BUFFER_LENGTH;
-static const size_t INPUT_BUFFER_SIZE = 32 * SAMPLE_RATE_HZ / 1000;  // 32ms * 16kHz / 1000ms
+static const size_t FEATURE_SLICES = 10;  // 200 ms of features
 
 float MicroWakeWord::get_setup_priority() const { return setup_priority::AFTER_CONNECTION; }
 
@@ -69,50 +69,40 @@ void MicroWakeWord::setup() {
     return;
   }
 
-  ExternalRAMAllocator<int16_t> allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
-  this->input_buffer_ = allocator.allocate(INPUT_BUFFER_SIZE * sizeof(int16_t));
-  if (this->input_buffer_ == nullptr) {
-    ESP_LOGW(TAG, "Could not allocate input buffer");
+  // the preprocessor turns each new stride of audio and the history before it into a slice of features
+  this->feature_generator_ = make_unique<AudioFramer<int16_t, int8_t>>(
+      "micro_wake_word features", SAMPLE_DURATION_COUNT, NEW_SAMPLES_TO_GET, PREPROCESSOR_FEATURE_SIZE,
+      [this](const int16_t *audio, int8_t *features) {
+        return this->generate_single_feature_(audio, SAMPLE_DURATION_COUNT, features);
+      });
+  if (!this->feature_generator_->input().init(BUFFER_SIZE) ||
+      !this->features_.init(FEATURE_SLICES * PREPROCESSOR_FEATURE_SIZE)) {
+    ESP_LOGW(TAG, "Could not allocate audio buffers");
     this->mark_failed();
     return;
   }
-
-  this->ring_buffer_ = RingBuffer::create(BUFFER_SIZE * sizeof(int16_t));
-  if (this->ring_buffer_ == nullptr) {
-    ESP_LOGW(TAG, "Could not allocate ring buffer");
-    this->mark_failed();
-    return;
+  const uint32_t sample_rate = this->microphone_->get_sample_rate();
+  if (sample_rate != AUDIO_SAMPLE_FREQUENCY) {
+    this->resampler_ = make_unique<AudioResampler>("micro_wake_word resampler", sample_rate, AUDIO_SAMPLE_FREQUENCY);
+    if (!this->resampler_->input().init(sample_rate / 1000 * BUFFER_LENGTH)) {
+      ESP_LOGW(TAG, "Could not allocate audio buffers");
+      this->mark_failed();
+      return;
+    }
+    this->microphone_->get_pipeline().add_stage(this->resampler_.get());
   }
+  this->microphone_->get_pipeline().add_stage(this->feature_generator_.get());
 
   ESP_LOGCONFIG(TAG, "Micro Wake Word initialized");
 }
 
-int MicroWakeWord::read_microphone_() {
-  size_t bytes_read = this->microphone_->read(this->input_buffer_, INPUT_BUFFER_SIZE * sizeof(int16_t));
-  if (bytes_read == 0) {
-    return 0;
-  }
-
-  size_t bytes_free = this->ring_buffer_->free();
-
-  if (bytes_free < bytes_read) {
-    ESP_LOGW(TAG,
-             "Not enough free bytes in ring buffer to store incoming audio data (free bytes=%d, incoming bytes=%d). "
-             "Resetting the ring buffer. Wake word detection accuracy will be reduced.",
-             bytes_free, bytes_read);
-
-    this->ring_buffer_->reset();
-  }
-
-  return this->ring_buffer_->write((void *) this->input_buffer_, bytes_read);
-}
-
 void MicroWakeWord::loop() {
   switch (this->state_) {
     case State::IDLE:
       break;
     case State::START_MICROPHONE:
       ESP_LOGD(TAG, "Starting Microphone");
+      this->connect_audio_();
       this->microphone_->start();
       this->set_state_(State::STARTING_MICROPHONE);
       this->high_freq_.start();
@@ -123,7 +113,6 @@ void MicroWakeWord::loop() {
       }
       break;
     case State::DETECTING_WAKE_WORD:
-      this->read_microphone_();
       if (this->detect_wake_word_()) {
         ESP_LOGD(TAG, "Wake Word Detected");
         this->detected_ = true;
@@ -132,6 +121,7 @@ void MicroWakeWord::loop() {
       break;
     case State::STOP_MICROPHONE:
       ESP_LOGD(TAG, "Stopping Microphone");
+      this->disconnect_audio_();
       this->microphone_->stop();
       this->set_state_(State::STOPPING_MICROPHONE);
       this->high_freq_.stop();
@@ -178,10 +168,34 @@ void MicroWakeWord::set_state_(State state) {
   this->state_ = state;
 }
 
+void MicroWakeWord::connect_audio_() {
+  // connect the stages from the end, so no audio is dropped for a queue that isn't connected yet
+  AudioPipeline &pipeline = this->microphone_->get_pipeline();
+  pipeline.reset_stage(this->feature_generator_.get());
+  pipeline.connect(this->feature_generator_->output(), this->features_);
+  if (this->resampler_ != nullptr) {
+    pipeline.reset_stage(this->resampler_.get());
+    pipeline.connect(this->resampler_->output(), this->feature_generator_->input());
+    this->microphone_->add_sink(&this->resampler_->input());
+  } else {
+    this->microphone_->add_sink(&this->feature_generator_->input());
+  }
+}
+
+void MicroWakeWord::disconnect_audio_() {
+  AudioPipeline &pipeline = this->microphone_->get_pipeline();
+  if (this->resampler_ != nullptr) {
+    this->microphone_->remove_sink(&this->resampler_->input());
+    pipeline.disconnect(this->resampler_->output(), this->feature_generator_->input());
+  } else {
+    this->microphone_->remove_sink(&this->feature_generator_->input());
+  }
+  pipeline.disconnect(this->feature_generator_->output(), this->features_);
+}
+
 bool MicroWakeWord::initialize_models() {
   ExternalRAMAllocator<uint8_t> arena_allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
   ExternalRAMAllocator<int8_t> features_allocator(ExternalRAMAllocator<int8_t>::ALLOW_FAILURE);
-  ExternalRAMAllocator<int16_t> audio_samples_allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
 
   this->streaming_tensor_arena_ = arena_allocator.allocate(STREAMING_MODEL_ARENA_SIZE);
   if (this->streaming_tensor_arena_ == nullptr) {
@@ -207,12 +221,6 @@ bool MicroWakeWord::initialize_models() {
     return false;
   }
 
-  this->preprocessor_audio_buffer_ = audio_samples_allocator.allocate(SAMPLE_DURATION_COUNT);
-  if (this->preprocessor_audio_buffer_ == nullptr) {
-    ESP_LOGE(TAG, "Could not allocate the audio preprocessor's buffer.");
-    return false;
-  }
-
   this->preprocessor_model_ = tflite::GetModel(G_AUDIO_PREPROCESSOR_INT8_TFLITE);
   if (this->preprocessor_model_->version() != TFLITE_SCHEMA_VERSION) {
     ESP_LOGE(TAG, "Wake word's audio preprocessor model's schema is not supported");
@@ -286,21 +294,6 @@ bool MicroWakeWord::initialize_models() {
   return true;
 }
 
-bool MicroWakeWord::update_features_() {
-  // Retrieve strided audio samples
-  int16_t *audio_samples = nullptr;
-  if (!this->stride_audio_samples_(&audio_samples)) {
-    return false;
-  }
-
-  // Compute the features for the newest audio samples
-  if (!this->generate_single_feature_(audio_samples, SAMPLE_DURATION_COUNT, this->new_features_data_)) {
-    return false;
-  }
-
-  return true;
-}
-
 float MicroWakeWord::perform_streaming_inference_() {
   TfLiteTensor *input = this->streaming_interpreter_->input(0);
 
@@ -324,10 +317,11 @@ float MicroWakeWord::perform_streaming_inference_() {
 }
 
 bool MicroWakeWord::detect_wake_word_() {
-  // Preprocess the newest audio samples into features
-  if (!this->update_features_()) {
+  // Take the next slice of features the audio pipeline generated
+  if (this->features_.available() < PREPROCESSOR_FEATURE_SIZE) {
     return false;
   }
+  this->features_.read(this->new_features_data_, PREPROCESSOR_FEATURE_SIZE);
 
   // Perform inference
   float streaming_prob = this->perform_streaming_inference_();
@@ -371,39 +365,6 @@ void MicroWakeWord::set_sliding_window_average_size(size_t size) {
   this->recent_streaming_probabilities_.resize(this->sliding_window_average_size_, 0.0);
 }
 
-bool MicroWakeWord::slice_available_() {
-  size_t available = this->ring_buffer_->available();
-
-  return available > (NEW_SAMPLES_TO_GET * sizeof(int16_t));
-}
-
-bool MicroWakeWord::stride_audio_samples_(int16_t **audio_samples) {
-  if (!this->slice_available_()) {
-    return false;
-  }
-
-  // Copy the last 320 bytes (160 samples over 10 ms) from the audio buffer to the start of the audio buffer
-  memcpy((void *) (this->preprocessor_audio_buffer_), (void *) (this->preprocessor_audio_buffer_ + NEW_SAMPLES_TO_GET),
-         HISTORY_SAMPLES_TO_KEEP * sizeof(int16_t));
-
-  // Copy 640 bytes (320 samples over 20 ms) from the ring buffer into the audio buffer offset 320 bytes (160 samples
-  // over 10 ms)
-  size_t bytes_read = this->ring_buffer_->read((void *) (this->preprocessor_audio_buffer_ + HISTORY_SAMPLES_TO_KEEP),
-                                               NEW_SAMPLES_TO_GET * sizeof(int16_t), pdMS_TO_TICKS(200));
-
-  if (bytes_read == 0) {
-    ESP_LOGE(TAG, "Could not read data from Ring Buffer");
-  } else if (bytes_read < NEW_SAMPLES_TO_GET * sizeof(int16_t)) {
-    ESP_LOGD(TAG, "Partial Read of Data by Model");
-    ESP_LOGD(TAG, "Could only read %d bytes when required %d bytes ", bytes_read,
-             (int) (NEW_SAMPLES_TO_GET * sizeof(int16_t)));
-    return false;
-  }
-
-  *audio_samples = this->preprocessor_audio_buffer_;
-  return true;
-}
-
 bool MicroWakeWord::generate_single_feature_(const int16_t *audio_data, const int audio_data_size,
                                              int8_t feature_output[PREPROCESSOR_FEATURE_SIZE]) {
   TfLiteTensor *input = this->preprocessor_interperter_->input(0);
@@ -10,9 +10,9 @@
 
 #ifdef USE_ESP_IDF
 
+#include "esphome/core/audio_pipeline.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
-#include "esphome/core/ring_buffer.h"
 
 #include "esphome/components/microphone/microphone.h"
 
@@ -90,7 +90,9 @@ class MicroWakeWord : public Component {
 
  protected:
   void set_state_(State state);
-  int read_microphone_();
+  /// Pass the microphone audio through the feature stages into features_.
+  void connect_audio_();
+  void disconnect_audio_();
 
   const uint8_t *model_start_;
   std::string wake_word_;
@@ -100,9 +102,12 @@ class MicroWakeWord : public Component {
   State state_{State::IDLE};
   HighFrequencyLoopRequester high_freq_;
 
-  std::unique_ptr<RingBuffer> ring_buffer_;
-
-  int16_t *input_buffer_;
+  /// Converts the microphone audio to AUDIO_SAMPLE_FREQUENCY, if it has another sample rate.
+  std::unique_ptr<AudioResampler> resampler_;
+  /// Runs the audio preprocessor over each new stride of audio, as a stage of the microphone's audio pipeline.
+  std::unique_ptr<AudioFramer<int16_t, int8_t>> feature_generator_;
+  /// Feature slices waiting for the streaming model.
+  AudioQueue<int8_t> features_;
 
   const tflite::Model *preprocessor_model_{nullptr};
   const tflite::Model *streaming_model_{nullptr};
@@ -126,30 +131,15 @@ class MicroWakeWord : public Component {
 
   tflite::MicroResourceVariables *mrv_{nullptr};
 
-  // Stores audio fed into feature generator preprocessor
-  int16_t *preprocessor_audio_buffer_;
-
   bool detected_{false};
 
   /** Detects if wake word has been said
    *
-   * If enough audio samples are available, it will generate one slice of new features.
-   * If the streaming model predicts the wake word, then the nonstreaming model confirms it.
-   * @param ring_Buffer Ring buffer containing raw audio samples
+   * If the audio pipeline has generated a new slice of features, the streaming model performs inference over it.
    * @return True if the wake word is detected, false otherwise
    */
   bool detect_wake_word_();
 
-  /// @brief Returns true if there are enough audio samples in the buffer to generate another slice of features
-  bool slice_available_();
-
-  /** Shifts previous feature slices over by one and generates a new slice of features
-   *
-   * @param ring_buffer ring buffer containing raw audio samples
-   * @return True if a new slice of features was generated, false otherwise
-   */
-  bool update_features_();
-
   /** Generates features from audio samples
    *
    * Adapted from TFLite micro speech example
@@ -167,15 +157,6 @@ class MicroWakeWord : public Component {
    */
   float perform_streaming_inference_();
 
-  /** Strides the audio samples by keeping the last 10 ms of the previous slice
-   *
-   * Adapted from the TFLite micro speech example
-   * @param ring_buffer Ring buffer containing raw audio samples
-   * @param audio_samples Pointer to an array that will store the strided audio samples
-   * @return True if successful, false otherwise
-   */
-  bool stride_audio_samples_(int16_t **audio_samples);
-
   /// @brief Returns true if successfully registered the preprocessor's TensorFlow operations
   bool register_preprocessor_ops_(tflite::MicroMutableOpResolver<18> &op_resolver);
 
@@ -13,6 +13,7 @@ CODEOWNERS = ["@jesserockz"]
 IS_PLATFORM_COMPONENT = True
 
 CONF_ON_DATA = "on_data"
+CONF_TASK = "task"
 
 microphone_ns = cg.esphome_ns.namespace("microphone")
 
@@ -37,6 +38,7 @@ IsCapturingCondition = microphone_ns.class_(
 
 
 async def setup_microphone_core_(var, config):
+    cg.add(var.set_task(config[CONF_TASK]))
     for conf in config.get(CONF_ON_DATA, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
         await automation.build_automation(
@@ -54,6 +56,7 @@ async def register_microphone(var, config):
 
 MICROPHONE_SCHEMA = cv.Schema(
     {
+        cv.Optional(CONF_TASK, default=False): cv.boolean,
         cv.Optional(CONF_ON_DATA): automation.validate_automation(
             {
                 cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(DataTrigger),
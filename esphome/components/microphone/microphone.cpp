@@ -0,0 +1,68 @@
+#include "microphone.h"
+
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+
+namespace esphome {
+namespace microphone {
+
+static const char *const TAG = "microphone";
+
+static const uint32_t TASK_STACK_SIZE = 8192;
+static const uint8_t TASK_PRIORITY = 2;
+
+Microphone::Microphone()
+    : source_("microphone", CHUNK, [this](int16_t *samples, size_t count) {
+        return this->read(samples, count * sizeof(int16_t)) / sizeof(int16_t);
+      }) {
+  this->pipeline_.add_stage(&this->source_);
+}
+
+void Microphone::add_data_callback(std::function<void(const std::vector<int16_t> &)> &&data_callback) {
+  if (this->data_callbacks_.size() == 0) {
+    if (!this->callback_queue_.init(4 * CHUNK)) {
+      ESP_LOGE(TAG, "Could not allocate the data callback buffer");
+      return;
+    }
+    this->pipeline_.connect(this->get_output(), this->callback_queue_);
+  }
+  this->data_callbacks_.add(std::move(data_callback));
+}
+
+void Microphone::add_sink(AudioQueue<int16_t> *queue) { this->pipeline_.connect(this->get_output(), *queue); }
+
+void Microphone::remove_sink(AudioQueue<int16_t> *queue) {
+  this->pipeline_.disconnect(this->get_output(), *queue);
+  ESP_LOGD(TAG, "Sink removed: at most %zu samples queued, %" PRIu32 " samples dropped", queue->get_max_queued(),
+           queue->get_dropped());
+}
+
+void Microphone::run_pipeline_() {
+  if (this->task_) {
+    if (!this->pipeline_.is_task_running() &&
+        !this->pipeline_.start_task("microphone", TASK_STACK_SIZE, TASK_PRIORITY)) {
+      ESP_LOGW(TAG, "Could not start the audio task, reading from the main loop");
+      this->task_ = false;
+    }
+  } else {
+    this->pipeline_.run();
+  }
+
+  while (this->callback_queue_.capacity() != 0 && this->callback_queue_.available() != 0) {
+    this->callback_samples_.resize(CHUNK);
+    this->callback_samples_.resize(this->callback_queue_.read(this->callback_samples_.data(), CHUNK));
+    this->data_callbacks_.call(this->callback_samples_);
+  }
+}
+
+bool Microphone::stop_pipeline_() {
+  this->pipeline_.stop_task();
+  if (this->pipeline_.is_task_running())
+    return false;
+  this->pipeline_.log_stats(TAG);
+  return true;
+}
+
+}  // namespace microphone
+}  // namespace esphome
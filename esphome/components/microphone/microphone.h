@@ -1,8 +1,11 @@
 #pragma once
 
+#include "esphome/core/audio_pipeline.h"
 #include "esphome/core/entity_base.h"
 #include "esphome/core/helpers.h"
 
+#include <vector>
+
 namespace esphome {
 namespace microphone {
 
@@ -15,20 +18,53 @@ enum State : uint8_t {
 
 class Microphone {
  public:
+  Microphone();
+
   virtual void start() = 0;
   virtual void stop() = 0;
-  void add_data_callback(std::function<void(const std::vector<int16_t> &)> &&data_callback) {
-    this->data_callbacks_.add(std::move(data_callback));
-  }
+  /// Call \p data_callback with the audio read, from the main loop.
+  void add_data_callback(std::function<void(const std::vector<int16_t> &)> &&data_callback);
   virtual size_t read(int16_t *buf, size_t len) = 0;
+  /// Sample rate of the audio read, in Hz.
+  virtual uint32_t get_sample_rate() const { return 16000; }
+
+  /** Audio pipeline with this microphone as its source.
+   *
+   * The microphone reads the audio once for all listeners, so several components can listen to it at the same time.
+   * They add their stages to the pipeline and connect their queues to get_output(), or just use add_sink().
+   */
+  AudioPipeline &get_pipeline() { return this->pipeline_; }
+  AudioOutput<int16_t> &get_output() { return this->source_.output(); }
+  /// Copy the audio read from now on into \p queue. When it's full, the audio that doesn't fit is dropped for it only.
+  void add_sink(AudioQueue<int16_t> *queue);
+  /// Stop copying audio into \p queue, and log how well it kept up.
+  void remove_sink(AudioQueue<int16_t> *queue);
+
+  /// Read the audio and run the pipeline on a task of its own instead of in loop(), where supported.
+  void set_task(bool task) { this->task_ = task; }
 
   bool is_running() const { return this->state_ == STATE_RUNNING; }
   bool is_stopped() const { return this->state_ == STATE_STOPPED; }
 
  protected:
+  /// Samples read at once.
+  static constexpr size_t CHUNK = 512;
+
+  /// Run the pipeline or start its task, then pass the audio read to the data callbacks. Call from loop().
+  void run_pipeline_();
+  /// Stop the task of the pipeline, false while it still runs. Call from loop() before stopping the device.
+  bool stop_pipeline_();
+
   State state_{STATE_STOPPED};
+  bool task_{false};
 
   CallbackManager<void(const std::vector<int16_t> &)> data_callbacks_{};
+  /// Audio read for the data callbacks, which run in the main loop.
+  AudioQueue<int16_t> callback_queue_;
+  std::vector<int16_t> callback_samples_;
+
+  AudioSource<int16_t> source_;
+  AudioPipeline pipeline_;
 };
 
 }  // namespace microphone
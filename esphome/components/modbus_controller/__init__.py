@@ -11,6 +11,8 @@ from .const import (
     CONF_OFFLINE_SKIP_UPDATES,
     CONF_CUSTOM_COMMAND,
     CONF_FORCE_NEW_RANGE,
+    CONF_MAX_REGISTERS_PER_READ,
+    CONF_MERGE_GAPS,
     CONF_MODBUS_CONTROLLER_ID,
     CONF_REGISTER_COUNT,
     CONF_REGISTER_TYPE,
@@ -106,6 +108,10 @@ CONFIG_SCHEMA = cv.All(
                 CONF_COMMAND_THROTTLE, default="0ms"
             ): cv.positive_time_period_milliseconds,
             cv.Optional(CONF_OFFLINE_SKIP_UPDATES, default=0): cv.positive_int,
+            cv.Optional(CONF_MAX_REGISTERS_PER_READ, default=125): cv.int_range(
+                min=1, max=125
+            ),
+            cv.Optional(CONF_MERGE_GAPS, default=False): cv.boolean,
         }
     )
     .extend(cv.polling_component_schema("60s"))
@@ -211,6 +217,8 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_command_throttle(config[CONF_COMMAND_THROTTLE]))
     cg.add(var.set_offline_skip_updates(config[CONF_OFFLINE_SKIP_UPDATES]))
+    cg.add(var.set_max_registers_per_read(config[CONF_MAX_REGISTERS_PER_READ]))
+    cg.add(var.set_merge_gaps(config[CONF_MERGE_GAPS]))
     await register_modbus_device(var, config)
 
 
@@ -187,9 +187,34 @@ void ModbusController::update() {
   }
 }
 
+static bool is_bit_register(ModbusRegisterType register_type) {
+  return register_type == ModbusRegisterType::COIL || register_type == ModbusRegisterType::DISCRETE_INPUT;
+}
+
+uint8_t ModbusController::max_read_count_(ModbusRegisterType register_type) const {
+  return is_bit_register(register_type) ? MAX_READ_COILS : this->max_registers_per_read_;
+}
+
+// A command costs this many bytes on the bus besides the data read: the request (8), the address, function code,
+// byte count and CRC of the response (5) and the silent interval of 3.5 characters before each of them.
+static const uint16_t READ_COMMAND_OVERHEAD_BYTES = 8 + 5 + 7;
+
+bool ModbusController::should_read_gap_(const RegisterRange &r, uint8_t buffer_offset, const SensorItem *curr) const {
+  if (!this->merge_gaps_)
+    return false;
+  const bool bits = is_bit_register(r.register_type);
+  // the offset of the data after the gap is only known if all registers of the range have the default size
+  if (buffer_offset != r.register_count * (bits ? 1 : 2) || curr->response_bytes != 0)
+    return false;
+  const uint16_t gap = curr->start_address - (r.start_address + r.register_count);
+  const uint16_t gap_bytes = bits ? (gap + 7) / 8 : gap * 2;
+  return gap_bytes < READ_COMMAND_OVERHEAD_BYTES;
+}
+
 // walk through the sensors and determine the register ranges to read
 size_t ModbusController::create_register_ranges_() {
   register_ranges_.clear();
+  this->gap_registers_ = 0;
   if (sensorset_.empty()) {
     ESP_LOGW(TAG, "No sensors registered");
     return 0;
@@ -238,23 +263,29 @@ size_t ModbusController::create_register_ranges_() {
 
           ESP_LOGV(TAG, "Re-use previous register - change to register: 0x%X %d offset=%u", curr->start_address,
                    curr->register_count, curr->offset);
-        } else if (curr->start_address == (r.start_address + r.register_count)) {
-          // this register can extend the current range
-
-          // remove this sensore because start_address is changed (sort-order)
-          ix = sensorset_.erase(ix);
-
-          curr->start_address = r.start_address;
-          curr->offset += buffer_offset;
-          buffer_offset += curr->get_register_size();
-          r.register_count += curr->register_count;
-
-          sensorset_.insert(curr);
-          // move iterator backwards because it will be incremented later
-          ix--;
-
-          ESP_LOGV(TAG, "Extend range - change to register: 0x%X %d offset=%u", curr->start_address,
-                   curr->register_count, curr->offset);
+        } else if (curr->start_address >= (r.start_address + r.register_count)) {
+          const uint16_t gap = curr->start_address - (r.start_address + r.register_count);
+          if (r.register_count + gap + curr->register_count <= this->max_read_count_(r.register_type) &&
+              (gap == 0 || this->should_read_gap_(r, buffer_offset, curr))) {
+            // this register can extend the current range, reading the unused registers in between if there are any
+            const uint8_t gap_size = is_bit_register(r.register_type) ? gap : gap * 2;
+
+            // remove this sensore because start_address is changed (sort-order)
+            ix = sensorset_.erase(ix);
+
+            curr->start_address = r.start_address;
+            curr->offset += buffer_offset + gap_size;
+            buffer_offset += gap_size + curr->get_register_size();
+            r.register_count += gap + curr->register_count;
+            this->gap_registers_ += gap;
+
+            sensorset_.insert(curr);
+            // move iterator backwards because it will be incremented later
+            ix--;
+
+            ESP_LOGV(TAG, "Extend range - change to register: 0x%X %d offset=%u gap=%u", curr->start_address,
+                     curr->register_count, curr->offset, gap);
+          }
         }
       }
     }
@@ -297,6 +328,10 @@ size_t ModbusController::create_register_ranges_() {
 void ModbusController::dump_config() {
   ESP_LOGCONFIG(TAG, "ModbusController:");
   ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
+  ESP_LOGCONFIG(TAG, "  Max Registers per Read: %u", this->max_registers_per_read_);
+  ESP_LOGCONFIG(TAG, "  Merge Gaps: %s", YESNO(this->merge_gaps_));
+  ESP_LOGCONFIG(TAG, "  Read Commands per Update: %zu (%u unused registers)", this->register_ranges_.size(),
+                this->gap_registers_);
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
   ESP_LOGCONFIG(TAG, "sensormap");
   for (auto &it : sensorset_) {
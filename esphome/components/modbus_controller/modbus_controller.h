@@ -284,6 +284,11 @@ class SensorItemsComparator {
 
 using SensorSet = std::set<SensorItem *, SensorItemsComparator>;
 
+/// Max number of registers of a read command, limited by the size of a modbus frame
+static const uint8_t MAX_READ_REGISTERS = 125;
+/// Max number of coils of a read command, the offset of a coil in the range is stored in 8 bits
+static const uint8_t MAX_READ_COILS = 255;
+
 struct RegisterRange {
   uint16_t start_address;
   ModbusRegisterType register_type;
@@ -432,6 +437,12 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   void set_command_throttle(uint16_t command_throttle) { this->command_throttle_ = command_throttle; }
   /// called by esphome generated code to set the offline_skip_updates
   void set_offline_skip_updates(uint16_t offline_skip_updates) { this->offline_skip_updates_ = offline_skip_updates; }
+  /// called by esphome generated code to limit the number of registers read by one command
+  void set_max_registers_per_read(uint8_t max_registers_per_read) {
+    this->max_registers_per_read_ = max_registers_per_read;
+  }
+  /// called by esphome generated code to allow reading unused registers to save commands
+  void set_merge_gaps(bool merge_gaps) { this->merge_gaps_ = merge_gaps; }
   /// get the number of queued modbus commands (should be mostly empty)
   size_t get_command_queue_length() { return command_queue_.size(); }
   /// get if the module is offline, didn't respond the last command
@@ -440,6 +451,10 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
  protected:
   /// parse sensormap_ and create range of sequential addresses
   size_t create_register_ranges_();
+  /// most registers (or coils) of the type one read command may cover
+  uint8_t max_read_count_(ModbusRegisterType register_type) const;
+  /// if reading the unused registers between the range and the sensor is cheaper than a separate command
+  bool should_read_gap_(const RegisterRange &r, uint8_t buffer_offset, const SensorItem *curr) const;
   // find register in sensormap. Returns iterator with all registers having the same start address
   SensorSet find_sensors_(ModbusRegisterType register_type, uint16_t start_address) const;
   /// submit the read command for the address range to the send queue
@@ -466,6 +481,12 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   bool module_offline_;
   /// how many updates to skip if module is offline
   uint16_t offline_skip_updates_;
+  /// max number of registers read by one command
+  uint8_t max_registers_per_read_{MAX_READ_REGISTERS};
+  /// read unused registers between sensors if that saves a command
+  bool merge_gaps_{false};
+  /// number of unused registers read by all ranges
+  uint16_t gap_registers_{0};
 };
 
 /** Convert vector<uint8_t> response payload to float.
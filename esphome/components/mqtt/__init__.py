@@ -58,6 +58,8 @@ AUTO_LOAD = ["json"]
 
 CONF_IDF_SEND_ASYNC = "idf_send_async"
 CONF_SKIP_CERT_CN_CHECK = "skip_cert_cn_check"
+CONF_PUBLISH_QUEUE_SIZE = "publish_queue_size"
+CONF_MAX_IN_FLIGHT = "max_in_flight"
 
 
 def validate_message_just_topic(value):
@@ -246,6 +248,14 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_REBOOT_TIMEOUT, default="15min"
             ): cv.positive_time_period_milliseconds,
+            cv.SplitDefault(
+                CONF_PUBLISH_QUEUE_SIZE,
+                esp8266="4kB",
+                esp32="16kB",
+                bk72xx="8kB",
+                rtl87xx="8kB",
+            ): cv.validate_bytes,
+            cv.Optional(CONF_MAX_IN_FLIGHT, default=8): cv.int_range(min=1, max=65535),
             cv.Optional(CONF_ON_CONNECT): automation.validate_automation(
                 {
                     cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(MQTTConnectTrigger),
@@ -383,6 +393,9 @@ async def to_code(config):
     cg.add(var.set_keep_alive(config[CONF_KEEPALIVE]))
 
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    if CONF_PUBLISH_QUEUE_SIZE in config:
+        cg.add(var.set_publish_queue_size(config[CONF_PUBLISH_QUEUE_SIZE]))
+    cg.add(var.set_max_in_flight(config[CONF_MAX_IN_FLIGHT]))
 
     # esp-idf only
     if CONF_CERTIFICATE_AUTHORITY in config:
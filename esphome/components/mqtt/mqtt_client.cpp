@@ -2,6 +2,7 @@
 
 #ifdef USE_MQTT
 
+#include <cstring>
 #include <utility>
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
@@ -53,14 +54,19 @@ void MQTTClientComponent::setup() {
     this->state_ = MQTT_CLIENT_DISCONNECTED;
     this->disconnect_reason_ = reason;
   });
+  // may be called from the network task, so only count the acknowledgement here
+  this->mqtt_backend_.set_on_publish(
+      [this](uint16_t packet_id) { this->publishes_acked_.fetch_add(1, std::memory_order_relaxed); });
+#ifdef USE_SENSOR
+  if (this->queue_depth_sensor_ != nullptr || this->dropped_sensor_ != nullptr || this->latency_sensor_ != nullptr)
+    this->set_interval_static("publish_stats", this->publish_stats_interval_, [this]() { this->publish_stats_(); });
+#endif
 #ifdef USE_LOGGER
   if (this->is_log_message_enabled() && logger::global_logger != nullptr) {
     logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
       if (level <= this->log_level_ && this->is_connected()) {
-        this->publish({.topic = this->log_message_.topic,
-                       .payload = message,
-                       .qos = this->log_message_.qos,
-                       .retain = this->log_message_.retain});
+        this->publish(this->log_message_.topic.c_str(), message, strlen(message), this->log_message_.qos,
+                      this->log_message_.retain, MQTTPublishPriority::LOG);
       }
     });
   }
@@ -89,7 +95,7 @@ void MQTTClientComponent::send_device_info_() {
   topic.append(App.get_name());
 
   this->publish_json(
-      topic,
+      topic.c_str(),
       [](JsonObject root) {
         uint8_t index = 0;
         for (auto &ip : network::get_ip_addresses()) {
@@ -131,7 +137,7 @@ void MQTTClientComponent::send_device_info_() {
         root["package_import_url"] = dashboard_import::get_package_import_url();
 #endif
       },
-      2, this->discovery_info_.retain);
+      2, this->discovery_info_.retain, MQTTPublishPriority::DISCOVERY);
 }
 
 void MQTTClientComponent::dump_config() {
@@ -270,6 +276,9 @@ void MQTTClientComponent::check_connected() {
 
   this->state_ = MQTT_CLIENT_CONNECTED;
   this->sent_birth_message_ = false;
+  // everything is sent again below, and acknowledgements from the last connection won't arrive anymore
+  this->publish_queue_.clear();
+  this->publishes_sent_ = this->publishes_acked_.load(std::memory_order_relaxed);
   this->status_clear_warning();
   ESP_LOGI(TAG, "MQTT Connected!");
   // MQTT Client needs some time to be fully set up.
@@ -350,6 +359,7 @@ void MQTTClientComponent::loop() {
 
         this->last_connected_ = now;
         this->resubscribe_subscriptions_();
+        this->drain_publish_queue_();
       }
       break;
   }
@@ -406,6 +416,7 @@ void MQTTClientComponent::subscribe(const std::string &topic, mqtt_callback_t ca
   };
   this->resubscribe_subscription_(&subscription);
   this->subscriptions_.push_back(subscription);
+  this->topic_router_dirty_ = true;
 }
 
 void MQTTClientComponent::subscribe_json(const std::string &topic, const mqtt_json_callback_t &callback, uint8_t qos) {
@@ -421,6 +432,7 @@ void MQTTClientComponent::subscribe_json(const std::string &topic, const mqtt_js
   };
   this->resubscribe_subscription_(&subscription);
   this->subscriptions_.push_back(subscription);
+  this->topic_router_dirty_ = true;
 }
 
 void MQTTClientComponent::unsubscribe(const std::string &topic) {
@@ -442,6 +454,7 @@ void MQTTClientComponent::unsubscribe(const std::string &topic) {
       ++it;
     }
   }
+  this->topic_router_dirty_ = true;
 }
 
 // Publish
@@ -451,96 +464,109 @@ bool MQTTClientComponent::publish(const std::string &topic, const std::string &p
 
 bool MQTTClientComponent::publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
                                   bool retain) {
-  return publish({.topic = topic, .payload = payload, .qos = qos, .retain = retain});
+  return this->publish(topic.c_str(), payload, payload_length, qos, retain);
 }
 
 bool MQTTClientComponent::publish(const MQTTMessage &message) {
+  return this->publish(message.topic.c_str(), message.payload.data(), message.payload.size(), message.qos,
+                       message.retain);
+}
+
+bool MQTTClientComponent::publish(const char *topic, const char *payload, size_t payload_length, uint8_t qos,
+                                  bool retain, MQTTPublishPriority priority) {
   if (!this->is_connected()) {
     // critical components will re-transmit their messages
     return false;
   }
-  bool logging_topic = this->log_message_.topic == message.topic;
-  bool ret = this->mqtt_backend_.publish(message);
-  delay(0);
-  if (!ret && !logging_topic && this->is_connected()) {
-    delay(0);
-    ret = this->mqtt_backend_.publish(message);
-    delay(0);
+  bool logging_topic = this->log_message_.topic == topic;
+  if (logging_topic)
+    priority = MQTTPublishPriority::LOG;
+
+  // only send right away if that doesn't overtake queued messages, otherwise queue it behind them
+  if (!this->publish_queue_.has_pending(priority) && this->send_(topic, payload, payload_length, qos, retain)) {
+    if (!logging_topic) {
+      ESP_LOGV(TAG, "Publish(topic='%s' payload='%.*s' retain=%d qos=%d)", topic, (int) payload_length, payload, retain,
+               qos);
+    }
+    return true;
   }
 
+  bool queued = this->publish_queue_.push(topic, payload, payload_length, qos, retain, priority, millis());
   if (!logging_topic) {
-    if (ret) {
-      ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d qos=%d)", message.topic.c_str(), message.payload.c_str(),
-               message.retain, message.qos);
+    if (queued) {
+      ESP_LOGV(TAG, "Queued publish for topic='%s' (len=%zu)", topic, payload_length);
     } else {
-      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%u). will retry later..", message.topic.c_str(),
-               message.payload.length());
+      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%zu), the queue is full. will retry later..", topic,
+               payload_length);
       this->status_momentary_warning("publish", 1000);
     }
   }
-  return ret != 0;
+  return queued;
 }
-bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos,
-                                       bool retain) {
-  std::string message = json::build_json(f);
-  return this->publish(topic, message, qos, retain);
-}
-
-/** Check if the message topic matches the given subscription topic
- *
- * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
- *
- * @param message The message topic that was received from the MQTT server. Note: this must not contain
- *                wildcard characters as mandated by the MQTT spec.
- * @param subscription The subscription topic we are matching against.
- * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
- * @param past_separator Are we past the first '/' topic separator.
- * @return true if the subscription topic matches the message topic, false otherwise.
- */
-static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
-  // Reached end of both strings at the same time, this means we have a successful match
-  if (*message == '\0' && *subscription == '\0')
-    return true;
-
-  // Either the message or the subscribe are at the end. This means they don't match.
-  if (*message == '\0' || *subscription == '\0')
-    return false;
-
-  bool do_wildcards = is_normal || past_separator;
 
-  if (*subscription == '+' && do_wildcards) {
-    // single level wildcard
-    // consume + from subscription
-    subscription++;
-    // consume everything from message until '/' found or end of string
-    while (*message != '\0' && *message != '/') {
-      message++;
-    }
-    // after this, both pointers will point to a '/' or to the end of the string
-
-    return topic_match(message, subscription, is_normal, true);
+bool MQTTClientComponent::send_(const char *topic, const char *payload, size_t payload_length, uint8_t qos,
+                                bool retain) {
+  if (qos > 0) {
+    int32_t in_flight = this->publishes_sent_ - this->publishes_acked_.load(std::memory_order_relaxed);
+    if (in_flight >= (int32_t) this->max_in_flight_)
+      return false;
   }
+  bool ret = this->mqtt_backend_.publish(topic, payload, payload_length, qos, retain);
+  delay(0);
+  if (ret && qos > 0)
+    this->publishes_sent_++;
+  return ret;
+}
 
-  if (*subscription == '#' && do_wildcards) {
-    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
-    return true;
+void MQTTClientComponent::drain_publish_queue_() {
+  // send a few messages per loop iteration, so that a burst neither blocks the loop nor fills the backend buffer
+  for (uint8_t i = 0; i < MAX_QUEUED_PUBLISHES_PER_LOOP; i++) {
+    const MQTTPublishQueue::Message *message = this->publish_queue_.front();
+    if (message == nullptr)
+      return;
+    // send_() can log, and a log published over MQTT may queue another message and move this one
+    uint32_t queued_at = message->queued_at;
+    if (!this->send_(message->topic.c_str(), message->payload.data(), message->payload.size(), message->qos,
+                     message->retain))
+      return;
+    uint32_t latency = millis() - queued_at;
+    if (latency > this->max_publish_latency_)
+      this->max_publish_latency_ = latency;
+    this->publish_queue_.pop();
   }
-
-  // this handles '/' and normal characters at the same time.
-  if (*message != *subscription)
-    return false;
-
-  past_separator = past_separator || *subscription == '/';
-
-  // consume characters
-  subscription++;
-  message++;
-
-  return topic_match(message, subscription, is_normal, past_separator);
 }
 
-static bool topic_match(const char *message, const char *subscription) {
-  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
+#ifdef USE_SENSOR
+void MQTTClientComponent::publish_stats_() {
+  if (this->queue_depth_sensor_ != nullptr)
+    this->queue_depth_sensor_->publish_state(this->publish_queue_.size());
+  if (this->dropped_sensor_ != nullptr)
+    this->dropped_sensor_->publish_state(this->publish_queue_.get_dropped());
+  if (this->latency_sensor_ != nullptr)
+    this->latency_sensor_->publish_state(this->max_publish_latency_);
+  this->max_publish_latency_ = 0;
+}
+#endif
+bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos,
+                                       bool retain) {
+  return this->publish_json(topic.c_str(), f, qos, retain);
+}
+bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_write_t &f, uint8_t qos,
+                                       bool retain) {
+  return this->publish_json(topic.c_str(), f, qos, retain);
+}
+bool MQTTClientComponent::publish_json(const char *topic, const json::json_build_t &f, uint8_t qos, bool retain,
+                                       MQTTPublishPriority priority) {
+  // serialize into the reused buffer, so that it keeps its capacity between messages
+  this->publish_buffer_.clear();
+  json::build_json(f, this->publish_buffer_);
+  return this->publish(topic, this->publish_buffer_.data(), this->publish_buffer_.size(), qos, retain, priority);
+}
+bool MQTTClientComponent::publish_json(const char *topic, const json::json_write_t &f, uint8_t qos, bool retain,
+                                       MQTTPublishPriority priority) {
+  this->publish_buffer_.clear();
+  json::build_json(f, this->publish_buffer_);
+  return this->publish(topic, this->publish_buffer_.data(), this->publish_buffer_.size(), qos, retain, priority);
 }
 
 void MQTTClientComponent::on_message(const std::string &topic, const std::string &payload) {
@@ -549,9 +575,16 @@ void MQTTClientComponent::on_message(const std::string &topic, const std::string
   // from a different task.
   this->defer([this, topic, payload]() {
 #endif
-    for (auto &subscription : this->subscriptions_) {
-      if (topic_match(topic.c_str(), subscription.topic.c_str()))
-        subscription.callback(topic, payload);
+    if (this->topic_router_dirty_) {
+      this->topic_router_.clear();
+      for (size_t i = 0; i < this->subscriptions_.size(); i++)
+        this->topic_router_.add(i, this->subscriptions_[i].topic.c_str());
+      this->topic_router_dirty_ = false;
+    }
+    for (size_t index : this->topic_router_.match(topic.c_str())) {
+      // a callback may have removed subscriptions
+      if (index < this->subscriptions_.size())
+        this->subscriptions_[index].callback(topic, payload);
     }
 #ifdef USE_ESP8266
   });
@@ -625,7 +658,9 @@ void MQTTClientComponent::disable_discovery() {
 void MQTTClientComponent::on_shutdown() {
   if (!this->shutdown_message_.topic.empty()) {
     yield();
-    this->publish(this->shutdown_message_);
+    // bypass the queue, it won't be drained anymore
+    if (this->is_connected())
+      this->mqtt_backend_.publish(this->shutdown_message_);
     yield();
   }
   this->mqtt_backend_.disconnect();
@@ -17,7 +17,13 @@
 #include "mqtt_backend_libretiny.h"
 #endif
 #include "lwip/ip_addr.h"
+#include "mqtt_publish_queue.h"
+#include "mqtt_topic_router.h"
+#ifdef USE_SENSOR
+#include "esphome/components/sensor/sensor.h"
+#endif
 
+#include <atomic>
 #include <vector>
 
 namespace esphome {
@@ -215,6 +221,13 @@ class MQTTClientComponent : public Component {
 
   bool publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos = 0,
                bool retain = false);
+  /** Publish a MQTT message without copying the topic or the payload.
+   *
+   * If the message can't be handed to the backend right away, or messages of the same or a higher \p priority are
+   * still waiting, the message is queued and sent from loop(). Returns false if the message was dropped.
+   */
+  bool publish(const char *topic, const char *payload, size_t payload_length, uint8_t qos = 0, bool retain = false,
+               MQTTPublishPriority priority = MQTTPublishPriority::STATE);
 
   /** Construct and send a JSON MQTT message.
    *
@@ -223,6 +236,23 @@ class MQTTClientComponent : public Component {
    * @param retain Whether to retain the message.
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos = 0, bool retain = false);
+  /// Construct and send a JSON MQTT message, streaming it out with a JsonWriter instead of building a document.
+  bool publish_json(const std::string &topic, const json::json_write_t &f, uint8_t qos = 0, bool retain = false);
+  bool publish_json(const char *topic, const json::json_build_t &f, uint8_t qos = 0, bool retain = false,
+                    MQTTPublishPriority priority = MQTTPublishPriority::STATE);
+  bool publish_json(const char *topic, const json::json_write_t &f, uint8_t qos = 0, bool retain = false,
+                    MQTTPublishPriority priority = MQTTPublishPriority::STATE);
+
+  /// Limit the topics and payloads of the messages waiting to be published to \p size bytes.
+  void set_publish_queue_size(size_t size) { this->publish_queue_.set_max_bytes(size); }
+  /// Set the number of QoS 1 and 2 messages that may be sent without being acknowledged yet.
+  void set_max_in_flight(uint16_t max_in_flight) { this->max_in_flight_ = max_in_flight; }
+#ifdef USE_SENSOR
+  void set_queue_depth_sensor(sensor::Sensor *queue_depth_sensor) { this->queue_depth_sensor_ = queue_depth_sensor; }
+  void set_dropped_sensor(sensor::Sensor *dropped_sensor) { this->dropped_sensor_ = dropped_sensor; }
+  void set_latency_sensor(sensor::Sensor *latency_sensor) { this->latency_sensor_ = latency_sensor; }
+  void set_publish_stats_interval(uint32_t interval) { this->publish_stats_interval_ = interval; }
+#endif
 
   /// Setup the MQTT client, registering a bunch of callbacks and attempting to connect.
   void setup() override;
@@ -270,6 +300,14 @@ class MQTTClientComponent : public Component {
   /// Re-calculate the availability property.
   void recalculate_availability_();
 
+  /// Hand a message to the backend, unless the in-flight window is full.
+  bool send_(const char *topic, const char *payload, size_t payload_length, uint8_t qos, bool retain);
+  /// Send some of the queued messages.
+  void drain_publish_queue_();
+#ifdef USE_SENSOR
+  void publish_stats_();
+#endif
+
   bool subscribe_(const char *topic, uint8_t qos);
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
@@ -297,9 +335,28 @@ class MQTTClientComponent : public Component {
   std::string topic_prefix_{};
   MQTTMessage log_message_;
   std::string payload_buffer_;
+  /// Outgoing JSON payloads are serialized into this buffer, which is reused for every message.
+  std::string publish_buffer_;
+  static constexpr uint8_t MAX_QUEUED_PUBLISHES_PER_LOOP = 4;
+  MQTTPublishQueue publish_queue_;
+  uint16_t max_in_flight_{8};
+  /// QoS 1 and 2 messages sent and acknowledged, the difference is the number in flight.
+  uint32_t publishes_sent_{0};
+  std::atomic<uint32_t> publishes_acked_{0};
+  /// Longest time a message waited in the queue since the last report.
+  uint32_t max_publish_latency_{0};
+#ifdef USE_SENSOR
+  sensor::Sensor *queue_depth_sensor_{nullptr};
+  sensor::Sensor *dropped_sensor_{nullptr};
+  sensor::Sensor *latency_sensor_{nullptr};
+  uint32_t publish_stats_interval_{60000};
+#endif
   int log_level_{ESPHOME_LOG_LEVEL};
 
   std::vector<MQTTSubscription> subscriptions_;
+  /// Matches received topics to subscriptions_, rebuilt on the next message after they changed.
+  MQTTTopicRouter topic_router_;
+  bool topic_router_dirty_{false};
 #if defined(USE_ESP32)
   MQTTBackendESP32 mqtt_backend_;
 #elif defined(USE_ESP8266)
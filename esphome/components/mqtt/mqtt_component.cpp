@@ -2,6 +2,8 @@
 
 #ifdef USE_MQTT
 
+#include <cstring>
+
 #include "esphome/core/application.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
@@ -19,31 +21,71 @@ void MQTTComponent::set_qos(uint8_t qos) { this->qos_ = qos; }
 void MQTTComponent::set_retain(bool retain) { this->retain_ = retain; }
 
 std::string MQTTComponent::get_discovery_topic_(const MQTTDiscoveryInfo &discovery_info) const {
-  std::string sanitized_name = str_sanitize(App.get_name());
-  return discovery_info.prefix + "/" + this->component_type() + "/" + sanitized_name + "/" +
+  // the node name can't change at runtime, so it only has to be sanitized once
+  static const std::string SANITIZED_NAME = str_sanitize(App.get_name());
+  return discovery_info.prefix + "/" + this->component_type() + "/" + SANITIZED_NAME + "/" +
          this->get_default_object_id_() + "/config";
 }
 
-std::string MQTTComponent::get_default_topic_for_(const std::string &suffix) const {
+// Default topics are "<topic_prefix>/<component_type>/<object_id>/<suffix>"
+static const char *const STATE_SUFFIX = "state";
+static const char *const COMMAND_SUFFIX = "command";
+
+void MQTTComponent::compute_default_topics_() const {
+  this->default_topics_computed_ = true;
   const std::string &topic_prefix = global_mqtt_client->get_topic_prefix();
   if (topic_prefix.empty()) {
     // If the topic_prefix is null, the default topic should be null
-    return "";
+    return;
   }
 
-  return topic_prefix + "/" + this->component_type() + "/" + this->get_default_object_id_() + "/" + suffix;
+  std::string base = topic_prefix + "/" + this->component_type() + "/" + this->get_default_object_id_() + "/";
+  // both topics go into a single allocation, including their null terminators
+  size_t state_suffix_len = strlen(STATE_SUFFIX) + 1;
+  size_t command_suffix_len = strlen(COMMAND_SUFFIX) + 1;
+  size_t state_len = base.size() + state_suffix_len;
+  this->default_topics_ = std::unique_ptr<char[]>(new char[state_len + base.size() + command_suffix_len]);  // NOLINT
+  this->default_command_topic_offset_ = state_len;
+  char *topics = this->default_topics_.get();
+  memcpy(topics, base.data(), base.size());
+  memcpy(topics + base.size(), STATE_SUFFIX, state_suffix_len);
+  memcpy(topics + state_len, base.data(), base.size());
+  memcpy(topics + state_len + base.size(), COMMAND_SUFFIX, command_suffix_len);
+}
+
+std::string MQTTComponent::get_default_topic_for_(const std::string &suffix) const {
+  if (!this->default_topics_computed_)
+    this->compute_default_topics_();
+  if (this->default_topics_ == nullptr)
+    return "";
+
+  // reuse the "<topic_prefix>/<component_type>/<object_id>/" part of the state topic
+  size_t base_len = this->default_command_topic_offset_ - strlen(STATE_SUFFIX) - 1;
+  std::string topic;
+  topic.reserve(base_len + suffix.size());
+  topic.append(this->default_topics_.get(), base_len);
+  topic += suffix;
+  return topic;
 }
 
-std::string MQTTComponent::get_state_topic_() const {
+StringRef MQTTComponent::get_state_topic_() const {
   if (this->has_custom_state_topic_)
-    return this->custom_state_topic_.str();
-  return this->get_default_topic_for_("state");
+    return this->custom_state_topic_;
+  if (!this->default_topics_computed_)
+    this->compute_default_topics_();
+  if (this->default_topics_ == nullptr)
+    return StringRef();
+  return StringRef(this->default_topics_.get());
 }
 
-std::string MQTTComponent::get_command_topic_() const {
+StringRef MQTTComponent::get_command_topic_() const {
   if (this->has_custom_command_topic_)
-    return this->custom_command_topic_.str();
-  return this->get_default_topic_for_("command");
+    return this->custom_command_topic_;
+  if (!this->default_topics_computed_)
+    this->compute_default_topics_();
+  if (this->default_topics_ == nullptr)
+    return StringRef();
+  return StringRef(this->default_topics_.get() + this->default_command_topic_offset_);
 }
 
 bool MQTTComponent::publish(const std::string &topic, const std::string &payload) {
@@ -51,25 +93,46 @@ bool MQTTComponent::publish(const std::string &topic, const std::string &payload
     return false;
   return global_mqtt_client->publish(topic, payload, this->qos_, this->retain_);
 }
+bool MQTTComponent::publish(const StringRef &topic, const std::string &payload) {
+  if (topic.empty())
+    return false;
+  return global_mqtt_client->publish(topic.c_str(), payload.data(), payload.size(), this->qos_, this->retain_);
+}
 
 bool MQTTComponent::publish_json(const std::string &topic, const json::json_build_t &f) {
   if (topic.empty())
     return false;
   return global_mqtt_client->publish_json(topic, f, this->qos_, this->retain_);
 }
+bool MQTTComponent::publish_json(const std::string &topic, const json::json_write_t &f) {
+  if (topic.empty())
+    return false;
+  return global_mqtt_client->publish_json(topic, f, this->qos_, this->retain_);
+}
+bool MQTTComponent::publish_json(const StringRef &topic, const json::json_build_t &f) {
+  if (topic.empty())
+    return false;
+  return global_mqtt_client->publish_json(topic.c_str(), f, this->qos_, this->retain_);
+}
+bool MQTTComponent::publish_json(const StringRef &topic, const json::json_write_t &f) {
+  if (topic.empty())
+    return false;
+  return global_mqtt_client->publish_json(topic.c_str(), f, this->qos_, this->retain_);
+}
 
 bool MQTTComponent::send_discovery_() {
   const MQTTDiscoveryInfo &discovery_info = global_mqtt_client->get_discovery_info();
 
   if (discovery_info.clean) {
     ESP_LOGV(TAG, "'%s': Cleaning discovery...", this->friendly_name().c_str());
-    return global_mqtt_client->publish(this->get_discovery_topic_(discovery_info), "", 0, this->qos_, true);
+    return global_mqtt_client->publish(this->get_discovery_topic_(discovery_info).c_str(), "", 0, this->qos_, true,
+                                       MQTTPublishPriority::DISCOVERY);
   }
 
   ESP_LOGV(TAG, "'%s': Sending discovery...", this->friendly_name().c_str());
 
   return global_mqtt_client->publish_json(
-      this->get_discovery_topic_(discovery_info),
+      this->get_discovery_topic_(discovery_info).c_str(),
       [this](JsonObject root) {
         SendDiscoveryConfig config;
         config.state_topic = true;
@@ -157,7 +220,7 @@ bool MQTTComponent::send_discovery_() {
         device_info[MQTT_DEVICE_MANUFACTURER] = "espressif";
         device_info[MQTT_DEVICE_SUGGESTED_AREA] = node_area;
       },
-      this->qos_, discovery_info.retain);
+      this->qos_, discovery_info.retain, MQTTPublishPriority::DISCOVERY);
 }
 
 uint8_t MQTTComponent::get_qos() const { return this->qos_; }
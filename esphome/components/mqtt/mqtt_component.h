@@ -118,6 +118,7 @@ class MQTTComponent : public Component {
    * @param payload The payload.
    */
   bool publish(const std::string &topic, const std::string &payload);
+  bool publish(const StringRef &topic, const std::string &payload);
 
   /** Construct and send a JSON MQTT message.
    *
@@ -125,6 +126,10 @@ class MQTTComponent : public Component {
    * @param f The Json Message builder.
    */
   bool publish_json(const std::string &topic, const json::json_build_t &f);
+  /// Construct and send a JSON MQTT message, streaming it out with a JsonWriter instead of building a document.
+  bool publish_json(const std::string &topic, const json::json_write_t &f);
+  bool publish_json(const StringRef &topic, const json::json_build_t &f);
+  bool publish_json(const StringRef &topic, const json::json_write_t &f);
 
   /** Subscribe to a MQTT topic.
    *
@@ -178,10 +183,13 @@ class MQTTComponent : public Component {
   virtual bool is_disabled_by_default() const;
 
   /// Get the MQTT topic that new states will be shared to.
-  std::string get_state_topic_() const;
+  StringRef get_state_topic_() const;
 
   /// Get the MQTT topic for listening to commands.
-  std::string get_command_topic_() const;
+  StringRef get_command_topic_() const;
+
+  /// Compute the default state and command topics once, they don't change after setup.
+  void compute_default_topics_() const;
 
   bool is_connected_() const;
 
@@ -198,6 +206,11 @@ class MQTTComponent : public Component {
 
   std::unique_ptr<Availability> availability_;
 
+  /// The default state topic followed by the default command topic, both null terminated. Empty without a prefix.
+  mutable std::unique_ptr<char[]> default_topics_;
+  mutable uint16_t default_command_topic_offset_{0};
+  mutable bool default_topics_computed_{false};
+
   bool has_custom_state_topic_{false};
   bool has_custom_command_topic_{false};
 
@@ -0,0 +1,136 @@
+#include "mqtt_publish_queue.h"
+
+#ifdef USE_MQTT
+
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace mqtt {
+
+bool MQTTPublishQueue::push(const char *topic, const char *payload, size_t payload_length, uint8_t qos, bool retain,
+                            MQTTPublishPriority priority, uint32_t now) {
+  size_t topic_length = strlen(topic);
+  size_t needed = topic_length + payload_length;
+
+  if (priority == MQTTPublishPriority::STATE) {
+    auto find_state = [&]() {
+      for (size_t i = 0; i < this->messages_.size(); i++) {
+        const Message &message = this->messages_[i];
+        if (message.priority == priority && message.qos == qos && message.retain == retain &&
+            message.topic.size() == topic_length && memcmp(message.topic.data(), topic, topic_length) == 0)
+          return i;
+      }
+      return this->messages_.size();
+    };
+    size_t index = find_state();
+    if (index != this->messages_.size()) {
+      // replace the queued state, it keeps its place in the queue
+      size_t queued = this->messages_[index].payload.size();
+      if (payload_length > queued) {
+        if (!this->make_room_(payload_length - queued, priority))
+          return false;
+        // make_room_() only drops messages with a lower priority, but these may have come before this one
+        index = find_state();
+      }
+      this->bytes_ = this->bytes_ - queued + payload_length;
+      this->messages_[index].payload.assign(payload, payload_length);
+      return true;
+    }
+  }
+
+  if (!this->make_room_(needed, priority))
+    return false;
+
+  this->messages_.push_back(Message{
+      .topic = std::string(topic, topic_length),
+      .payload = std::string(payload, payload_length),
+      .qos = qos,
+      .retain = retain,
+      .priority = priority,
+      .queued_at = now,
+  });
+  this->bytes_ += needed;
+  this->pending_[static_cast<uint8_t>(priority)]++;
+  return true;
+}
+
+bool MQTTPublishQueue::make_room_(size_t needed, MQTTPublishPriority priority) {
+  if (this->bytes_ + needed <= this->max_bytes_)
+    return true;
+  // only drop anything if that makes enough room
+  size_t droppable = 0;
+  for (const auto &message : this->messages_) {
+    if (message.priority > priority)
+      droppable += message_bytes_(message);
+  }
+  if (this->bytes_ - droppable + needed > this->max_bytes_) {
+    this->dropped_++;
+    return false;
+  }
+  while (this->bytes_ + needed > this->max_bytes_) {
+    // drop the newest message of the lowest priority below this one
+    size_t victim = this->messages_.size();
+    for (size_t i = this->messages_.size(); i-- > 0;) {
+      MQTTPublishPriority p = this->messages_[i].priority;
+      if (p > priority && (victim == this->messages_.size() || p > this->messages_[victim].priority))
+        victim = i;
+    }
+    this->dropped_++;
+    this->erase_(victim);
+  }
+  return true;
+}
+
+bool MQTTPublishQueue::has_pending(MQTTPublishPriority priority) const {
+  for (uint8_t p = 0; p <= static_cast<uint8_t>(priority); p++) {
+    if (this->pending_[p] != 0)
+      return true;
+  }
+  return false;
+}
+
+const MQTTPublishQueue::Message *MQTTPublishQueue::front() {
+  for (uint8_t p = 0; p < sizeof(this->pending_) / sizeof(this->pending_[0]); p++) {
+    if (this->pending_[p] == 0)
+      continue;
+    for (size_t i = 0; i < this->messages_.size(); i++) {
+      if (static_cast<uint8_t>(this->messages_[i].priority) == p) {
+        this->front_ = i;
+        return &this->messages_[i];
+      }
+    }
+  }
+  return nullptr;
+}
+
+void MQTTPublishQueue::pop() {
+  if (this->front_ < this->messages_.size())
+    this->erase_(this->front_);
+  this->front_ = SIZE_MAX;
+}
+
+void MQTTPublishQueue::clear() {
+  this->messages_.clear();
+  this->bytes_ = 0;
+  this->front_ = SIZE_MAX;
+  memset(this->pending_, 0, sizeof(this->pending_));
+}
+
+void MQTTPublishQueue::erase_(size_t index) {
+  const Message &message = this->messages_[index];
+  this->bytes_ -= message_bytes_(message);
+  this->pending_[static_cast<uint8_t>(message.priority)]--;
+  this->messages_.erase(this->messages_.begin() + index);
+  // keep front_ on the same message, a push() while it's being sent may drop others
+  if (index == this->front_) {
+    this->front_ = SIZE_MAX;
+  } else if (index < this->front_ && this->front_ != SIZE_MAX) {
+    this->front_--;
+  }
+}
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MQTT
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+/// Priority of an outgoing message, lower values are sent first.
+enum class MQTTPublishPriority : uint8_t {
+  STATE = 0,
+  DISCOVERY = 1,
+  LOG = 2,
+};
+
+/** Bounded queue for the messages that couldn't be handed to the MQTT backend right away.
+ *
+ * Messages are sent by priority, and in the order they were queued within a priority. The size of the queue is
+ * limited by the bytes of the topics and payloads. When it's full, the newest messages with a lower priority are
+ * dropped to make room; if that can't make enough room, only the new message is dropped. A state message for a topic
+ * that is already queued replaces the payload of the queued one, as only the latest state matters, within the same
+ * limit.
+ */
+class MQTTPublishQueue {
+ public:
+  struct Message {
+    std::string topic;
+    std::string payload;
+    uint8_t qos;
+    bool retain;
+    MQTTPublishPriority priority;
+    /// millis() when the message was queued.
+    uint32_t queued_at;
+  };
+
+  /// Limit the topics and payloads of the queued messages to \p max_bytes.
+  void set_max_bytes(size_t max_bytes) { this->max_bytes_ = max_bytes; }
+
+  /// Queue a message, return false if it was dropped.
+  bool push(const char *topic, const char *payload, size_t payload_length, uint8_t qos, bool retain,
+            MQTTPublishPriority priority, uint32_t now);
+  /// Whether a message with at least \p priority is queued, newer messages must not overtake it.
+  bool has_pending(MQTTPublishPriority priority) const;
+  /// Get the next message to send, nullptr if the queue is empty.
+  const Message *front();
+  /// Remove the message returned by front(), unless it has been dropped since.
+  void pop();
+  /// Remove all messages, without counting them as dropped.
+  void clear();
+
+  size_t size() const { return this->messages_.size(); }
+  bool empty() const { return this->messages_.empty(); }
+  /// Number of messages dropped because the queue was full, since boot.
+  uint32_t get_dropped() const { return this->dropped_; }
+
+ protected:
+  static size_t message_bytes_(const Message &message) { return message.topic.size() + message.payload.size(); }
+  /// Drop messages with a lower priority than \p priority until \p needed more bytes fit, false if they can't.
+  bool make_room_(size_t needed, MQTTPublishPriority priority);
+  void erase_(size_t index);
+
+  /// Messages in the order they were queued.
+  std::vector<Message> messages_;
+  size_t max_bytes_{8192};
+  size_t bytes_{0};
+  uint32_t dropped_{0};
+  /// Index of the message returned by front(), SIZE_MAX if there is none.
+  size_t front_{SIZE_MAX};
+  /// Number of queued messages per priority.
+  uint16_t pending_[3]{};
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
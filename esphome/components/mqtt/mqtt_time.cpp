@@ -54,7 +54,7 @@ bool MQTTTimeComponent::send_initial_state() {
   }
 }
 bool MQTTTimeComponent::publish_state(uint8_t hour, uint8_t minute, uint8_t second) {
-  return this->publish_json(this->get_state_topic_(), [hour, minute, second](JsonObject root) {
+  return this->publish_json(this->get_state_topic_(), [hour, minute, second](json::JsonWriter &root) {
     root["hour"] = hour;
     root["minute"] = minute;
     root["second"] = second;
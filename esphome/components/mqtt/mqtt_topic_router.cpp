@@ -0,0 +1,200 @@
+#include "mqtt_topic_router.h"
+
+#ifdef USE_MQTT
+
+#include <algorithm>
+#include <cstring>
+
+namespace esphome {
+namespace mqtt {
+
+/** Check if the message topic matches the given subscription topic
+ *
+ * INFO: MQTT spec mandates that topics must not be empty and must be valid NULL-terminated UTF-8 strings.
+ *
+ * @param message The message topic that was received from the MQTT server. Note: this must not contain
+ *                wildcard characters as mandated by the MQTT spec.
+ * @param subscription The subscription topic we are matching against.
+ * @param is_normal Is this a "normal" topic - Does the message topic not begin with a "$".
+ * @param past_separator Are we past the first '/' topic separator.
+ * @return true if the subscription topic matches the message topic, false otherwise.
+ */
+static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
+  // Reached end of both strings at the same time, this means we have a successful match
+  if (*message == '\0' && *subscription == '\0')
+    return true;
+
+  // Either the message or the subscribe are at the end. This means they don't match.
+  if (*message == '\0' || *subscription == '\0')
+    return false;
+
+  bool do_wildcards = is_normal || past_separator;
+
+  if (*subscription == '+' && do_wildcards) {
+    // single level wildcard
+    // consume + from subscription
+    subscription++;
+    // consume everything from message until '/' found or end of string
+    while (*message != '\0' && *message != '/') {
+      message++;
+    }
+    // after this, both pointers will point to a '/' or to the end of the string
+
+    return topic_match(message, subscription, is_normal, true);
+  }
+
+  if (*subscription == '#' && do_wildcards) {
+    // multilevel wildcard - MQTT mandates that this must be at end of subscribe topic
+    return true;
+  }
+
+  // this handles '/' and normal characters at the same time.
+  if (*message != *subscription)
+    return false;
+
+  past_separator = past_separator || *subscription == '/';
+
+  // consume characters
+  subscription++;
+  message++;
+
+  return topic_match(message, subscription, is_normal, past_separator);
+}
+
+static bool topic_match(const char *message, const char *subscription) {
+  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
+}
+
+/// Compare two topic levels, ordering by length first.
+static int compare_level(const char *a, size_t a_len, const char *b, size_t b_len) {
+  if (a_len != b_len)
+    return a_len < b_len ? -1 : 1;
+  return memcmp(a, b, a_len);
+}
+
+void MQTTTopicRouter::clear() {
+  this->nodes_.clear();
+  this->fallback_.clear();
+}
+
+uint16_t MQTTTopicRouter::add_node_(const char *level, uint16_t level_len) {
+  if (this->nodes_.size() >= NONE)
+    return NONE;
+  this->nodes_.push_back(Node{level, level_len, NONE, {}, {}, {}});
+  return this->nodes_.size() - 1;
+}
+
+uint16_t MQTTTopicRouter::find_child_(uint16_t node, const char *level, size_t level_len, bool insert) {
+  auto &children = this->nodes_[node].children;
+  auto it = std::lower_bound(children.begin(), children.end(), 0, [&](uint16_t child, int) {
+    const Node &n = this->nodes_[child];
+    return compare_level(n.level, n.level_len, level, level_len) < 0;
+  });
+  if (it != children.end()) {
+    const Node &n = this->nodes_[*it];
+    if (compare_level(n.level, n.level_len, level, level_len) == 0)
+      return *it;
+  }
+  if (!insert)
+    return NONE;
+  size_t position = it - children.begin();
+  uint16_t child = this->add_node_(level, level_len);
+  if (child == NONE)
+    return NONE;
+  // add_node_() may have moved the nodes
+  auto &new_children = this->nodes_[node].children;
+  new_children.insert(new_children.begin() + position, child);
+  return child;
+}
+
+void MQTTTopicRouter::add(size_t index, const char *topic) {
+  // Wildcards must take up a whole level, and '#' must be the last one. Keep any other topic, or one too long for
+  // the level lengths, aside.
+  bool valid = *topic != '\0' && strlen(topic) <= UINT16_MAX;
+  for (const char *c = topic; valid && *c != '\0'; c++) {
+    if (*c != '+' && *c != '#')
+      continue;
+    bool level_start = c == topic || c[-1] == '/';
+    bool level_end = c[1] == '\0' || (c[1] == '/' && *c == '+');
+    valid = level_start && level_end;
+  }
+  if (!valid) {
+    this->fallback_.push_back(Fallback{index, topic});
+    return;
+  }
+
+  if (this->nodes_.empty())
+    this->add_node_(nullptr, 0);
+  uint16_t node = 0;
+  const char *level = topic;
+  while (true) {
+    const char *end = strchr(level, '/');
+    size_t len = end == nullptr ? strlen(level) : end - level;
+    if (len == 1 && *level == '#') {
+      this->nodes_[node].hash_subscriptions.push_back(index);
+      return;
+    }
+    if (len == 1 && *level == '+') {
+      if (this->nodes_[node].plus_child == NONE) {
+        uint16_t child = this->add_node_(level, 1);
+        this->nodes_[node].plus_child = child;
+      }
+      node = this->nodes_[node].plus_child;
+    } else {
+      node = this->find_child_(node, level, len, true);
+    }
+    if (node == NONE) {
+      // Out of node indices. The nodes added so far stay without subscriptions, so they never match.
+      this->fallback_.push_back(Fallback{index, topic});
+      return;
+    }
+    if (end == nullptr) {
+      this->nodes_[node].subscriptions.push_back(index);
+      return;
+    }
+    level = end + 1;
+  }
+}
+
+void MQTTTopicRouter::match_(uint16_t node, const char *level, bool wildcards) {
+  const Node &n = this->nodes_[node];
+  // Like topic_match(), wildcards only match if there is something left of the topic
+  bool rest = *level != '\0';
+  if (wildcards && rest)
+    this->matches_.insert(this->matches_.end(), n.hash_subscriptions.begin(), n.hash_subscriptions.end());
+
+  const char *end = level;
+  while (*end != '\0' && *end != '/')
+    end++;
+
+  uint16_t children[2] = {this->find_child_(node, level, end - level, false),
+                          wildcards && rest ? n.plus_child : NONE};
+  for (uint16_t child : children) {
+    if (child == NONE)
+      continue;
+    if (*end == '\0') {
+      const auto &subscriptions = this->nodes_[child].subscriptions;
+      this->matches_.insert(this->matches_.end(), subscriptions.begin(), subscriptions.end());
+    } else {
+      this->match_(child, end + 1, true);
+    }
+  }
+}
+
+const std::vector<size_t> &MQTTTopicRouter::match(const char *topic) {
+  this->matches_.clear();
+  if (!this->nodes_.empty() && *topic != '\0')
+    this->match_(0, topic, *topic != '$');
+  for (auto &fallback : this->fallback_) {
+    if (topic_match(topic, fallback.topic))
+      this->matches_.push_back(fallback.index);
+  }
+  // call the subscriptions in the order they were made, like before
+  std::sort(this->matches_.begin(), this->matches_.end());
+  return this->matches_;
+}
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
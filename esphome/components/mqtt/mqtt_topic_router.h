@@ -0,0 +1,69 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MQTT
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+/** Finds the subscriptions matching a received topic using a trie of topic levels.
+ *
+ * Every subscription topic is split at '/' into levels that form a path from the root of the trie; `+` levels get
+ * their own child and `#` levels are stored on their parent. A received topic is then matched in one walk over its
+ * levels, with a binary search over the children at each level, instead of comparing it to every subscription.
+ *
+ * The trie only points into the subscription topics, so it has to be rebuilt whenever they change. Subscription
+ * topics with wildcards that don't take up a whole level are not valid MQTT; these are kept aside and compared one by
+ * one, as before. The same happens to any topic that doesn't fit once the trie has run out of node indices.
+ */
+class MQTTTopicRouter {
+ public:
+  /// Remove all subscriptions.
+  void clear();
+  /// Add subscription \p index with the null terminated \p topic, which has to stay valid until the next clear().
+  void add(size_t index, const char *topic);
+  /// Get the indices of the subscriptions matching \p topic in ascending order, valid until the next call.
+  const std::vector<size_t> &match(const char *topic);
+
+ protected:
+  /// Node index meaning "no node"; this also limits the trie to NONE nodes.
+  static constexpr uint16_t NONE = UINT16_MAX;
+
+  struct Node {
+    const char *level;
+    uint16_t level_len;
+    /// Child for a `+` level.
+    uint16_t plus_child;
+    /// Children for the literal levels, sorted by their level.
+    std::vector<uint16_t> children;
+    /// Subscriptions that end at this node.
+    std::vector<size_t> subscriptions;
+    /// Subscriptions with a `#` level following this node.
+    std::vector<size_t> hash_subscriptions;
+  };
+
+  /// Add a node for \p level, or return NONE if the trie is full.
+  uint16_t add_node_(const char *level, uint16_t level_len);
+  /// Find the literal child of \p node for \p level, with \p insert add it if it doesn't exist yet (NONE if full).
+  uint16_t find_child_(uint16_t node, const char *level, size_t level_len, bool insert);
+  /// Match the levels of the topic starting at \p level against the children of \p node.
+  void match_(uint16_t node, const char *level, bool wildcards);
+
+  std::vector<Node> nodes_;
+  struct Fallback {
+    size_t index;
+    const char *topic;
+  };
+  std::vector<Fallback> fallback_;
+  std::vector<size_t> matches_;
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -0,0 +1,58 @@
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import (
+    CONF_MQTT_ID,
+    CONF_UPDATE_INTERVAL,
+    ENTITY_CATEGORY_DIAGNOSTIC,
+    ICON_COUNTER,
+    ICON_TIMER,
+    STATE_CLASS_TOTAL_INCREASING,
+    UNIT_MILLISECOND,
+)
+from . import MQTTClientComponent
+
+DEPENDENCIES = ["mqtt"]
+
+CONF_QUEUE_DEPTH = "queue_depth"
+CONF_DROPPED = "dropped"
+CONF_LATENCY = "latency"
+
+CONFIG_SCHEMA = {
+    cv.GenerateID(CONF_MQTT_ID): cv.use_id(MQTTClientComponent),
+    cv.Optional(CONF_QUEUE_DEPTH): sensor.sensor_schema(
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_DROPPED): sensor.sensor_schema(
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_LATENCY): sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        icon=ICON_TIMER,
+        accuracy_decimals=0,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+    cv.Optional(CONF_UPDATE_INTERVAL, default="60s"): cv.update_interval,
+}
+
+
+async def to_code(config):
+    mqtt_client = await cg.get_variable(config[CONF_MQTT_ID])
+    cg.add(mqtt_client.set_publish_stats_interval(config[CONF_UPDATE_INTERVAL]))
+
+    if queue_depth_conf := config.get(CONF_QUEUE_DEPTH):
+        sens = await sensor.new_sensor(queue_depth_conf)
+        cg.add(mqtt_client.set_queue_depth_sensor(sens))
+
+    if dropped_conf := config.get(CONF_DROPPED):
+        sens = await sensor.new_sensor(dropped_conf)
+        cg.add(mqtt_client.set_dropped_sensor(sens))
+
+    if latency_conf := config.get(CONF_LATENCY):
+        sens = await sensor.new_sensor(latency_conf)
+        cg.add(mqtt_client.set_latency_sensor(sens))
@@ -82,6 +82,11 @@ class NeoPixelBusLightOutputBase : public light::AddressableLight {
   }
 
   void write_state(light::LightState *state) override {
+    // NeoPixelBus sends the previous frame in the background, try again next loop instead of waiting for it
+    if (!this->controller_->CanShow()) {
+      this->schedule_show();
+      return;
+    }
     this->mark_shown_();
     this->controller_->Dirty();
 
@@ -121,6 +126,10 @@ class NeoPixelRGBLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_COL
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                nullptr, this->effect_data_ + index, &this->correction_);
   }
+  bool get_pixel_layout_(light::AddressableLight::PixelLayout *layout) const override {
+    *layout = {this->controller_->Pixels(), 3, this->rgb_offsets_[0], this->rgb_offsets_[1], this->rgb_offsets_[2], -1};
+    return true;
+  }
 };
 
 template<typename T_METHOD, typename T_COLOR_FEATURE = NeoRgbwFeature>
@@ -138,6 +147,11 @@ class NeoPixelRGBWLightOutput : public NeoPixelBusLightOutputBase<T_METHOD, T_CO
     return light::ESPColorView(base + this->rgb_offsets_[0], base + this->rgb_offsets_[1], base + this->rgb_offsets_[2],
                                base + this->rgb_offsets_[3], this->effect_data_ + index, &this->correction_);
   }
+  bool get_pixel_layout_(light::AddressableLight::PixelLayout *layout) const override {
+    *layout = {this->controller_->Pixels(), 4, this->rgb_offsets_[0], this->rgb_offsets_[1], this->rgb_offsets_[2],
+               (int8_t) this->rgb_offsets_[3]};
+    return true;
+  }
 };
 
 }  // namespace neopixelbus
@@ -47,7 +47,7 @@ std::unique_ptr<OTABackend> make_ota_backend() {
 OTAComponent::OTAComponent() { global_ota_component = this; }
 
 void OTAComponent::setup() {
-  server_ = socket::socket_ip(SOCK_STREAM, 0);
+  server_ = socket::socket_ip_loop_monitored(SOCK_STREAM, 0);
   if (server_ == nullptr) {
     ESP_LOGW(TAG, "Could not create socket.");
     this->mark_failed();
@@ -119,6 +119,13 @@ void OTAComponent::loop() {
   }
 }
 
+uint32_t OTAComponent::get_idle_loop_interval() {
+  // a connecting client wakes the loop through the monitored server socket
+  if (this->client_ == nullptr && this->server_ != nullptr && this->server_->is_loop_monitored())
+    return UINT32_MAX;
+  return 0;
+}
+
 static const uint8_t FEATURE_SUPPORTS_COMPRESSION = 0x01;
 
 void OTAComponent::handle_() {
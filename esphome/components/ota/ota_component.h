@@ -67,6 +67,7 @@ class OTAComponent : public Component {
   void dump_config() override;
   float get_setup_priority() const override;
   void loop() override;
+  uint32_t get_idle_loop_interval() override;
 
   uint16_t get_port() const;
 
@@ -49,6 +49,16 @@ void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
     this->lock_row_(stream, obj);
 #endif
 
+#ifdef USE_LOOP_PROFILER
+  this->loop_profile_type_(stream);
+  uint32_t index = 0;
+  for (auto *obj : App.get_components()) {
+    this->loop_profile_row_(stream, obj, index, "loop", obj->get_loop_profile());
+    this->loop_profile_row_(stream, obj, index, "scheduler", obj->get_scheduler_profile());
+    index++;
+  }
+#endif
+
   req->send(stream);
 }
 
@@ -348,5 +358,35 @@ void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj)
 }
 #endif
 
+#ifdef USE_LOOP_PROFILER
+void PrometheusHandler::loop_profile_type_(AsyncResponseStream *stream) {
+  stream->print(F("#TYPE esphome_loop_count COUNTER\n"));
+  stream->print(F("#TYPE esphome_loop_avg_us GAUGE\n"));
+  stream->print(F("#TYPE esphome_loop_max_us GAUGE\n"));
+  stream->print(F("#TYPE esphome_loop_p99_us GAUGE\n"));
+}
+void PrometheusHandler::loop_profile_row_(AsyncResponseStream *stream, Component *obj, uint32_t index,
+                                          const char *kind, const LoopProfile &profile) {
+  if (profile.get_count() == 0)
+    return;
+  const char *const names[] = {"esphome_loop_count", "esphome_loop_avg_us", "esphome_loop_max_us",
+                               "esphome_loop_p99_us"};
+  const uint32_t values[] = {profile.get_count(), profile.get_avg_us(), profile.get_max_us(),
+                             profile.get_percentile_us(99)};
+  for (uint8_t i = 0; i < 4; i++) {
+    stream->print(names[i]);
+    stream->print(F("{component=\""));
+    stream->print(obj->get_component_source());
+    stream->print(F("\",index=\""));
+    stream->print(index);
+    stream->print(F("\",kind=\""));
+    stream->print(kind);
+    stream->print(F("\"} "));
+    stream->print(values[i]);
+    stream->print(F("\n"));
+  }
+}
+#endif
+
 }  // namespace prometheus
 }  // namespace esphome
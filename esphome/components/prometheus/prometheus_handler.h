@@ -7,6 +7,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/controller.h"
 #include "esphome/core/entity_base.h"
+#include "esphome/core/loop_profile.h"
 
 namespace esphome {
 namespace prometheus {
@@ -109,6 +110,14 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
   void lock_row_(AsyncResponseStream *stream, lock::Lock *obj);
 #endif
 
+#ifdef USE_LOOP_PROFILER
+  /// Return the type for prometheus
+  void loop_profile_type_(AsyncResponseStream *stream);
+  /// Return the main loop timing statistics of a component as prometheus data points
+  void loop_profile_row_(AsyncResponseStream *stream, Component *obj, uint32_t index, const char *kind,
+                         const LoopProfile &profile);
+#endif
+
   web_server_base::WebServerBase *base_;
   bool include_internal_{false};
   std::map<EntityBase *, std::string> relabel_map_id_;
@@ -26,23 +26,23 @@ void QspiAmoLed::setup() {
 
 void QspiAmoLed::update() {
   this->do_update_();
-  int w = this->x_high_ - this->x_low_ + 1;
-  int h = this->y_high_ - this->y_low_ + 1;
-  this->draw_pixels_at(this->x_low_, this->y_low_, w, h, this->buffer_, this->color_mode_, display::COLOR_BITNESS_565,
-                       true, this->x_low_, this->y_low_, this->get_width_internal() - w - this->x_low_);
-  // invalidate watermarks
-  this->x_low_ = this->width_;
-  this->y_low_ = this->height_;
-  this->x_high_ = 0;
-  this->y_high_ = 0;
+  this->flush_dirty_regions_();
+}
+
+void QspiAmoLed::flush_region_(const display::Rect &region) {
+  this->draw_pixels_at(region.x, region.y, region.w, region.h, this->buffer_, this->color_mode_,
+                       display::COLOR_BITNESS_565, true, region.x, region.y,
+                       this->get_width_internal() - region.w - region.x);
 }
 
 void QspiAmoLed::draw_absolute_pixel_internal(int x, int y, Color color) {
   if (x >= this->get_width_internal() || x < 0 || y >= this->get_height_internal() || y < 0) {
     return;
   }
-  if (this->buffer_ == nullptr)
+  if (this->buffer_ == nullptr) {
     this->init_internal_(this->width_ * this->height_ * 2);
+    this->init_tile_checksums_(2);
+  }
   if (this->is_failed())
     return;
   uint32_t pos = (y * this->width_) + x;
@@ -61,17 +61,8 @@ void QspiAmoLed::draw_absolute_pixel_internal(int x, int y, Color color) {
     this->buffer_[pos] = new_color;
     updated = true;
   }
-  if (updated) {
-    // low and high watermark may speed up drawing from buffer
-    if (x < this->x_low_)
-      this->x_low_ = x;
-    if (y < this->y_low_)
-      this->y_low_ = y;
-    if (x > this->x_high_)
-      this->x_high_ = x;
-    if (y > this->y_high_)
-      this->y_high_ = y;
-  }
+  if (updated)
+    this->mark_dirty_(x, y);
 }
 
 void QspiAmoLed::reset_params_(bool ready) {
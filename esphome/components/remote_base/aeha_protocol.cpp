@@ -41,6 +41,7 @@ void AEHAProtocol::encode(RemoteTransmitData *dst, const AEHAData &data) {
 
   dst->mark(TRAILER);
 }
+RemoteSignature AEHAProtocol::signature() const { return {HEADER_HIGH_US, HEADER_LOW_US}; }
 optional<AEHAData> AEHAProtocol::decode(RemoteReceiveData src) {
   AEHAData out{
       .address = 0,
@@ -47,6 +47,7 @@ void DishProtocol::encode(RemoteTransmitData *dst, const DishData &data) {
     dst->item(HEADER_HIGH_US, HEADER_LOW_US);
   }
 }
+RemoteSignature DishProtocol::signature() const { return {HEADER_HIGH_US, HEADER_LOW_US}; }
 optional<DishData> DishProtocol::decode(RemoteReceiveData src) {
   DishData data{
       .address = 0,
@@ -17,6 +17,7 @@ class DishProtocol : public RemoteProtocol<DishData> {
   void encode(RemoteTransmitData *dst, const DishData &data) override;
   optional<DishData> decode(RemoteReceiveData src) override;
   void dump(const DishData &data) override;
+  RemoteSignature signature() const override;
 };
 
 DECLARE_REMOTE_PROTOCOL(Dish)
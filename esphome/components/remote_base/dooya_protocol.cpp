@@ -51,6 +51,7 @@ void DooyaProtocol::encode(RemoteTransmitData *dst, const DooyaData &data) {
     }
   }
 }
+RemoteSignature DooyaProtocol::signature() const { return {HEADER_HIGH_US, HEADER_LOW_US}; }
 optional<DooyaData> DooyaProtocol::decode(RemoteReceiveData src) {
   DooyaData out{
       .id = 0,
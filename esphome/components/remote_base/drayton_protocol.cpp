@@ -128,6 +128,7 @@ void DraytonProtocol::encode(RemoteTransmitData *dst, const DraytonData &data) {
   }
 }
 
+RemoteSignature DraytonProtocol::signature() const { return {0, 0, MIN_RX_SRC}; }
 optional<DraytonData> DraytonProtocol::decode(RemoteReceiveData src) {
   DraytonData out{
       .address = 0,
@@ -23,6 +23,7 @@ class DraytonProtocol : public RemoteProtocol<DraytonData> {
   void encode(RemoteTransmitData *dst, const DraytonData &data) override;
   optional<DraytonData> decode(RemoteReceiveData src) override;
   void dump(const DraytonData &data) override;
+  RemoteSignature signature() const override;
 };
 
 DECLARE_REMOTE_PROTOCOL(Drayton)
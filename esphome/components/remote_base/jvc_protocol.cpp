@@ -29,6 +29,7 @@ void JVCProtocol::encode(RemoteTransmitData *dst, const JVCData &data) {
 
   dst->mark(BIT_HIGH_US);
 }
+RemoteSignature JVCProtocol::signature() const { return {HEADER_HIGH_US, HEADER_LOW_US, 2 + 2 * NBITS}; }
 optional<JVCData> JVCProtocol::decode(RemoteReceiveData src) {
   JVCData out{.data = 0};
   if (!src.expect_item(HEADER_HIGH_US, HEADER_LOW_US))
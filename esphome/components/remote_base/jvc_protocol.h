@@ -18,6 +18,7 @@ class JVCProtocol : public RemoteProtocol<JVCData> {
   void encode(RemoteTransmitData *dst, const JVCData &data) override;
   optional<JVCData> decode(RemoteReceiveData src) override;
   void dump(const JVCData &data) override;
+  RemoteSignature signature() const override;
 };
 
 DECLARE_REMOTE_PROTOCOL(JVC)
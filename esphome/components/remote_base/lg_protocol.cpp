@@ -28,6 +28,7 @@ void LGProtocol::encode(RemoteTransmitData *dst, const LGData &data) {
 
   dst->mark(BIT_HIGH_US);
 }
+RemoteSignature LGProtocol::signature() const { return {HEADER_HIGH_US, HEADER_LOW_US, 2 + 2 * 28}; }
 optional<LGData> LGProtocol::decode(RemoteReceiveData src) {
   LGData out{
       .data = 0,
@@ -61,6 +61,7 @@ static bool decode_data(RemoteReceiveData &src, MideaData &dst) {
   return true;
 }
 
+RemoteSignature MideaProtocol::signature() const { return {HEADER_MARK_US, HEADER_SPACE_US}; }
 optional<MideaData> MideaProtocol::decode(RemoteReceiveData src) {
   MideaData out, inv;
   if (src.expect_item(HEADER_MARK_US, HEADER_SPACE_US) && decode_data(src, out) && out.is_valid() &&
@@ -41,6 +41,7 @@ void NECProtocol::encode(RemoteTransmitData *dst, const NECData &data) {
 
   dst->mark(BIT_HIGH_US);
 }
+RemoteSignature NECProtocol::signature() const { return {HEADER_HIGH_US, HEADER_LOW_US, 2 + 2 * 32}; }
 optional<NECData> NECProtocol::decode(RemoteReceiveData src) {
   NECData data{
       .address = 0,
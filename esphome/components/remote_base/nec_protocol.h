@@ -18,6 +18,7 @@ class NECProtocol : public RemoteProtocol<NECData> {
   void encode(RemoteTransmitData *dst, const NECData &data) override;
   optional<NECData> decode(RemoteReceiveData src) override;
   void dump(const NECData &data) override;
+  RemoteSignature signature() const override;
 };
 
 DECLARE_REMOTE_PROTOCOL(NEC)
@@ -35,6 +35,7 @@ void PanasonicProtocol::encode(RemoteTransmitData *dst, const PanasonicData &dat
   }
   dst->mark(BIT_HIGH_US);
 }
+RemoteSignature PanasonicProtocol::signature() const { return {HEADER_HIGH_US, HEADER_LOW_US, 2 + 2 * 48}; }
 optional<PanasonicData> PanasonicProtocol::decode(RemoteReceiveData src) {
   PanasonicData out{
       .address = 0,
@@ -20,6 +20,7 @@ class PanasonicProtocol : public RemoteProtocol<PanasonicData> {
   void encode(RemoteTransmitData *dst, const PanasonicData &data) override;
   optional<PanasonicData> decode(RemoteReceiveData src) override;
   void dump(const PanasonicData &data) override;
+  RemoteSignature signature() const override;
 };
 
 DECLARE_REMOTE_PROTOCOL(Panasonic)
@@ -91,6 +91,7 @@ void PioneerProtocol::encode(RemoteTransmitData *dst, const PioneerData &data) {
     dst->mark(BIT_HIGH_US);
   }
 }
+RemoteSignature PioneerProtocol::signature() const { return {HEADER_HIGH_US, HEADER_LOW_US, 2 + 2 * 32}; }
 optional<PioneerData> PioneerProtocol::decode(RemoteReceiveData src) {
   uint16_t address1 = 0;
   uint16_t command1 = 0;
@@ -19,6 +19,7 @@ class RC6Protocol : public RemoteProtocol<RC6Data> {
   void encode(RemoteTransmitData *dst, const RC6Data &data) override;
   optional<RC6Data> decode(RemoteReceiveData src) override;
   void dump(const RC6Data &data) override;
+  RemoteSignature signature() const override;
 };
 
 DECLARE_REMOTE_PROTOCOL(RC6)
@@ -39,6 +39,9 @@ class RCSwitchBase {
 
   optional<RCSwitchData> decode(RemoteReceiveData &src) const;
 
+  /// Any frame with a code of at least 8 bits, the sync is optional.
+  RemoteSignature signature() const { return {0, 0, 16}; }
+
   static void simple_code_to_tristate(uint16_t code, uint8_t nbits, uint64_t *out_code);
 
   static void type_a_code(uint8_t switch_group, uint8_t switch_device, bool state, uint64_t *out_code,
@@ -213,6 +216,7 @@ class RCSwitchRawReceiver : public RemoteReceiverBinarySensorBase {
 class RCSwitchDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override;
+  RemoteSignature get_signature() const override { return RCSwitchBase().signature(); }
 };
 
 using RCSwitchTrigger = RemoteReceiverTrigger<RCSwitchBase>;
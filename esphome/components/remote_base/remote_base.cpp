@@ -85,6 +85,14 @@ bool RemoteReceiveData::expect_pulse_with_gap(uint32_t mark, uint32_t space) {
   return true;
 }
 
+bool RemoteReceiveData::matches(const RemoteSignature &signature) const {
+  if (this->data_.size() < signature.min_size)
+    return false;
+  if (signature.leader_mark != 0 && !this->peek_mark(signature.leader_mark))
+    return false;
+  return signature.leader_space == 0 || this->peek_space(signature.leader_space, 1);
+}
+
 /* RemoteReceiverBinarySensorBase */
 
 bool RemoteReceiverBinarySensorBase::on_receive(RemoteReceiveData src) {
@@ -100,26 +108,33 @@ bool RemoteReceiverBinarySensorBase::on_receive(RemoteReceiveData src) {
 
 void RemoteReceiverBase::register_dumper(RemoteReceiverDumperBase *dumper) {
   if (dumper->is_secondary()) {
-    this->secondary_dumpers_.push_back(dumper);
+    this->secondary_dumpers_.push_back({dumper, dumper->get_signature()});
   } else {
-    this->dumpers_.push_back(dumper);
+    this->dumpers_.push_back({dumper, dumper->get_signature()});
   }
 }
 
 void RemoteReceiverBase::call_listeners_() {
-  for (auto *listener : this->listeners_)
-    listener->on_receive(RemoteReceiveData(this->temp_, this->tolerance_));
+  // only hand the frame to the decoders whose protocol can start like it
+  const RemoteReceiveData src(this->temp_, this->tolerance_);
+  for (auto &listener : this->listeners_) {
+    if (src.matches(listener.signature))
+      listener.handler->on_receive(src);
+  }
 }
 
 void RemoteReceiverBase::call_dumpers_() {
+  const RemoteReceiveData src(this->temp_, this->tolerance_);
   bool success = false;
-  for (auto *dumper : this->dumpers_) {
-    if (dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_)))
+  for (auto &dumper : this->dumpers_) {
+    if (src.matches(dumper.signature) && dumper.handler->dump(src))
       success = true;
   }
   if (!success) {
-    for (auto *dumper : this->secondary_dumpers_)
-      dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_));
+    for (auto &dumper : this->secondary_dumpers_) {
+      if (src.matches(dumper.signature))
+        dumper.handler->dump(src);
+    }
   }
 }
 
@@ -17,6 +17,45 @@ namespace remote_base {
 
 using RawTimings = std::vector<int32_t>;
 
+/** Received mark (positive) and space (negative) lengths in microseconds, stored in 16 bits each.
+ *
+ * Takes half the memory of RawTimings. Lengths are capped at MAX_LENGTH, which is longer than any length a decoder
+ * checks for; only the gap that ends a frame can exceed it, when the idle time is set above it.
+ */
+class PackedTimings {
+ public:
+  static constexpr int32_t MAX_LENGTH = INT16_MAX;
+
+  void reserve(size_t count) { this->data_.reserve(count); }
+  void clear() { this->data_.clear(); }
+  void push_back(int32_t length) {
+    // clamp() takes references, so pass a copy rather than ODR-using MAX_LENGTH before C++17
+    const int32_t max = MAX_LENGTH;
+    this->data_.push_back(clamp(length, -max, max));
+  }
+  bool empty() const { return this->data_.empty(); }
+  size_t size() const { return this->data_.size(); }
+  int32_t operator[](size_t index) const { return this->data_[index]; }
+  /// Copy the lengths into a RawTimings, e.g. to pass them to a trigger.
+  RawTimings unpack() const { return RawTimings(this->data_.begin(), this->data_.end()); }
+
+ protected:
+  std::vector<int16_t> data_;
+};
+
+/** What every frame of a protocol starts with, so the receiver can skip decoders that can't match a frame.
+ *
+ * It must not be stricter than the decoder itself; zero means anything matches.
+ */
+struct RemoteSignature {
+  /// Length of the first mark.
+  uint32_t leader_mark{0};
+  /// Length of the first space.
+  uint32_t leader_space{0};
+  /// Fewest marks and spaces of a frame.
+  uint32_t min_size{0};
+};
+
 class RemoteTransmitData {
  public:
   void mark(uint32_t length) { this->data_.push_back(length); }
@@ -42,10 +81,10 @@ class RemoteTransmitData {
 
 class RemoteReceiveData {
  public:
-  explicit RemoteReceiveData(const RawTimings &data, uint8_t tolerance)
+  explicit RemoteReceiveData(const PackedTimings &data, uint8_t tolerance)
       : data_(data), index_(0), tolerance_(tolerance) {}
 
-  const RawTimings &get_raw_data() const { return this->data_; }
+  const PackedTimings &get_raw_data() const { return this->data_; }
   uint32_t get_index() const { return index_; }
   int32_t operator[](uint32_t index) const { return this->data_[index]; }
   int32_t size() const { return this->data_.size(); }
@@ -62,6 +101,8 @@ class RemoteReceiveData {
   bool expect_space(uint32_t length);
   bool expect_item(uint32_t mark, uint32_t space);
   bool expect_pulse_with_gap(uint32_t mark, uint32_t space);
+  /// Whether the frame, from its start, could belong to a protocol with the given \p signature.
+  bool matches(const RemoteSignature &signature) const;
   void advance(uint32_t amount = 1) { this->index_ += amount; }
   void reset() { this->index_ = 0; }
 
@@ -69,7 +110,7 @@ class RemoteReceiveData {
   int32_t lower_bound_(uint32_t length) const { return int32_t(100 - this->tolerance_) * length / 100U; }
   int32_t upper_bound_(uint32_t length) const { return int32_t(100 + this->tolerance_) * length / 100U; }
 
-  const RawTimings &data_;
+  const PackedTimings &data_;
   uint32_t index_;
   uint8_t tolerance_;
 };
@@ -149,18 +190,22 @@ class RemoteTransmitterBase : public RemoteComponentBase {
 class RemoteReceiverListener {
  public:
   virtual bool on_receive(RemoteReceiveData data) = 0;
+  virtual RemoteSignature get_signature() const { return {}; }
 };
 
 class RemoteReceiverDumperBase {
  public:
   virtual bool dump(RemoteReceiveData src) = 0;
   virtual bool is_secondary() { return false; }
+  virtual RemoteSignature get_signature() const { return {}; }
 };
 
 class RemoteReceiverBase : public RemoteComponentBase {
  public:
   RemoteReceiverBase(InternalGPIOPin *pin) : RemoteComponentBase(pin) {}
-  void register_listener(RemoteReceiverListener *listener) { this->listeners_.push_back(listener); }
+  void register_listener(RemoteReceiverListener *listener) {
+    this->listeners_.push_back({listener, listener->get_signature()});
+  }
   void register_dumper(RemoteReceiverDumperBase *dumper);
   void set_tolerance(uint8_t tolerance) { tolerance_ = tolerance; }
 
@@ -172,10 +217,16 @@ class RemoteReceiverBase : public RemoteComponentBase {
     this->call_dumpers_();
   }
 
-  std::vector<RemoteReceiverListener *> listeners_;
-  std::vector<RemoteReceiverDumperBase *> dumpers_;
-  std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
-  RawTimings temp_;
+  /// A registered listener or dumper, with the signature of its protocol looked up once.
+  template<typename T> struct Registered {
+    T *handler;
+    RemoteSignature signature;
+  };
+
+  std::vector<Registered<RemoteReceiverListener>> listeners_;
+  std::vector<Registered<RemoteReceiverDumperBase>> dumpers_;
+  std::vector<Registered<RemoteReceiverDumperBase>> secondary_dumpers_;
+  PackedTimings temp_;
   uint8_t tolerance_;
 };
 
@@ -197,11 +248,13 @@ template<typename T> class RemoteProtocol {
   virtual void encode(RemoteTransmitData *dst, const ProtocolData &data) = 0;
   virtual optional<ProtocolData> decode(RemoteReceiveData src) = 0;
   virtual void dump(const ProtocolData &data) = 0;
+  virtual RemoteSignature signature() const { return {}; }
 };
 
 template<typename T> class RemoteReceiverBinarySensor : public RemoteReceiverBinarySensorBase {
  public:
   RemoteReceiverBinarySensor() : RemoteReceiverBinarySensorBase() {}
+  RemoteSignature get_signature() const override { return T().signature(); }
 
  protected:
   bool matches(RemoteReceiveData src) override {
@@ -219,6 +272,9 @@ template<typename T> class RemoteReceiverBinarySensor : public RemoteReceiverBin
 
 template<typename T>
 class RemoteReceiverTrigger : public Trigger<typename T::ProtocolData>, public RemoteReceiverListener {
+ public:
+  RemoteSignature get_signature() const override { return T().signature(); }
+
  protected:
   bool on_receive(RemoteReceiveData src) override {
     auto proto = T();
@@ -270,6 +326,7 @@ template<typename T> class RemoteReceiverDumper : public RemoteReceiverDumperBas
     proto.dump(*decoded);
     return true;
   }
+  RemoteSignature get_signature() const override { return T().signature(); }
 };
 
 #define DECLARE_REMOTE_PROTOCOL_(prefix) \
@@ -20,6 +20,7 @@ class Samsung36Protocol : public RemoteProtocol<Samsung36Data> {
   void encode(RemoteTransmitData *dst, const Samsung36Data &data) override;
   optional<Samsung36Data> decode(RemoteReceiveData src) override;
   void dump(const Samsung36Data &data) override;
+  RemoteSignature signature() const override;
 };
 
 DECLARE_REMOTE_PROTOCOL(Samsung36)
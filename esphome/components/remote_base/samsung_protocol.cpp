@@ -31,6 +31,7 @@ void SamsungProtocol::encode(RemoteTransmitData *dst, const SamsungData &data) {
 
   dst->item(FOOTER_HIGH_US, FOOTER_LOW_US);
 }
+RemoteSignature SamsungProtocol::signature() const { return {HEADER_HIGH_US, HEADER_LOW_US, 2 + 2 * 31}; }
 optional<SamsungData> SamsungProtocol::decode(RemoteReceiveData src) {
   SamsungData out{
       .data = 0,
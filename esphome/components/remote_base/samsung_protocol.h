@@ -18,6 +18,7 @@ class SamsungProtocol : public RemoteProtocol<SamsungData> {
   void encode(RemoteTransmitData *dst, const SamsungData &data) override;
   optional<SamsungData> decode(RemoteReceiveData src) override;
   void dump(const SamsungData &data) override;
+  RemoteSignature signature() const override;
 };
 
 DECLARE_REMOTE_PROTOCOL(Samsung)
@@ -26,6 +26,7 @@ void SonyProtocol::encode(RemoteTransmitData *dst, const SonyData &data) {
     }
   }
 }
+RemoteSignature SonyProtocol::signature() const { return {HEADER_HIGH_US, HEADER_LOW_US, 2 + 2 * 12}; }
 optional<SonyData> SonyProtocol::decode(RemoteReceiveData src) {
   SonyData out{
       .data = 0,
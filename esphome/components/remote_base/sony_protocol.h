@@ -20,6 +20,7 @@ class SonyProtocol : public RemoteProtocol<SonyData> {
   void encode(RemoteTransmitData *dst, const SonyData &data) override;
   optional<SonyData> decode(RemoteReceiveData src) override;
   void dump(const SonyData &data) override;
+  RemoteSignature signature() const override;
 };
 
 DECLARE_REMOTE_PROTOCOL(Sony)
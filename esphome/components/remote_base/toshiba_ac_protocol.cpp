@@ -47,6 +47,7 @@ void ToshibaAcProtocol::encode(RemoteTransmitData *dst, const ToshibaAcData &dat
   }
 }
 
+RemoteSignature ToshibaAcProtocol::signature() const { return {HEADER_HIGH_US, HEADER_LOW_US, 2 + 2 * 48}; }
 optional<ToshibaAcData> ToshibaAcProtocol::decode(RemoteReceiveData src) {
   uint64_t packet = 0;
   ToshibaAcData out{
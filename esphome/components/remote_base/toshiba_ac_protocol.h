@@ -18,6 +18,7 @@ class ToshibaAcProtocol : public RemoteProtocol<ToshibaAcData> {
   void encode(RemoteTransmitData *dst, const ToshibaAcData &data) override;
   optional<ToshibaAcData> decode(RemoteReceiveData src) override;
   void dump(const ToshibaAcData &data) override;
+  RemoteSignature signature() const override;
 };
 
 DECLARE_REMOTE_PROTOCOL(ToshibaAc)
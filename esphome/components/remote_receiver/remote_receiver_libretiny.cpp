@@ -22,12 +22,13 @@ void IRAM_ATTR HOT RemoteReceiverComponentStore::gpio_intr(RemoteReceiverCompone
   if (next == arg->buffer_read_at)
     return;
 
-  const uint32_t last_change = arg->buffer[arg->buffer_write_at];
-  const uint32_t time_since_change = now - last_change;
+  const uint32_t time_since_change = now - arg->last_change;
   if (time_since_change <= arg->filter_us)
     return;
 
-  arg->buffer[arg->buffer_write_at = next] = now;
+  arg->buffer[next] = time_since_change < UINT16_MAX ? time_since_change : UINT16_MAX;
+  arg->last_change = now;
+  arg->buffer_write_at = next;
 }
 
 void RemoteReceiverComponent::setup() {
@@ -44,9 +45,9 @@ void RemoteReceiverComponent::setup() {
     s.buffer_size++;
   }
 
-  s.buffer = new uint32_t[s.buffer_size];
+  s.buffer = new uint16_t[s.buffer_size];
   void *buf = (void *) s.buffer;
-  memset(buf, 0, s.buffer_size * sizeof(uint32_t));
+  memset(buf, 0, s.buffer_size * sizeof(uint16_t));
 
   // First index is a space.
   if (this->pin_->digital_read()) {
@@ -79,13 +80,13 @@ void RemoteReceiverComponent::loop() {
   if (dist <= 1)
     return;
   const uint32_t now = micros();
-  if (now - s.buffer[write_at] < this->idle_us_) {
+  if (now - s.last_change < this->idle_us_) {
     // The last change was fewer than the configured idle time ago.
     return;
   }
 
   ESP_LOGVV(TAG, "read_at=%u write_at=%u dist=%u now=%u end=%u", s.buffer_read_at, write_at, dist, now,
-            s.buffer[write_at]);
+            s.last_change);
 
   // Skip first value, it's from the previous idle level
   s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
@@ -97,14 +98,13 @@ void RemoteReceiverComponent::loop() {
   int32_t multiplier = s.buffer_read_at % 2 == 0 ? 1 : -1;
 
   for (uint32_t i = 0; prev != write_at; i++) {
-    int32_t delta = s.buffer[s.buffer_read_at] - s.buffer[prev];
-    if (uint32_t(delta) >= this->idle_us_) {
-      // already found a space longer than idle. There must have been two pulses
+    int32_t delta = s.buffer[s.buffer_read_at];
+    if (uint32_t(delta) >= this->idle_us_ || delta == UINT16_MAX) {
+      // already found a space longer than idle (or too long to store). There must have been two pulses
       break;
     }
 
-    ESP_LOGVV(TAG, "  i=%u buffer[%u]=%u - buffer[%u]=%u -> %d", i, s.buffer_read_at, s.buffer[s.buffer_read_at], prev,
-              s.buffer[prev], multiplier * delta);
+    ESP_LOGVV(TAG, "  i=%u buffer[%u]=%u -> %d", i, s.buffer_read_at, s.buffer[s.buffer_read_at], multiplier * delta);
     this->temp_.push_back(multiplier * delta);
     prev = s.buffer_read_at;
     s.buffer_read_at = (s.buffer_read_at + 1) % s.buffer_size;
@@ -31,40 +31,141 @@ void Filter::initialize(Sensor *parent, Filter *next) {
   this->next_ = next;
 }
 
+// RankedWindow
+void RankedWindow::set_window_size(size_t window_size) {
+  // Replay the most recent values into the resized window, oldest first
+  std::vector<float> recent;
+  size_t keep = std::min(this->count_, window_size);
+  for (size_t i = this->count_ - keep; i < this->count_; i++)
+    recent.push_back(this->values_[(this->head_ + i) % this->values_.size()]);
+
+  this->values_.assign(window_size, NAN);
+  this->heap_of_.assign(window_size, NONE);
+  this->position_.assign(window_size, 0);
+  this->low_.clear();
+  this->low_.reserve(window_size);
+  this->high_.clear();
+  this->high_.reserve(window_size);
+  this->head_ = 0;
+  this->count_ = 0;
+  for (float value : recent)
+    this->push(value);
+}
+void RankedWindow::push(float value) {
+  size_t slot;
+  if (this->count_ == this->values_.size()) {
+    // overwrite the oldest value
+    slot = this->head_;
+    this->head_ = (this->head_ + 1) % this->values_.size();
+    this->remove_(slot);
+  } else {
+    slot = (this->head_ + this->count_) % this->values_.size();
+    this->count_++;
+  }
+
+  this->values_[slot] = value;
+  if (std::isnan(value))
+    return;
+  // keep every low value below or equal to every high value, get() moves values over to balance the heaps
+  if (!this->low_.empty() && value < this->values_[this->low_[0]]) {
+    this->insert_(LOW, slot);
+  } else {
+    this->insert_(HIGH, slot);
+  }
+}
+float RankedWindow::get(size_t rank) {
+  // move the top values across until exactly rank + 1 values are in the low heap, so the one wanted is on top
+  while (this->low_.size() > rank + 1) {
+    size_t slot = this->low_[0];
+    this->remove_(slot);
+    this->insert_(HIGH, slot);
+  }
+  while (this->low_.size() < rank + 1) {
+    size_t slot = this->high_[0];
+    this->remove_(slot);
+    this->insert_(LOW, slot);
+  }
+  return this->values_[this->low_[0]];
+}
+void RankedWindow::swap_(std::vector<size_t> &heap, size_t i, size_t j) {
+  std::swap(heap[i], heap[j]);
+  this->position_[heap[i]] = i;
+  this->position_[heap[j]] = j;
+}
+void RankedWindow::sift_up_(Heap heap, size_t i) {
+  std::vector<size_t> &h = this->heap_(heap);
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (!this->above_(heap, h[i], h[parent]))
+      break;
+    this->swap_(h, i, parent);
+    i = parent;
+  }
+}
+void RankedWindow::sift_down_(Heap heap, size_t i) {
+  std::vector<size_t> &h = this->heap_(heap);
+  while (true) {
+    size_t top = i;
+    size_t left = 2 * i + 1;
+    size_t right = left + 1;
+    if (left < h.size() && this->above_(heap, h[left], h[top]))
+      top = left;
+    if (right < h.size() && this->above_(heap, h[right], h[top]))
+      top = right;
+    if (top == i)
+      break;
+    this->swap_(h, i, top);
+    i = top;
+  }
+}
+void RankedWindow::insert_(Heap heap, size_t slot) {
+  std::vector<size_t> &h = this->heap_(heap);
+  this->heap_of_[slot] = heap;
+  this->position_[slot] = h.size();
+  h.push_back(slot);
+  this->sift_up_(heap, h.size() - 1);
+}
+void RankedWindow::remove_(size_t slot) {
+  Heap heap = this->heap_of_[slot];
+  if (heap == NONE)
+    return;
+  std::vector<size_t> &h = this->heap_(heap);
+  size_t i = this->position_[slot];
+  this->heap_of_[slot] = NONE;
+  this->swap_(h, i, h.size() - 1);
+  h.pop_back();
+  if (i < h.size()) {
+    // the value moved into the gap can belong either further up or further down
+    size_t moved = h[i];
+    this->sift_up_(heap, i);
+    this->sift_down_(heap, this->position_[moved]);
+  }
+}
+
 // MedianFilter
 MedianFilter::MedianFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {
+  this->window_.set_window_size(window_size);
+}
 void MedianFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MedianFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MedianFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->window_.set_window_size(window_size);
+}
 optional<float> MedianFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MedianFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float median = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> median_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          median_queue.push_back(v);
-        }
-      }
-
-      sort(median_queue.begin(), median_queue.end());
-
-      size_t queue_size = median_queue.size();
-      if (queue_size) {
-        if (queue_size % 2) {
-          median = median_queue[queue_size / 2];
-        } else {
-          median = (median_queue[queue_size / 2] + median_queue[(queue_size / 2) - 1]) / 2.0f;
-        }
+    size_t queue_size = this->window_.ranked_count();
+    if (queue_size) {
+      if (queue_size % 2) {
+        median = this->window_.get(queue_size / 2);
+      } else {
+        median = (this->window_.get(queue_size / 2) + this->window_.get((queue_size / 2) - 1)) / 2.0f;
       }
     }
 
@@ -89,38 +190,31 @@ optional<float> SkipInitialFilter::new_value(float value) {
 
 // QuantileFilter
 QuantileFilter::QuantileFilter(size_t window_size, size_t send_every, size_t send_first_at, float quantile)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size), quantile_(quantile) {}
+    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size), quantile_(quantile) {
+  this->window_.set_window_size(window_size);
+}
 void QuantileFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void QuantileFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void QuantileFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->window_.set_window_size(window_size);
+}
 void QuantileFilter::set_quantile(float quantile) { this->quantile_ = quantile; }
 optional<float> QuantileFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f), quantile:%f", this, value, this->quantile_);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
     float result = NAN;
-    if (!this->queue_.empty()) {
-      // Copy queue without NaN values
-      std::vector<float> quantile_queue;
-      for (auto v : this->queue_) {
-        if (!std::isnan(v)) {
-          quantile_queue.push_back(v);
-        }
-      }
-
-      sort(quantile_queue.begin(), quantile_queue.end());
-
-      size_t queue_size = quantile_queue.size();
-      if (queue_size) {
-        size_t position = ceilf(queue_size * this->quantile_) - 1;
-        ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %d/%d", this, position + 1, queue_size);
-        result = quantile_queue[position];
-      }
+    size_t queue_size = this->window_.ranked_count();
+    if (queue_size) {
+      size_t position = ceilf(queue_size * this->quantile_);
+      // a quantile of 0 selects the lowest value
+      if (position > 0)
+        position--;
+      ESP_LOGVV(TAG, "QuantileFilter(%p)::position: %zu/%zu", this, position + 1, queue_size);
+      result = this->window_.get(position);
     }
 
     ESP_LOGVV(TAG, "QuantileFilter(%p)::new_value(%f) SENDING %f", this, value, result);
@@ -129,27 +223,92 @@ optional<float> QuantileFilter::new_value(float value) {
   return {};
 }
 
+// MonotonicWindow
+void MonotonicWindow::set_window_size(size_t window_size) {
+  // The candidates that are still inside the resized window remain valid, keep them
+  std::vector<float> values;
+  std::vector<uint32_t> sequence;
+  for (size_t i = 0; i < this->count_; i++) {
+    size_t index = (this->head_ + i) % this->values_.size();
+    if (this->pushed_ - this->sequence_[index] <= window_size) {
+      values.push_back(this->values_[index]);
+      sequence.push_back(this->sequence_[index]);
+    }
+  }
+
+  this->window_size_ = window_size;
+  this->values_.assign(window_size, NAN);
+  this->sequence_.assign(window_size, 0);
+  std::copy(values.begin(), values.end(), this->values_.begin());
+  std::copy(sequence.begin(), sequence.end(), this->sequence_.begin());
+  this->head_ = 0;
+  this->count_ = values.size();
+}
+void MonotonicWindow::push(float value) {
+  this->pushed_++;
+  // drop the oldest candidate once it has left the window
+  if (this->count_ != 0 && this->pushed_ - this->sequence_[this->head_] > this->window_size_) {
+    this->head_ = (this->head_ + 1) % this->values_.size();
+    this->count_--;
+  }
+  if (std::isnan(value))
+    return;
+
+  // drop the candidates that are worse than the new value; equal ones are older and so are reported first
+  while (this->count_ != 0) {
+    float last = this->values_[(this->head_ + this->count_ - 1) % this->values_.size()];
+    if (this->lowest_ ? !(value < last) : !(value > last))
+      break;
+    this->count_--;
+  }
+  size_t index = (this->head_ + this->count_) % this->values_.size();
+  this->values_[index] = value;
+  this->sequence_[index] = this->pushed_ - 1;
+  this->count_++;
+}
+
+// ValueWindow
+void ValueWindow::set_window_size(size_t window_size) {
+  // Keep the most recent values that still fit, oldest first
+  std::vector<float> values;
+  size_t keep = std::min(this->count_, window_size);
+  for (size_t i = this->count_ - keep; i < this->count_; i++)
+    values.push_back((*this)[i]);
+
+  this->values_.assign(window_size, NAN);
+  std::copy(values.begin(), values.end(), this->values_.begin());
+  this->head_ = 0;
+  this->count_ = values.size();
+}
+void ValueWindow::push(float value) {
+  if (this->count_ == this->values_.size()) {
+    // overwrite the oldest value
+    this->values_[this->head_] = value;
+    this->head_ = (this->head_ + 1) % this->values_.size();
+  } else {
+    this->values_[(this->head_ + this->count_) % this->values_.size()] = value;
+    this->count_++;
+  }
+}
+
 // MinFilter
 MinFilter::MinFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {
+  this->window_.set_window_size(window_size);
+}
 void MinFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MinFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MinFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->window_.set_window_size(window_size);
+}
 optional<float> MinFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float min = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        min = std::isnan(min) ? v : std::min(min, v);
-      }
-    }
+    float min = this->window_.get();
 
     ESP_LOGVV(TAG, "MinFilter(%p)::new_value(%f) SENDING %f", this, value, min);
     return min;
@@ -159,25 +318,22 @@ optional<float> MinFilter::new_value(float value) {
 
 // MaxFilter
 MaxFilter::MaxFilter(size_t window_size, size_t send_every, size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {
+  this->window_.set_window_size(window_size);
+}
 void MaxFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void MaxFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void MaxFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->window_.set_window_size(window_size);
+}
 optional<float> MaxFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
-    float max = NAN;
-    for (auto v : this->queue_) {
-      if (!std::isnan(v)) {
-        max = std::isnan(max) ? v : std::max(max, v);
-      }
-    }
+    float max = this->window_.get();
 
     ESP_LOGVV(TAG, "MaxFilter(%p)::new_value(%f) SENDING %f", this, value, max);
     return max;
@@ -188,22 +344,27 @@ optional<float> MaxFilter::new_value(float value) {
 // SlidingWindowMovingAverageFilter
 SlidingWindowMovingAverageFilter::SlidingWindowMovingAverageFilter(size_t window_size, size_t send_every,
                                                                    size_t send_first_at)
-    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {}
+    : send_every_(send_every), send_at_(send_every - send_first_at), window_size_(window_size) {
+  this->window_.set_window_size(window_size);
+}
 void SlidingWindowMovingAverageFilter::set_send_every(size_t send_every) { this->send_every_ = send_every; }
-void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) { this->window_size_ = window_size; }
+void SlidingWindowMovingAverageFilter::set_window_size(size_t window_size) {
+  this->window_size_ = window_size;
+  this->window_.set_window_size(window_size);
+}
 optional<float> SlidingWindowMovingAverageFilter::new_value(float value) {
-  while (this->queue_.size() >= this->window_size_) {
-    this->queue_.pop_front();
-  }
-  this->queue_.push_back(value);
+  this->window_.push(value);
   ESP_LOGVV(TAG, "SlidingWindowMovingAverageFilter(%p)::new_value(%f)", this, value);
 
   if (++this->send_at_ >= this->send_every_) {
     this->send_at_ = 0;
 
+    // Sum oldest to newest on every output instead of keeping a running sum, so that rounding is unchanged. This is
+    // only done every <send_every> values, which is usually the window size anyway.
     float sum = 0;
     size_t valid_count = 0;
-    for (auto v : this->queue_) {
+    for (size_t i = 0; i < this->window_.size(); i++) {
+      float v = this->window_[i];
       if (!std::isnan(v)) {
         sum += v;
         valid_count++;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cmath>
 #include <queue>
 #include <utility>
 #include <vector>
@@ -43,6 +44,49 @@ class Filter {
   Sensor *parent_{nullptr};
 };
 
+/** Sliding window over the last <window_size> values that can look up values by their rank in O(log n).
+ *
+ * The window is a ring buffer that is allocated once. Its non-NaN values are split between a max-heap holding the
+ * lowest values and a min-heap holding the others, so the value of a given rank sits at the top of one of them.
+ * Every slot of the ring keeps its position in its heap, which lets the value leaving the window be removed
+ * directly instead of searching for it.
+ */
+class RankedWindow {
+ public:
+  /// Resize the window, keeping the most recent values that still fit.
+  void set_window_size(size_t window_size);
+  /// Add a value, dropping the oldest one if the window is full. NaN values take up space but are not ranked.
+  void push(float value);
+  /// Number of non-NaN values in the window.
+  size_t ranked_count() const { return this->low_.size() + this->high_.size(); }
+  /// Get the value at position \p rank (0-based) of the sorted non-NaN values, rank must be below ranked_count().
+  float get(size_t rank);
+
+ protected:
+  enum Heap : uint8_t { NONE = 0, LOW, HIGH };
+
+  std::vector<size_t> &heap_(Heap heap) { return heap == LOW ? this->low_ : this->high_; }
+  /// Whether slot a has to be closer to the top of the heap than slot b.
+  bool above_(Heap heap, size_t a, size_t b) const {
+    return heap == LOW ? this->values_[a] > this->values_[b] : this->values_[a] < this->values_[b];
+  }
+  void swap_(std::vector<size_t> &heap, size_t i, size_t j);
+  void sift_up_(Heap heap, size_t i);
+  void sift_down_(Heap heap, size_t i);
+  void insert_(Heap heap, size_t slot);
+  void remove_(size_t slot);
+
+  std::vector<float> values_;
+  /// For each slot, the heap it is in and its index in that heap.
+  std::vector<Heap> heap_of_;
+  std::vector<size_t> position_;
+  /// Slots of the low values (max-heap) and of the high values (min-heap).
+  std::vector<size_t> low_;
+  std::vector<size_t> high_;
+  size_t head_{0};
+  size_t count_{0};
+};
+
 /** Simple quantile filter.
  *
  * Takes the quantile of the last <send_every> values and pushes it out every <send_every>.
@@ -67,7 +111,7 @@ class QuantileFilter : public Filter {
   void set_quantile(float quantile);
 
  protected:
-  std::deque<float> queue_;
+  RankedWindow window_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -96,7 +140,7 @@ class MedianFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  RankedWindow window_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -120,6 +164,48 @@ class SkipInitialFilter : public Filter {
   size_t num_to_ignore_;
 };
 
+/** Sliding window over the last <window_size> values that tracks their minimum or maximum in amortized O(1).
+ *
+ * Only the values that can still become the extremum are kept: a value is dropped as soon as a newer value is at
+ * least as good, since it will leave the window first. The candidates are kept in a ring buffer that is allocated
+ * once, in order of arrival, so the current extremum is always the oldest one. NaN values are ignored.
+ */
+class MonotonicWindow {
+ public:
+  /// Track the minimum if \p lowest is set, the maximum otherwise.
+  explicit MonotonicWindow(bool lowest) : lowest_(lowest) {}
+
+  void set_window_size(size_t window_size);
+  void push(float value);
+  /// The minimum or maximum of the non-NaN values in the window, or NaN if there are none.
+  float get() const { return this->count_ == 0 ? NAN : this->values_[this->head_]; }
+
+ protected:
+  bool lowest_;
+  size_t window_size_{0};
+  /// Number of values pushed so far, to tell when a candidate leaves the window.
+  uint32_t pushed_{0};
+  std::vector<float> values_;
+  std::vector<uint32_t> sequence_;
+  size_t head_{0};
+  size_t count_{0};
+};
+
+/** Fixed size ring buffer holding the last <window_size> values, allocated once. */
+class ValueWindow {
+ public:
+  void set_window_size(size_t window_size);
+  void push(float value);
+  size_t size() const { return this->count_; }
+  /// Get a value by age, 0 being the oldest value in the window.
+  float operator[](size_t i) const { return this->values_[(this->head_ + i) % this->values_.size()]; }
+
+ protected:
+  std::vector<float> values_;
+  size_t head_{0};
+  size_t count_{0};
+};
+
 /** Simple min filter.
  *
  * Takes the min of the last <send_every> values and pushes it out every <send_every>.
@@ -142,7 +228,7 @@ class MinFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  MonotonicWindow window_{true};
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -170,7 +256,7 @@ class MaxFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  MonotonicWindow window_{false};
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -199,7 +285,7 @@ class SlidingWindowMovingAverageFilter : public Filter {
   void set_window_size(size_t window_size);
 
  protected:
-  std::deque<float> queue_;
+  ValueWindow window_;
   size_t send_every_;
   size_t send_at_;
   size_t window_size_;
@@ -64,13 +64,20 @@ void SNTPComponent::update() {
   if (sntp_enabled()) {
     sntp_stop();
     this->has_time_ = false;
+#ifdef USE_EVENT_DRIVEN_LOOP
+    this->enable_loop();
+#endif
     sntp_init();
   }
 #endif
 }
 void SNTPComponent::loop() {
-  if (this->has_time_)
+  if (this->has_time_) {
+#ifdef USE_EVENT_DRIVEN_LOOP
+    this->disable_loop();
+#endif
     return;
+  }
 
   auto time = this->now();
   if (!time.is_valid())
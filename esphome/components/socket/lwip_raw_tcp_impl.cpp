@@ -605,6 +605,11 @@ std::unique_ptr<Socket> socket(int domain, int type, int protocol) {
   return std::unique_ptr<Socket>{sock};
 }
 
+// The application loop cannot wait on these sockets, so they are never loop-monitored.
+std::unique_ptr<Socket> socket_loop_monitored(int domain, int type, int protocol) {
+  return socket(domain, type, protocol);
+}
+
 }  // namespace socket
 }  // namespace esphome
 
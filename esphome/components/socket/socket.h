@@ -41,6 +41,12 @@ class Socket {
 
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
+
+  /// Whether the application loop wakes up from its idle sleep when this socket becomes readable.
+  bool is_loop_monitored() const { return this->loop_monitored_; }
+
+ protected:
+  bool loop_monitored_{false};
 };
 
 /// Create a socket of the given domain, type and protocol.
@@ -49,6 +55,15 @@ std::unique_ptr<Socket> socket(int domain, int type, int protocol);
 /// Create a socket in the newest available IP domain (IPv6 or IPv4) of the given type and protocol.
 std::unique_ptr<Socket> socket_ip(int type, int protocol);
 
+/// Create a socket like socket(), whose readiness also wakes the application loop from its idle sleep.
+///
+/// Sockets accepted from it are monitored as well. Not every socket implementation supports this, check
+/// Socket::is_loop_monitored() before relying on it.
+std::unique_ptr<Socket> socket_loop_monitored(int domain, int type, int protocol);
+
+/// Create a loop-monitored socket in the newest available IP domain, see socket_loop_monitored().
+std::unique_ptr<Socket> socket_ip_loop_monitored(int type, int protocol);
+
 /// Set a sockaddr to the specified address and port for the IP version used by socket_ip().
 socklen_t set_sockaddr(struct sockaddr *addr, socklen_t addrlen, const std::string &ip_address, uint16_t port);
 
@@ -80,6 +80,13 @@ class SpiLedStrip : public light::AddressableLight,
     return {this->buf_ + pos + 2,       this->buf_ + pos + 1, this->buf_ + pos + 0, nullptr,
             this->effect_data_ + index, &this->correction_};
   }
+  bool get_pixel_layout_(PixelLayout *layout) const override {
+    if (this->buf_ == nullptr)
+      return false;
+    // each LED frame starts with a brightness byte, followed by blue, green and red
+    *layout = {this->buf_ + 5, 4, 2, 1, 0, -1};
+    return true;
+  }
 
   size_t buffer_size_{};
   uint8_t *effect_data_{nullptr};
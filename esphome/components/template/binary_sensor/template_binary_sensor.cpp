@@ -17,8 +17,13 @@ void TemplateBinarySensor::setup() {
   }
 }
 void TemplateBinarySensor::loop() {
-  if (this->f_ == nullptr)
+  if (this->f_ == nullptr) {
+#ifdef USE_EVENT_DRIVEN_LOOP
+    // Without a lambda, the state only changes through actions: nothing to poll.
+    this->disable_loop();
+#endif
     return;
+  }
 
   auto s = this->f_();
   if (s.has_value()) {
@@ -12,8 +12,13 @@ TemplateLock::TemplateLock()
     : lock_trigger_(new Trigger<>()), unlock_trigger_(new Trigger<>()), open_trigger_(new Trigger<>()) {}
 
 void TemplateLock::loop() {
-  if (!this->f_.has_value())
+  if (!this->f_.has_value()) {
+#ifdef USE_EVENT_DRIVEN_LOOP
+    // Without a lambda, the state only changes through actions: nothing to poll.
+    this->disable_loop();
+#endif
     return;
+  }
   auto val = (*this->f_)();
   if (!val.has_value())
     return;
@@ -9,8 +9,13 @@ static const char *const TAG = "template.switch";
 TemplateSwitch::TemplateSwitch() : turn_on_trigger_(new Trigger<>()), turn_off_trigger_(new Trigger<>()) {}
 
 void TemplateSwitch::loop() {
-  if (!this->f_.has_value())
+  if (!this->f_.has_value()) {
+#ifdef USE_EVENT_DRIVEN_LOOP
+    // Without a lambda, the state only changes through actions: nothing to poll.
+    this->disable_loop();
+#endif
     return;
+  }
   auto s = (*this->f_)();
   if (!s.has_value())
     return;
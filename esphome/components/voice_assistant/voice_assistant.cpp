@@ -84,21 +84,14 @@ void VoiceAssistant::setup() {
   }
 #endif
 
-  ExternalRAMAllocator<int16_t> allocator(ExternalRAMAllocator<int16_t>::ALLOW_FAILURE);
-  this->input_buffer_ = allocator.allocate(INPUT_BUFFER_SIZE);
-  if (this->input_buffer_ == nullptr) {
-    ESP_LOGW(TAG, "Could not allocate input buffer");
-    this->mark_failed();
-    return;
-  }
-
 #ifdef USE_ESP_ADF
   this->vad_instance_ = vad_create(VAD_MODE_4);
+  // detect speech in the audio as the microphone reads it
+  this->mic_->add_data_callback([this](const std::vector<int16_t> &samples) { this->process_vad_(samples); });
 #endif
 
-  this->ring_buffer_ = RingBuffer::create(BUFFER_SIZE * sizeof(int16_t));
-  if (this->ring_buffer_ == nullptr) {
-    ESP_LOGW(TAG, "Could not allocate ring buffer");
+  if (!this->audio_queue_.init(BUFFER_SIZE)) {
+    ESP_LOGW(TAG, "Could not allocate audio buffer");
     this->mark_failed();
     return;
   }
@@ -112,21 +105,37 @@ void VoiceAssistant::setup() {
   }
 }
 
-int VoiceAssistant::read_microphone_() {
-  size_t bytes_read = 0;
-  if (this->mic_->is_running()) {  // Read audio into input buffer
-    bytes_read = this->mic_->read(this->input_buffer_, INPUT_BUFFER_SIZE * sizeof(int16_t));
-    if (bytes_read == 0) {
-      memset(this->input_buffer_, 0, INPUT_BUFFER_SIZE * sizeof(int16_t));
-      return 0;
+void VoiceAssistant::keep_latest_audio_() {
+  // make room for the next audio the microphone reads by dropping the oldest; otherwise it would drop the newest.
+  // Skipping is on the reading side of the queue, so this is safe while the microphone runs on its own task.
+  size_t samples_free = this->audio_queue_.free();
+  if (samples_free < INPUT_BUFFER_SIZE)
+    this->audio_queue_.skip(INPUT_BUFFER_SIZE - samples_free);
+}
+
+#ifdef USE_ESP_ADF
+void VoiceAssistant::process_vad_(const std::vector<int16_t> &samples) {
+  if (this->state_ != State::WAITING_FOR_VAD || samples.size() < SAMPLE_RATE_HZ / 1000 * VAD_FRAME_LENGTH_MS)
+    return;
+  vad_state_t vad_state =
+      vad_process(this->vad_instance_, const_cast<int16_t *>(samples.data()), SAMPLE_RATE_HZ, VAD_FRAME_LENGTH_MS);
+  if (vad_state == VAD_SPEECH) {
+    if (this->vad_counter_ < this->vad_threshold_) {
+      this->vad_counter_++;
+    } else {
+      ESP_LOGD(TAG, "VAD detected speech");
+      this->set_state_(State::START_PIPELINE, State::STREAMING_MICROPHONE);
+
+      // Reset for next time
+      this->vad_counter_ = 0;
     }
-    // Write audio into ring buffer
-    this->ring_buffer_->write((void *) this->input_buffer_, bytes_read);
   } else {
-    ESP_LOGD(TAG, "microphone not running");
+    if (this->vad_counter_ > 0) {
+      this->vad_counter_--;
+    }
   }
-  return bytes_read;
 }
+#endif
 
 void VoiceAssistant::loop() {
   if (this->api_client_ == nullptr && this->state_ != State::IDLE && this->state_ != State::STOP_MICROPHONE &&
@@ -145,7 +154,7 @@ void VoiceAssistant::loop() {
       if (this->continuous_ && this->desired_state_ == State::IDLE) {
         this->idle_trigger_->trigger();
 
-        this->ring_buffer_->reset();
+        this->audio_queue_.reset();
 #ifdef USE_ESP_ADF
         if (this->use_wake_word_) {
           this->set_state_(State::START_MICROPHONE, State::WAIT_FOR_VAD);
@@ -162,7 +171,8 @@ void VoiceAssistant::loop() {
     case State::START_MICROPHONE: {
       ESP_LOGD(TAG, "Starting Microphone");
       memset(this->send_buffer_, 0, SEND_BUFFER_SIZE);
-      memset(this->input_buffer_, 0, INPUT_BUFFER_SIZE * sizeof(int16_t));
+      // the microphone reads the audio into the queue from now on
+      this->mic_->add_sink(&this->audio_queue_);
       this->mic_->start();
       this->high_freq_.start();
       this->set_state_(State::STARTING_MICROPHONE);
@@ -176,37 +186,18 @@ void VoiceAssistant::loop() {
     }
 #ifdef USE_ESP_ADF
     case State::WAIT_FOR_VAD: {
-      this->read_microphone_();
+      this->keep_latest_audio_();
       ESP_LOGD(TAG, "Waiting for speech...");
       this->set_state_(State::WAITING_FOR_VAD);
       break;
     }
     case State::WAITING_FOR_VAD: {
-      size_t bytes_read = this->read_microphone_();
-      if (bytes_read > 0) {
-        vad_state_t vad_state =
-            vad_process(this->vad_instance_, this->input_buffer_, SAMPLE_RATE_HZ, VAD_FRAME_LENGTH_MS);
-        if (vad_state == VAD_SPEECH) {
-          if (this->vad_counter_ < this->vad_threshold_) {
-            this->vad_counter_++;
-          } else {
-            ESP_LOGD(TAG, "VAD detected speech");
-            this->set_state_(State::START_PIPELINE, State::STREAMING_MICROPHONE);
-
-            // Reset for next time
-            this->vad_counter_ = 0;
-          }
-        } else {
-          if (this->vad_counter_ > 0) {
-            this->vad_counter_--;
-          }
-        }
-      }
+      this->keep_latest_audio_();
       break;
     }
 #endif
     case State::START_PIPELINE: {
-      this->read_microphone_();
+      this->keep_latest_audio_();
       ESP_LOGD(TAG, "Requesting start...");
       uint32_t flags = 0;
       if (this->use_wake_word_)
@@ -238,17 +229,25 @@ void VoiceAssistant::loop() {
       break;
     }
     case State::STARTING_PIPELINE: {
-      this->read_microphone_();
+      this->keep_latest_audio_();
       break;  // State changed when udp server port received
     }
     case State::STREAMING_MICROPHONE: {
-      this->read_microphone_();
-      size_t available = this->ring_buffer_->available();
-      while (available >= SEND_BUFFER_SIZE) {
-        size_t read_bytes = this->ring_buffer_->read((void *) this->send_buffer_, SEND_BUFFER_SIZE, 0);
+      this->keep_latest_audio_();
+      while (this->audio_queue_.available() >= INPUT_BUFFER_SIZE) {
+        // send the audio straight from the queue, unless it's split at the end of it
+        size_t samples;
+        const int16_t *audio = this->audio_queue_.peek(INPUT_BUFFER_SIZE, &samples);
+        const bool copied = samples < INPUT_BUFFER_SIZE;
+        if (copied) {
+          samples = this->audio_queue_.read(reinterpret_cast<int16_t *>(this->send_buffer_), INPUT_BUFFER_SIZE);
+          audio = reinterpret_cast<const int16_t *>(this->send_buffer_);
+        }
+        const uint8_t *data = reinterpret_cast<const uint8_t *>(audio);
+        const size_t read_bytes = samples * sizeof(int16_t);
         if (this->audio_mode_ == AUDIO_MODE_API) {
           api::VoiceAssistantAudio msg;
-          msg.data.assign((char *) this->send_buffer_, read_bytes);
+          msg.data.assign((const char *) data, read_bytes);
           this->api_client_->send_voice_assistant_audio(msg);
         } else {
           if (!this->udp_socket_running_) {
@@ -257,15 +256,16 @@ void VoiceAssistant::loop() {
               break;
             }
           }
-          this->socket_->sendto(this->send_buffer_, read_bytes, 0, (struct sockaddr *) &this->dest_addr_,
-                                sizeof(this->dest_addr_));
+          this->socket_->sendto(data, read_bytes, 0, (struct sockaddr *) &this->dest_addr_, sizeof(this->dest_addr_));
         }
-        available = this->ring_buffer_->available();
+        if (!copied)
+          this->audio_queue_.skip(samples);
       }
 
       break;
     }
     case State::STOP_MICROPHONE: {
+      this->mic_->remove_sink(&this->audio_queue_);
       if (this->mic_->is_running()) {
         this->mic_->stop();
         this->set_state_(State::STOPPING_MICROPHONE);
@@ -507,7 +507,7 @@ void VoiceAssistant::request_start(bool continuous, bool silence_detection) {
   if (this->state_ == State::IDLE) {
     this->continuous_ = continuous;
     this->silence_detection_ = silence_detection;
-    this->ring_buffer_->reset();
+    this->audio_queue_.reset();
 #ifdef USE_ESP_ADF
     if (this->use_wake_word_) {
       this->set_state_(State::START_MICROPHONE, State::WAIT_FOR_VAD);
@@ -652,7 +652,8 @@ void VoiceAssistant::on_event(const api::VoiceAssistantEventResponse &msg) {
     case api::enums::VOICE_ASSISTANT_RUN_END: {
       ESP_LOGD(TAG, "Assist Pipeline ended");
       if (this->state_ == State::STREAMING_MICROPHONE) {
-        this->ring_buffer_->reset();
+        // the microphone still writes to the queue, so only empty it from the reading side
+        this->audio_queue_.skip(this->audio_queue_.available());
 #ifdef USE_ESP_ADF
         if (this->use_wake_word_) {
           // No need to stop the microphone since we didn't use the speaker
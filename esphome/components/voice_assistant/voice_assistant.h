@@ -6,8 +6,8 @@
 
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
+#include "esphome/core/audio_pipeline.h"
 #include "esphome/core/helpers.h"
-#include "esphome/core/ring_buffer.h"
 
 #include "esphome/components/api/api_connection.h"
 #include "esphome/components/api/api_pb2.h"
@@ -151,7 +151,11 @@ class VoiceAssistant : public Component {
   void set_wake_word(const std::string &wake_word) { this->wake_word_ = wake_word; }
 
  protected:
-  int read_microphone_();
+  /// Drop the oldest audio if the ring buffer is about to be full, so it holds the latest audio.
+  void keep_latest_audio_();
+#ifdef USE_ESP_ADF
+  void process_vad_(const std::vector<int16_t> &samples);
+#endif
   void set_state_(State state);
   void set_state_(State state, State desired_state);
   void signal_stop_();
@@ -210,7 +214,8 @@ class VoiceAssistant : public Component {
   uint8_t vad_threshold_{5};
   uint8_t vad_counter_{0};
 #endif
-  std::unique_ptr<RingBuffer> ring_buffer_;
+  /// Audio read by the microphone, waiting to be sent.
+  AudioQueue<int16_t> audio_queue_;
 
   bool use_wake_word_;
   uint8_t noise_suppression_level_;
@@ -218,7 +223,6 @@ class VoiceAssistant : public Component {
   float volume_multiplier_;
 
   uint8_t *send_buffer_;
-  int16_t *input_buffer_;
 
   bool continuous_{false};
   bool silence_detection_;
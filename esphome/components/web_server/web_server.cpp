@@ -12,6 +12,7 @@
 #include "StreamString.h"
 #endif
 
+#include <cinttypes>
 #include <cstdlib>
 
 #ifdef USE_LIGHT
@@ -111,7 +112,7 @@ void WebServer::set_js_include(const char *js_include) { this->js_include_ = js_
 #endif
 
 std::string WebServer::get_config_json() {
-  return json::build_json([this](JsonObject root) {
+  return json::build_json([this](json::JsonWriter &root) {
     root["title"] = App.get_friendly_name().empty() ? App.get_name() : App.get_friendly_name();
     root["comment"] = App.get_comment();
     root["ota"] = this->allow_ota_;
@@ -130,6 +131,7 @@ void WebServer::setup() {
     client->send(this->get_config_json().c_str(), "ping", millis(), 30000);
 
     this->entities_iterator_.begin(this->include_internal_);
+    App.wake_loop_any_context();
   });
 
 #ifdef USE_LOGGER
@@ -165,9 +167,146 @@ void WebServer::loop() {
 #endif
   this->entities_iterator_.advance();
 }
+uint32_t WebServer::get_idle_loop_interval() {
+  if (this->entities_iterator_.is_running())
+    return 0;
+#ifdef USE_ESP32
+  // requests from the server task wake the loop when they schedule work
+  bool empty = false;
+  if (xSemaphoreTake(this->to_schedule_lock_, 0L)) {
+    empty = this->to_schedule_.empty();
+    xSemaphoreGive(this->to_schedule_lock_);
+  }
+  return empty ? UINT32_MAX : 0;
+#else
+  return UINT32_MAX;
+#endif
+}
+void WebServer::queue_state_event_(StateEventType type, EntityBase *obj) {
+  if (this->events_.count() == 0)
+    return;
+  for (auto &pending : this->pending_state_events_) {
+    // already queued, the latest state is read when the events are sent
+    if (pending.obj == obj)
+      return;
+  }
+  this->pending_state_events_.push_back(PendingStateEvent{obj, type});
+
+  uint32_t elapsed = millis() - this->last_state_events_;
+  if (elapsed >= this->state_update_interval_) {
+    this->send_state_events_();
+  } else if (this->pending_state_events_.size() == 1) {
+    this->set_timeout_static("state_events", this->state_update_interval_ - elapsed,
+                             [this]() { this->send_state_events_(); });
+  }
+}
+
+void WebServer::send_state_events_() {
+  if (this->pending_state_events_.empty())
+    return;
+  this->last_state_events_ = millis();
+  if (this->events_.count() != 0) {
+#ifdef USE_ESP_IDF
+    this->events_.begin_batch();
+#endif
+    for (auto &pending : this->pending_state_events_)
+      this->events_.send(this->state_event_json_(pending.type, pending.obj).c_str(), "state");
+#ifdef USE_ESP_IDF
+    this->events_.end_batch();
+#endif
+  }
+  this->pending_state_events_.clear();
+}
+
+std::string WebServer::state_event_json_(StateEventType type, EntityBase *obj) {
+  switch (type) {
+#ifdef USE_SENSOR
+    case STATE_EVENT_SENSOR: {
+      auto *sensor = static_cast<sensor::Sensor *>(obj);
+      return this->sensor_json(sensor, sensor->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_TEXT_SENSOR
+    case STATE_EVENT_TEXT_SENSOR: {
+      auto *text_sensor = static_cast<text_sensor::TextSensor *>(obj);
+      return this->text_sensor_json(text_sensor, text_sensor->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_SWITCH
+    case STATE_EVENT_SWITCH: {
+      auto *sw = static_cast<switch_::Switch *>(obj);
+      return this->switch_json(sw, sw->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_BINARY_SENSOR
+    case STATE_EVENT_BINARY_SENSOR: {
+      auto *binary_sensor = static_cast<binary_sensor::BinarySensor *>(obj);
+      return this->binary_sensor_json(binary_sensor, binary_sensor->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_FAN
+    case STATE_EVENT_FAN:
+      return this->fan_json(static_cast<fan::Fan *>(obj), DETAIL_STATE);
+#endif
+#ifdef USE_LIGHT
+    case STATE_EVENT_LIGHT:
+      return this->light_json(static_cast<light::LightState *>(obj), DETAIL_STATE);
+#endif
+#ifdef USE_COVER
+    case STATE_EVENT_COVER:
+      return this->cover_json(static_cast<cover::Cover *>(obj), DETAIL_STATE);
+#endif
+#ifdef USE_NUMBER
+    case STATE_EVENT_NUMBER: {
+      auto *number = static_cast<number::Number *>(obj);
+      return this->number_json(number, number->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_DATETIME_DATE
+    case STATE_EVENT_DATE:
+      return this->date_json(static_cast<datetime::DateEntity *>(obj), DETAIL_STATE);
+#endif
+#ifdef USE_DATETIME_TIME
+    case STATE_EVENT_TIME:
+      return this->time_json(static_cast<datetime::TimeEntity *>(obj), DETAIL_STATE);
+#endif
+#ifdef USE_TEXT
+    case STATE_EVENT_TEXT: {
+      auto *text = static_cast<text::Text *>(obj);
+      return this->text_json(text, text->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_SELECT
+    case STATE_EVENT_SELECT: {
+      auto *select = static_cast<select::Select *>(obj);
+      return this->select_json(select, select->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_CLIMATE
+    case STATE_EVENT_CLIMATE:
+      return this->climate_json(static_cast<climate::Climate *>(obj), DETAIL_STATE);
+#endif
+#ifdef USE_LOCK
+    case STATE_EVENT_LOCK: {
+      auto *lock = static_cast<lock::Lock *>(obj);
+      return this->lock_json(lock, lock->state, DETAIL_STATE);
+    }
+#endif
+#ifdef USE_ALARM_CONTROL_PANEL
+    case STATE_EVENT_ALARM_CONTROL_PANEL: {
+      auto *panel = static_cast<alarm_control_panel::AlarmControlPanel *>(obj);
+      return this->alarm_control_panel_json(panel, panel->get_state(), DETAIL_STATE);
+    }
+#endif
+    default:
+      return "";
+  }
+}
+
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network::get_use_address().c_str(), this->base_->get_port());
+  ESP_LOGCONFIG(TAG, "  State Update Interval: %" PRIu32 "ms", this->state_update_interval_);
 }
 float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
 
@@ -416,9 +555,7 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_SENSOR, obj);
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (sensor::Sensor *obj : App.get_sensors()) {
@@ -431,7 +568,7 @@ void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::build_json([obj, value, start_config](json::JsonWriter &root) {
     std::string state;
     if (std::isnan(value)) {
       state = "NA";
@@ -451,9 +588,7 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->text_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_TEXT_SENSOR, obj);
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
@@ -467,7 +602,7 @@ void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const
 }
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value,
                                         JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::build_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
   });
 }
@@ -475,12 +610,10 @@ std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std:
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->switch_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_SWITCH, obj);
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::build_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
     if (start_config == DETAIL_ALL) {
       root["assumed_state"] = obj->assumed_state();
@@ -515,8 +648,9 @@ void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlM
 
 #ifdef USE_BUTTON
 std::string WebServer::button_json(button::Button *obj, JsonDetail start_config) {
-  return json::build_json(
-      [obj, start_config](JsonObject root) { set_json_id(root, obj, "button-" + obj->get_object_id(), start_config); });
+  return json::build_json([obj, start_config](json::JsonWriter &root) {
+    set_json_id(root, obj, "button-" + obj->get_object_id(), start_config);
+  });
 }
 
 void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -538,12 +672,10 @@ void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlM
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->binary_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_BINARY_SENSOR, obj);
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::build_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value,
                               start_config);
   });
@@ -562,12 +694,10 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, con
 
 #ifdef USE_FAN
 void WebServer::on_fan_update(fan::Fan *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->fan_json(obj, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_FAN, obj);
 }
 std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::build_json([obj, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state,
                               start_config);
     const auto traits = obj->get_traits();
@@ -635,9 +765,7 @@ void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatc
 
 #ifdef USE_LIGHT
 void WebServer::on_light_update(light::LightState *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->light_json(obj, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_LIGHT, obj);
 }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (light::LightState *obj : App.get_lights()) {
@@ -743,9 +871,7 @@ std::string WebServer::light_json(light::LightState *obj, JsonDetail start_confi
 
 #ifdef USE_COVER
 void WebServer::on_cover_update(cover::Cover *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->cover_json(obj, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_COVER, obj);
 }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (cover::Cover *obj : App.get_covers()) {
@@ -799,7 +925,7 @@ void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMa
   request->send(404);
 }
 std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::build_json([obj, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "cover-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
                               obj->position, start_config);
     root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
@@ -814,9 +940,7 @@ std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
 
 #ifdef USE_NUMBER
 void WebServer::on_number_update(number::Number *obj, float state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->number_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_NUMBER, obj);
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_numbers()) {
@@ -848,7 +972,7 @@ void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlM
 }
 
 std::string WebServer::number_json(number::Number *obj, float value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::build_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_id(root, obj, "number-" + obj->get_object_id(), start_config);
     if (start_config == DETAIL_ALL) {
       root["min_value"] =
@@ -877,9 +1001,7 @@ std::string WebServer::number_json(number::Number *obj, float value, JsonDetail
 
 #ifdef USE_DATETIME_DATE
 void WebServer::on_date_update(datetime::DateEntity *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->date_json(obj, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_DATE, obj);
 }
 void WebServer::handle_date_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_dates()) {
@@ -915,7 +1037,7 @@ void WebServer::handle_date_request(AsyncWebServerRequest *request, const UrlMat
 }
 
 std::string WebServer::date_json(datetime::DateEntity *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::build_json([obj, start_config](json::JsonWriter &root) {
     set_json_id(root, obj, "date-" + obj->get_object_id(), start_config);
     std::string value = str_sprintf("%d-%02d-%02d", obj->year, obj->month, obj->day);
     root["value"] = value;
@@ -926,7 +1048,7 @@ std::string WebServer::date_json(datetime::DateEntity *obj, JsonDetail start_con
 
 #ifdef USE_DATETIME_TIME
 void WebServer::on_time_update(datetime::TimeEntity *obj) {
-  this->events_.send(this->time_json(obj, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_TIME, obj);
 }
 void WebServer::handle_time_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_times()) {
@@ -961,7 +1083,7 @@ void WebServer::handle_time_request(AsyncWebServerRequest *request, const UrlMat
   request->send(404);
 }
 std::string WebServer::time_json(datetime::TimeEntity *obj, JsonDetail start_config) {
-  return json::build_json([obj, start_config](JsonObject root) {
+  return json::build_json([obj, start_config](json::JsonWriter &root) {
     set_json_id(root, obj, "time-" + obj->get_object_id(), start_config);
     std::string value = str_sprintf("%02d:%02d:%02d", obj->hour, obj->minute, obj->second);
     root["value"] = value;
@@ -972,9 +1094,7 @@ std::string WebServer::time_json(datetime::TimeEntity *obj, JsonDetail start_con
 
 #ifdef USE_TEXT
 void WebServer::on_text_update(text::Text *obj, const std::string &state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->text_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_TEXT, obj);
 }
 void WebServer::handle_text_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_texts()) {
@@ -1005,7 +1125,7 @@ void WebServer::handle_text_request(AsyncWebServerRequest *request, const UrlMat
 }
 
 std::string WebServer::text_json(text::Text *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::build_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_id(root, obj, "text-" + obj->get_object_id(), start_config);
     if (start_config == DETAIL_ALL) {
       root["mode"] = (int) obj->traits.get_mode();
@@ -1025,9 +1145,7 @@ std::string WebServer::text_json(text::Text *obj, const std::string &value, Json
 
 #ifdef USE_SELECT
 void WebServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->select_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_SELECT, obj);
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_selects()) {
@@ -1064,13 +1182,15 @@ void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlM
   request->send(404);
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::build_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "select-" + obj->get_object_id(), value, value, start_config);
     if (start_config == DETAIL_ALL) {
-      JsonArray opt = root.createNestedArray("option");
+      root.key("option");
+      root.begin_array();
       for (auto &option : obj->traits.get_options()) {
-        opt.add(option);
+        root.value(option);
       }
+      root.end_array();
     }
   });
 }
@@ -1081,9 +1201,7 @@ std::string WebServer::select_json(select::Select *obj, const std::string &value
 
 #ifdef USE_CLIMATE
 void WebServer::on_climate_update(climate::Climate *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->climate_json(obj, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_CLIMATE, obj);
 }
 
 void WebServer::handle_climate_request(AsyncWebServerRequest *request, const UrlMatch &match) {
@@ -1224,12 +1342,10 @@ std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_conf
 
 #ifdef USE_LOCK
 void WebServer::on_lock_update(lock::Lock *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->lock_json(obj, obj->state, DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_LOCK, obj);
 }
 std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::build_json([obj, value, start_config](json::JsonWriter &root) {
     set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value), value,
                               start_config);
   });
@@ -1262,14 +1378,12 @@ void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMat
 
 #ifdef USE_ALARM_CONTROL_PANEL
 void WebServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE).c_str(), "state");
+  this->queue_state_event_(STATE_EVENT_ALARM_CONTROL_PANEL, obj);
 }
 std::string WebServer::alarm_control_panel_json(alarm_control_panel::AlarmControlPanel *obj,
                                                 alarm_control_panel::AlarmControlPanelState value,
                                                 JsonDetail start_config) {
-  return json::build_json([obj, value, start_config](JsonObject root) {
+  return json::build_json([obj, value, start_config](json::JsonWriter &root) {
     char buf[16];
     set_json_icon_state_value(root, obj, "alarm-control-panel-" + obj->get_object_id(),
                               PSTR_LOCAL(alarm_control_panel_state_to_string(value)), value, start_config);
@@ -1551,6 +1665,7 @@ void WebServer::schedule_(std::function<void()> &&f) {
   xSemaphoreTake(this->to_schedule_lock_, portMAX_DELAY);
   to_schedule_.push_back(std::move(f));
   xSemaphoreGive(this->to_schedule_lock_);
+  App.wake_loop_any_context();
 #else
   this->defer(std::move(f));
 #endif
@@ -41,6 +41,25 @@ struct UrlMatch {
 
 enum JsonDetail { DETAIL_ALL, DETAIL_STATE };
 
+/// Kind of entity whose state event is waiting to be sent, to know which *_json method to use.
+enum StateEventType : uint8_t {
+  STATE_EVENT_SENSOR,
+  STATE_EVENT_TEXT_SENSOR,
+  STATE_EVENT_SWITCH,
+  STATE_EVENT_BINARY_SENSOR,
+  STATE_EVENT_FAN,
+  STATE_EVENT_LIGHT,
+  STATE_EVENT_COVER,
+  STATE_EVENT_NUMBER,
+  STATE_EVENT_DATE,
+  STATE_EVENT_TIME,
+  STATE_EVENT_TEXT,
+  STATE_EVENT_SELECT,
+  STATE_EVENT_CLIMATE,
+  STATE_EVENT_LOCK,
+  STATE_EVENT_ALARM_CONTROL_PANEL,
+};
+
 /** This class allows users to create a web server with their ESP nodes.
  *
  * Behind the scenes it's using AsyncWebServer to set up the server. It exposes 3 things:
@@ -102,12 +121,21 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    * @param expose_log.
    */
   void set_expose_log(bool expose_log) { this->expose_log_ = expose_log; }
+  /** Set the minimum time between two batches of state events.
+   *
+   * State changes within this interval are collected and sent together, with only the latest state of each entity.
+   * Set to 0 to send every state change right away.
+   *
+   * @param interval The interval in milliseconds.
+   */
+  void set_state_update_interval(uint32_t interval) { this->state_update_interval_ = interval; }
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
   /// Setup the internal web server and register handlers.
   void setup() override;
   void loop() override;
+  uint32_t get_idle_loop_interval() override;
 
   void dump_config() override;
 
@@ -296,6 +324,12 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 
  protected:
   void schedule_(std::function<void()> &&f);
+  /// Queue the state event of an entity, sending it right away if the state interval has passed.
+  void queue_state_event_(StateEventType type, EntityBase *obj);
+  /// Send the queued state events, built from the current entity states.
+  void send_state_events_();
+  /// Build the state event of an entity from its current state.
+  std::string state_event_json_(StateEventType type, EntityBase *obj);
   friend ListEntitiesIterator;
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
@@ -313,6 +347,14 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
   bool include_internal_{false};
   bool allow_ota_{true};
   bool expose_log_{true};
+  struct PendingStateEvent {
+    EntityBase *obj;
+    StateEventType type;
+  };
+  /// Entities with a state change that hasn't been sent yet, each at most once.
+  std::vector<PendingStateEvent> pending_state_events_;
+  uint32_t state_update_interval_{0};
+  uint32_t last_state_events_{0};
 #ifdef USE_ESP32
   std::deque<std::function<void()>> to_schedule_;
   SemaphoreHandle_t to_schedule_lock_;
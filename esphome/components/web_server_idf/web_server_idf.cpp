@@ -269,6 +269,42 @@ void AsyncResponseStream::printf(const char *fmt, ...) {
   this->print(str);
 }
 
+/// Append an event in the text/event-stream format to \p ev, return false if there was nothing to append.
+static bool append_event(std::string &ev, const char *message, const char *event, uint32_t id, uint32_t reconnect) {
+  size_t start = ev.size();
+
+  if (reconnect) {
+    ev.append("retry: ", sizeof("retry: ") - 1);
+    ev.append(to_string(reconnect));
+    ev.append(CRLF_STR, CRLF_LEN);
+  }
+
+  if (id) {
+    ev.append("id: ", sizeof("id: ") - 1);
+    ev.append(to_string(id));
+    ev.append(CRLF_STR, CRLF_LEN);
+  }
+
+  if (event && *event) {
+    ev.append("event: ", sizeof("event: ") - 1);
+    ev.append(event);
+    ev.append(CRLF_STR, CRLF_LEN);
+  }
+
+  if (message && *message) {
+    ev.append("data: ", sizeof("data: ") - 1);
+    ev.append(message);
+    ev.append(CRLF_STR, CRLF_LEN);
+  }
+
+  if (ev.size() == start) {
+    return false;
+  }
+
+  ev.append(CRLF_STR, CRLF_LEN);
+  return true;
+}
+
 AsyncEventSource::~AsyncEventSource() {
   for (auto *ses : this->sessions_) {
     delete ses;  // NOLINT(cppcoreguidelines-owning-memory)
@@ -285,7 +321,21 @@ void AsyncEventSource::handleRequest(AsyncWebServerRequest *request) {
 
 void AsyncEventSource::send(const char *message, const char *event, uint32_t id, uint32_t reconnect) {
   for (auto *ses : this->sessions_) {
-    ses->send(message, event, id, reconnect);
+    if (!this->batching_) {
+      ses->send(message, event, id, reconnect);
+    } else if (ses->fd_ != 0) {
+      append_event(ses->batch_, message, event, id, reconnect);
+    }
+  }
+}
+
+void AsyncEventSource::end_batch() {
+  this->batching_ = false;
+  for (auto *ses : this->sessions_) {
+    if (!ses->batch_.empty()) {
+      ses->send_chunk_(ses->batch_);
+      ses->batch_.clear();
+    }
   }
 }
 
@@ -323,46 +373,17 @@ void AsyncEventSourceResponse::send(const char *message, const char *event, uint
   }
 
   std::string ev;
+  if (append_event(ev, message, event, id, reconnect))
+    this->send_chunk_(ev);
+}
 
-  if (reconnect) {
-    ev.append("retry: ", sizeof("retry: ") - 1);
-    ev.append(to_string(reconnect));
-    ev.append(CRLF_STR, CRLF_LEN);
-  }
-
-  if (id) {
-    ev.append("id: ", sizeof("id: ") - 1);
-    ev.append(to_string(id));
-    ev.append(CRLF_STR, CRLF_LEN);
-  }
-
-  if (event && *event) {
-    ev.append("event: ", sizeof("event: ") - 1);
-    ev.append(event);
-    ev.append(CRLF_STR, CRLF_LEN);
-  }
-
-  if (message && *message) {
-    ev.append("data: ", sizeof("data: ") - 1);
-    ev.append(message);
-    ev.append(CRLF_STR, CRLF_LEN);
-  }
-
-  if (ev.empty()) {
-    return;
-  }
-
-  ev.append(CRLF_STR, CRLF_LEN);
-
-  // Sending chunked content prelude
-  auto cs = str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size());
+void AsyncEventSourceResponse::send_chunk_(const std::string &events) {
+  // Send the chunk prelude, the events and the end of the chunk with a single write
+  auto cs = str_snprintf("%x" CRLF_STR, 4 * sizeof(events.size()) + CRLF_LEN, events.size());
+  cs.reserve(cs.size() + events.size() + CRLF_LEN);
+  cs.append(events);
+  cs.append(CRLF_STR, CRLF_LEN);
   httpd_socket_send(this->hd_, this->fd_, cs.c_str(), cs.size(), 0);
-
-  // Sendiing content chunk
-  httpd_socket_send(this->hd_, this->fd_, ev.c_str(), ev.size(), 0);
-
-  // Indicate end of chunk
-  httpd_socket_send(this->hd_, this->fd_, CRLF_STR, CRLF_LEN, 0);
 }
 
 }  // namespace web_server_idf
@@ -225,9 +225,13 @@ class AsyncEventSourceResponse {
  protected:
   AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server);
   static void destroy(void *p);
+  /// Send the given formatted events as a single chunk.
+  void send_chunk_(const std::string &events);
   AsyncEventSource *server_;
   httpd_handle_t hd_{};
   int fd_{};
+  /// Events collected by AsyncEventSource::send() while batching. Only used from the main loop.
+  std::string batch_;
 };
 
 using AsyncEventSourceClient = AsyncEventSourceResponse;
@@ -251,12 +255,18 @@ class AsyncEventSource : public AsyncWebHandler {
 
   void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
 
+  /// Collect the events sent until end_batch() and write them to each client in one go. Events sent directly to a
+  /// client, such as the initial ones from the connect handler, are not batched. Only call these from the main loop.
+  void begin_batch() { this->batching_ = true; }
+  void end_batch();
+
   size_t count() const { return this->sessions_.size(); }
 
  protected:
   std::string url_;
   std::set<AsyncEventSourceResponse *> sessions_;
   connect_handler_t on_connect_{};
+  bool batching_{false};
 };
 
 class DefaultHeaders {
@@ -198,6 +198,15 @@ void WiFiComponent::loop() {
   }
 }
 
+uint32_t WiFiComponent::get_idle_loop_interval() {
+  // Once connected, only WiFi events change the state and those wake the loop. The timeouts checked in loop() are
+  // far longer than the application's longest idle sleep.
+  if (this->state_ == WIFI_COMPONENT_STATE_STA_CONNECTED && this->handled_connected_state_ && !this->ap_setup_ &&
+      this->is_connected())
+    return UINT32_MAX;
+  return 0;
+}
+
 WiFiComponent::WiFiComponent() { global_wifi_component = this; }
 
 bool WiFiComponent::has_ap() const { return this->has_ap_; }
@@ -248,6 +248,7 @@ class WiFiComponent : public Component {
 
   /// Reconnect WiFi if required.
   void loop() override;
+  uint32_t get_idle_loop_interval() override;
 
   bool has_sta() const;
   bool has_ap() const;
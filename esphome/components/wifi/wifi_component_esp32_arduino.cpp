@@ -572,6 +572,8 @@ void WiFiComponent::wifi_event_callback_(esphome_wifi_event_id_t event, esphome_
     default:
       break;
   }
+  // runs in the WiFi event task, let loop() pick up the new state right away
+  App.wake_loop_any_context();
 }
 void WiFiComponent::wifi_pre_setup_() {
   auto f = std::bind(&WiFiComponent::wifi_event_callback_, this, std::placeholders::_1, std::placeholders::_2);
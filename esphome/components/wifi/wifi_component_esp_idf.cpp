@@ -120,7 +120,9 @@ void event_handler(void *arg, esp_event_base_t event_base, int32_t event_id, voi
   // don't block, we may miss events but the core can handle that
   if (xQueueSend(s_event_queue, &to_send, 0L) != pdPASS) {
     delete to_send;  // NOLINT(cppcoreguidelines-owning-memory)
+    return;
   }
+  App.wake_loop_any_context();
 }
 
 void WiFiComponent::wifi_pre_setup_() {
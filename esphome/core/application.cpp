@@ -7,10 +7,24 @@
 #include "esphome/components/status_led/status_led.h"
 #endif
 
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(USE_ESP32)
+#include <esp_vfs_eventfd.h>
+#include <unistd.h>
+#endif
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(USE_HOST)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace esphome {
 
 static const char *const TAG = "app";
 
+#ifdef USE_EVENT_DRIVEN_LOOP
+// Upper bound for sleeping when no component needs its loop() polled, so that the watchdog still gets fed.
+static const uint32_t MAX_IDLE_SLEEP_MS = 1000;
+#endif
+
 void Application::register_component_(Component *comp) {
   if (comp == nullptr) {
     ESP_LOGW(TAG, "Tried to register null component!");
@@ -59,6 +73,25 @@ void Application::setup() {
     } while (!component->can_proceed());
   }
 
+#ifdef USE_EVENT_DRIVEN_LOOP
+#ifdef USE_ESP32
+  this->loop_task_handle_ = xTaskGetCurrentTaskHandle();
+  // Fails harmlessly if the eventfd driver has been registered already
+  esp_vfs_eventfd_config_t eventfd_config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+  esp_vfs_eventfd_register(&eventfd_config);
+  this->wake_fds_[0] = this->wake_fds_[1] = eventfd(0, EFD_SUPPORT_ISR);
+#endif
+#ifdef USE_HOST
+  this->loop_thread_ = pthread_self();
+  if (pipe(this->wake_fds_) == 0) {
+    fcntl(this->wake_fds_[0], F_SETFL, O_NONBLOCK);
+    fcntl(this->wake_fds_[1], F_SETFL, O_NONBLOCK);
+  } else {
+    this->wake_fds_[0] = this->wake_fds_[1] = -1;
+  }
+#endif
+#endif
+
   ESP_LOGI(TAG, "setup() finished successfully!");
   this->schedule_dump_config();
   this->calculate_looping_components_();
@@ -66,11 +99,24 @@ void Application::setup() {
 void Application::loop() {
   uint32_t new_app_state = 0;
 
+  if (this->has_pending_enable_loop_requests_) {
+    this->has_pending_enable_loop_requests_ = false;
+    for (Component *component : this->looping_components_) {
+      if (component->pending_enable_loop_) {
+        component->pending_enable_loop_ = false;
+        component->enable_loop();
+      }
+    }
+  }
+
   this->scheduler.call();
   this->feed_wdt();
   for (Component *component : this->looping_components_) {
-    {
+    if (!component->loop_disabled_) {
       WarnIfComponentBlockingGuard guard{component};
+#ifdef USE_LOOP_PROFILER
+      LoopProfileGuard profile_guard{&component->loop_profile_};
+#endif
       component->call();
     }
     new_app_state |= component->get_component_state();
@@ -82,7 +128,19 @@ void Application::loop() {
   const uint32_t now = millis();
 
   auto elapsed = now - this->last_loop_;
-  if (elapsed >= this->loop_interval_ || HighFrequencyLoopRequester::is_high_frequency()) {
+  uint32_t idle_interval = 0;
+#if defined(USE_EVENT_DRIVEN_LOOP) && (defined(USE_ESP32) || defined(USE_HOST))
+  // Asked after all loops ran, so that work queued by a later component for an earlier one is taken into account
+  if (this->wake_fds_[0] >= 0 && !HighFrequencyLoopRequester::is_high_frequency() &&
+      !this->has_pending_enable_loop_requests_ && this->dump_config_at_ >= this->components_.size())
+    idle_interval = this->idle_loop_interval_();
+#endif
+  if (idle_interval > this->loop_interval_) {
+    // Sleep until the next scheduled item is due, a registered socket becomes readable or someone wakes us up.
+    // Items added by components during this iteration are only visible to next_schedule_in() once processed.
+    this->scheduler.process_to_add();
+    this->sleep_(std::min(this->scheduler.next_schedule_in().value_or(idle_interval), idle_interval));
+  } else if (elapsed >= this->loop_interval_ || HighFrequencyLoopRequester::is_high_frequency()) {
     yield();
   } else {
     uint32_t delay_time = this->loop_interval_ - elapsed;
@@ -91,7 +149,7 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+    this->sleep_(delay_time);
   }
   this->last_loop_ = now;
 
@@ -143,6 +201,82 @@ void Application::run_safe_shutdown_hooks() {
   }
 }
 
+void Application::sleep_(uint32_t delay_ms) {
+#if defined(USE_EVENT_DRIVEN_LOOP) && (defined(USE_ESP32) || defined(USE_HOST))
+  if (this->wake_fds_[0] >= 0) {
+    fd_set read_fds = this->socket_fds_;
+    FD_SET(this->wake_fds_[0], &read_fds);
+    struct timeval tv;
+    tv.tv_sec = delay_ms / 1000;
+    tv.tv_usec = (delay_ms % 1000) * 1000;
+    const int max_fd = std::max(this->max_socket_fd_, this->wake_fds_[0]);
+    if (::select(max_fd + 1, &read_fds, nullptr, nullptr, &tv) > 0 && FD_ISSET(this->wake_fds_[0], &read_fds)) {
+#ifdef USE_ESP32
+      // reading an eventfd resets its counter
+      uint64_t count;
+      (void) ::read(this->wake_fds_[0], &count, sizeof(count));
+#else
+      uint8_t buf[16];
+      while (::read(this->wake_fds_[0], buf, sizeof(buf)) > 0) {
+      }
+#endif
+    }
+    return;
+  }
+#endif
+  delay(delay_ms);
+}
+
+void IRAM_ATTR Application::wake_loop_any_context() {
+#if defined(USE_EVENT_DRIVEN_LOOP) && defined(USE_ESP32)
+  // the eventfd is created with EFD_SUPPORT_ISR, so it can be written from ISRs too
+  if (this->wake_fds_[1] < 0 || (!xPortInIsrContext() && xTaskGetCurrentTaskHandle() == this->loop_task_handle_))
+    return;
+  const uint64_t count = 1;
+  (void) ::write(this->wake_fds_[1], &count, sizeof(count));
+#elif defined(USE_EVENT_DRIVEN_LOOP) && defined(USE_HOST)
+  if (this->wake_fds_[1] < 0 || pthread_equal(pthread_self(), this->loop_thread_))
+    return;
+  const uint8_t c = 0;
+  (void) ::write(this->wake_fds_[1], &c, 1);
+#endif
+}
+
+#ifdef USE_EVENT_DRIVEN_LOOP
+uint32_t Application::idle_loop_interval_() {
+  uint32_t interval = MAX_IDLE_SLEEP_MS;
+  for (Component *component : this->looping_components_) {
+    if (component->loop_disabled_)
+      continue;
+    interval = std::min(interval, component->get_idle_loop_interval());
+    if (interval <= this->loop_interval_)
+      break;
+  }
+  return interval;
+}
+
+bool Application::register_socket_fd(int fd) {
+#if defined(USE_ESP32) || defined(USE_HOST)
+  if (fd < 0 || fd >= FD_SETSIZE)
+    return false;
+  FD_SET(fd, &this->socket_fds_);
+  this->max_socket_fd_ = std::max(this->max_socket_fd_, fd);
+  return true;
+#else
+  return false;
+#endif
+}
+void Application::unregister_socket_fd(int fd) {
+#if defined(USE_ESP32) || defined(USE_HOST)
+  if (fd < 0 || fd >= FD_SETSIZE)
+    return;
+  FD_CLR(fd, &this->socket_fds_);
+  while (this->max_socket_fd_ >= 0 && !FD_ISSET(this->max_socket_fd_, &this->socket_fds_))
+    this->max_socket_fd_--;
+#endif
+}
+#endif
+
 void Application::calculate_looping_components_() {
   for (auto *obj : this->components_) {
     if (obj->has_overridden_loop())
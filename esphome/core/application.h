@@ -9,6 +9,18 @@
 #include "esphome/core/preferences.h"
 #include "esphome/core/scheduler.h"
 
+#ifdef USE_EVENT_DRIVEN_LOOP
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <sys/select.h>
+#endif
+#ifdef USE_HOST
+#include <pthread.h>
+#include <sys/select.h>
+#endif
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -164,6 +176,9 @@ class Application {
     return c;
   }
 
+  /// Get all registered components, in setup order once setup() has been called.
+  const std::vector<Component *> &get_components() const { return this->components_; }
+
   /// Set up all the registered components. Call this at the end of your setup() function.
   void setup();
 
@@ -201,6 +216,23 @@ class Application {
    */
   void set_loop_interval(uint32_t loop_interval) { this->loop_interval_ = loop_interval; }
 
+  /** Wake up the main loop if it is sleeping, e.g. because new work was queued from another task.
+   *
+   * Safe to call from any task and from ISRs. Only has an effect with the event-driven loop enabled on platforms
+   * that support it (ESP32 and host); elsewhere the main loop never sleeps longer than the loop interval anyway.
+   */
+  void wake_loop_any_context();
+
+#ifdef USE_EVENT_DRIVEN_LOOP
+  /** Wake up the main loop when the socket \p fd becomes readable, while it sleeps with the event-driven loop.
+   *
+   * Returns false if the main loop can't wait for sockets on this platform; components that rely on the socket to
+   * wake them must keep polling then. Only call this from the main loop, and unregister the socket before closing it.
+   */
+  bool register_socket_fd(int fd);
+  void unregister_socket_fd(int fd);
+#endif
+
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
   void feed_wdt();
@@ -381,6 +413,14 @@ class Application {
 
   void feed_wdt_arch_();
 
+  /// Sleep for at most \p delay_ms, returning early if wake_loop_any_context() is called or a registered socket
+  /// becomes readable.
+  void sleep_(uint32_t delay_ms);
+#ifdef USE_EVENT_DRIVEN_LOOP
+  /// How long the enabled loop()s can go without being called, capped at the longest idle sleep.
+  uint32_t idle_loop_interval_();
+#endif
+
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
 
@@ -446,6 +486,21 @@ class Application {
   uint32_t loop_interval_{16};
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
+  volatile bool has_pending_enable_loop_requests_{false};
+#ifdef USE_EVENT_DRIVEN_LOOP
+#ifdef USE_ESP32
+  TaskHandle_t loop_task_handle_{nullptr};
+#endif
+#ifdef USE_HOST
+  pthread_t loop_thread_{};
+#endif
+#if defined(USE_ESP32) || defined(USE_HOST)
+  /// Read and write end of the wakeup signal: an eventfd (both ends the same) on ESP32, a pipe on host.
+  int wake_fds_[2]{-1, -1};
+  fd_set socket_fds_{};
+  int max_socket_fd_{-1};
+#endif
+#endif
 };
 
 /// Global storage of Application pointer - only one Application can exist.
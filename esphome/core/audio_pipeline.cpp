@@ -0,0 +1,128 @@
+#include "audio_pipeline.h"
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+
+#ifdef USE_HOST
+#include <thread>
+#endif
+
+namespace esphome {
+
+size_t AudioStage::run() {
+  const uint32_t start = micros();
+  size_t samples = this->process();
+  if (samples != 0) {
+    const uint32_t elapsed = micros() - start;
+    this->stats_.runs++;
+    this->stats_.samples += samples;
+    this->stats_.total_us += elapsed;
+    this->stats_.max_us = std::max(this->stats_.max_us, elapsed);
+  }
+  return samples;
+}
+
+AudioResampler::AudioResampler(const char *name, uint32_t from_rate, uint32_t to_rate)
+    : AudioStage(name), step_((uint64_t(from_rate) << 16) / to_rate) {
+  this->max_outputs_per_input_ = 0x10000 / this->step_ + 1;
+  this->converted_.reserve(CHUNK * this->max_outputs_per_input_);
+}
+
+void AudioResampler::reset() {
+  this->position_ = 0;
+  this->previous_ = 0;
+}
+
+size_t AudioResampler::process() {
+  size_t consumed = 0;
+  int16_t samples[CHUNK];
+  // only convert what fits into the output, so a full consumer holds back the input
+  for (;;) {
+    size_t count = std::min({this->input_.available(), CHUNK, this->output_.free() / this->max_outputs_per_input_});
+    if (count == 0)
+      break;
+    count = this->input_.read(samples, count);
+    this->converted_.clear();
+    for (size_t i = 0; i < count; i++) {
+      const int32_t delta = int32_t(samples[i]) - this->previous_;
+      for (; this->position_ < 0x10000; this->position_ += this->step_)
+        this->converted_.push_back(this->previous_ + int16_t((int64_t(delta) * this->position_) >> 16));
+      this->position_ -= 0x10000;
+      this->previous_ = samples[i];
+    }
+    this->output_.write(this->converted_.data(), this->converted_.size());
+    consumed += count;
+  }
+  return consumed;
+}
+
+void AudioPipeline::add_stage(AudioStage *stage) {
+  LockGuard guard(this->lock_);
+  this->stages_.push_back(stage);
+}
+
+void AudioPipeline::remove_stage(AudioStage *stage) {
+  LockGuard guard(this->lock_);
+  this->stages_.erase(std::remove(this->stages_.begin(), this->stages_.end(), stage), this->stages_.end());
+}
+
+void AudioPipeline::reset_stage(AudioStage *stage) {
+  LockGuard guard(this->lock_);
+  stage->reset();
+}
+
+bool AudioPipeline::run() {
+  LockGuard guard(this->lock_);
+  bool worked = false;
+  for (auto *stage : this->stages_) {
+    if (stage->run() != 0)
+      worked = true;
+  }
+  return worked;
+}
+
+bool AudioPipeline::start_task(const char *name, uint32_t stack_size, uint8_t priority) {
+  this->task_stop_requested_.store(false, std::memory_order_relaxed);
+  if (this->is_task_running())
+    return true;  // still running, as it hadn't seen the stop request yet
+  this->task_running_.store(true, std::memory_order_release);
+#if defined(USE_ESP32)
+  TaskHandle_t handle;
+  auto task = [](void *pipeline) {
+    static_cast<AudioPipeline *>(pipeline)->task_loop_();
+    vTaskDelete(nullptr);
+  };
+  if (xTaskCreate(task, name, stack_size, this, priority, &handle) == pdPASS)
+    return true;
+#elif defined(USE_HOST)
+  std::thread([this]() { this->task_loop_(); }).detach();
+  return true;
+#endif
+  this->task_running_.store(false, std::memory_order_release);
+  return false;
+}
+
+void AudioPipeline::task_loop_() {
+  while (!this->task_stop_requested_.load(std::memory_order_relaxed)) {
+    // a source usually blocks until the device has samples, only wait here when nothing listens
+    if (!this->run())
+      delay(1);
+  }
+  this->task_running_.store(false, std::memory_order_release);
+}
+
+void AudioPipeline::log_stats(const char *tag) {
+  LockGuard guard(this->lock_);
+  for (auto *stage : this->stages_) {
+    const AudioStage::Stats &stats = stage->get_stats();
+    if (stats.runs != 0) {
+      ESP_LOGD(tag, "%s: %" PRIu32 " runs, %" PRIu64 " samples, %" PRIu32 " us average, %" PRIu32 " us max",
+               stage->get_name(), stats.runs, stats.samples, uint32_t(stats.total_us / stats.runs), stats.max_us);
+    }
+    stage->reset_stats();
+  }
+}
+
+}  // namespace esphome
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "esphome/core/helpers.h"
+#include "esphome/core/ring_buffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace esphome {
+
+/** Bounded queue of samples between two audio stages, for one writer and one reader that may run on different tasks.
+ *
+ * Only whole samples are queued. When the queue is full, write() stores what fits and counts the rest as dropped.
+ */
+template<typename T> class AudioQueue {
+  static_assert(std::is_trivially_copyable<T>::value, "samples are copied as bytes");
+
+ public:
+  /// Allocate room for \p capacity samples, false if that failed.
+  bool init(size_t capacity) {
+    this->ring_buffer_ = RingBuffer::create(capacity * sizeof(T));
+    this->capacity_ = this->ring_buffer_ == nullptr ? 0 : capacity;
+    return this->ring_buffer_ != nullptr;
+  }
+  size_t capacity() const { return this->capacity_; }
+  /// Number of samples queued.
+  size_t available() const { return this->ring_buffer_->available() / sizeof(T); }
+  /// Number of samples that can be queued.
+  size_t free() const { return this->ring_buffer_->free() / sizeof(T); }
+
+  /// Queue up to \p count samples, return how many fit.
+  size_t write(const T *data, size_t count) {
+    size_t fits = std::min(count, this->free());
+    this->ring_buffer_->write(data, fits * sizeof(T));
+    if (fits != count)
+      this->dropped_.fetch_add(count - fits, std::memory_order_relaxed);
+    size_t queued = this->available();
+    if (queued > this->max_queued_.load(std::memory_order_relaxed))
+      this->max_queued_.store(queued, std::memory_order_relaxed);
+    return fits;
+  }
+  /// Copy up to \p count samples into \p data, return how many were read.
+  size_t read(T *data, size_t count) { return this->ring_buffer_->read(data, count * sizeof(T)) / sizeof(T); }
+  /// Get up to \p count contiguous samples without copying them, and store how many in \p peeked.
+  const T *peek(size_t count, size_t *peeked) {
+    const uint8_t *data = this->ring_buffer_->peek_read(count * sizeof(T), peeked);
+    *peeked /= sizeof(T);
+    return reinterpret_cast<const T *>(data);
+  }
+  /// Remove up to \p count of the oldest samples, return how many were removed.
+  size_t skip(size_t count) {
+    count = std::min(count, this->available());
+    this->ring_buffer_->consume(count * sizeof(T));
+    return count;
+  }
+
+  /// Remove all samples and clear the counters, only while nothing writes to the queue.
+  void reset() {
+    this->ring_buffer_->reset();
+    this->dropped_.store(0, std::memory_order_relaxed);
+    this->max_queued_.store(0, std::memory_order_relaxed);
+  }
+  /// Samples that didn't fit into the queue since the last reset().
+  uint32_t get_dropped() const { return this->dropped_.load(std::memory_order_relaxed); }
+  /// Most samples queued at once since the last reset(), i.e. the worst latency the queue added.
+  size_t get_max_queued() const { return this->max_queued_.load(std::memory_order_relaxed); }
+
+ protected:
+  std::unique_ptr<RingBuffer> ring_buffer_;
+  size_t capacity_{0};
+  std::atomic<uint32_t> dropped_{0};
+  std::atomic<size_t> max_queued_{0};
+};
+
+/** Output of a stage, which passes the same samples to every connected queue.
+ *
+ * Connections are changed through AudioPipeline::connect() and disconnect(), which keep them from changing while the
+ * pipeline runs on its task.
+ */
+template<typename T> class AudioOutput {
+ public:
+  bool is_connected() const { return !this->queues_.empty(); }
+  /// Number of samples that fit into every connected queue, 0 when nothing is connected.
+  size_t free() const {
+    if (this->queues_.empty())
+      return 0;
+    size_t free = SIZE_MAX;
+    for (auto *queue : this->queues_)
+      free = std::min(free, queue->free());
+    return free;
+  }
+  /// Pass \p count samples to every connected queue. Each queue drops what doesn't fit into it.
+  void write(const T *data, size_t count) {
+    for (auto *queue : this->queues_)
+      queue->write(data, count);
+  }
+
+ protected:
+  friend class AudioPipeline;
+
+  void connect_(AudioQueue<T> *queue) {
+    if (std::find(this->queues_.begin(), this->queues_.end(), queue) == this->queues_.end())
+      this->queues_.push_back(queue);
+  }
+  void disconnect_(AudioQueue<T> *queue) {
+    this->queues_.erase(std::remove(this->queues_.begin(), this->queues_.end(), queue), this->queues_.end());
+  }
+
+  std::vector<AudioQueue<T> *> queues_;
+};
+
+/** A step of an audio pipeline, which takes samples from its input queue and writes the results to its output.
+ *
+ * Stages that can wait only process as many samples as fit into every queue connected to their output, so a slow
+ * consumer holds back the stages before it until their input queues fill up. Only the source, which can't wait for
+ * the hardware, drops samples, and only for the queues that are full.
+ */
+class AudioStage {
+ public:
+  struct Stats {
+    /// Number of process() calls that did something.
+    uint32_t runs;
+    /// Samples consumed or produced by these calls.
+    uint64_t samples;
+    /// Total and longest time spent in these calls, for a source including the wait for the device.
+    uint64_t total_us;
+    uint32_t max_us;
+  };
+
+  explicit AudioStage(const char *name) : name_(name) {}
+  virtual ~AudioStage() = default;
+
+  const char *get_name() const { return this->name_; }
+  const Stats &get_stats() const { return this->stats_; }
+  void reset_stats() { this->stats_ = Stats{}; }
+
+  /// Run process(), and count the time it took if it did something.
+  size_t run();
+  /// Start over, as if no samples had been processed yet. See AudioPipeline::reset_stage().
+  virtual void reset() {}
+
+ protected:
+  /// Process what is ready and return the number of samples consumed or produced, 0 if there was nothing to do.
+  virtual size_t process() = 0;
+
+  const char *name_;
+  Stats stats_{};
+};
+
+/// Stage that reads up to \p chunk samples at a time from a device, and passes them on as they are.
+template<typename T> class AudioSource : public AudioStage {
+ public:
+  /// Reads up to the given number of samples into the buffer, and returns how many were read.
+  using Reader = std::function<size_t(T *, size_t)>;
+
+  AudioSource(const char *name, size_t chunk, Reader &&reader)
+      : AudioStage(name), chunk_(chunk), reader_(std::move(reader)) {}
+
+  AudioOutput<T> &output() { return this->output_; }
+  size_t get_chunk() const { return this->chunk_; }
+
+ protected:
+  size_t process() override {
+    // only read while someone listens, the device may block until it has samples
+    if (!this->output_.is_connected())
+      return 0;
+    this->buffer_.resize(this->chunk_);
+    size_t count = this->reader_(this->buffer_.data(), this->chunk_);
+    this->output_.write(this->buffer_.data(), count);
+    return count;
+  }
+
+  size_t chunk_;
+  Reader reader_;
+  std::vector<T> buffer_;
+  AudioOutput<T> output_;
+};
+
+/// Stage that converts 16-bit audio from one sample rate to another, interpolating linearly between samples.
+class AudioResampler : public AudioStage {
+ public:
+  AudioResampler(const char *name, uint32_t from_rate, uint32_t to_rate);
+
+  AudioQueue<int16_t> &input() { return this->input_; }
+  AudioOutput<int16_t> &output() { return this->output_; }
+  void reset() override;
+
+ protected:
+  /// Input samples converted at once.
+  static constexpr size_t CHUNK = 256;
+
+  size_t process() override;
+
+  AudioQueue<int16_t> input_;
+  AudioOutput<int16_t> output_;
+  /// Input samples per output sample, in 16.16 fixed point.
+  uint32_t step_;
+  /// Most output samples an input sample can produce.
+  size_t max_outputs_per_input_;
+  /// Position of the next output sample after previous_, in 16.16 fixed point.
+  uint32_t position_{0};
+  int16_t previous_{0};
+  std::vector<int16_t> converted_;
+};
+
+/** Stage that cuts samples into overlapping windows, and turns each window into a frame of values, e.g. features.
+ *
+ * Every \p stride new samples, \p extract is called with the last \p window samples (zeros before the first ones) and
+ * writes \p frame_size values; if it returns false, the frame is skipped.
+ */
+template<typename In, typename Out> class AudioFramer : public AudioStage {
+ public:
+  using Extractor = std::function<bool(const In *window, Out *frame)>;
+
+  AudioFramer(const char *name, size_t window, size_t stride, size_t frame_size, Extractor &&extract)
+      : AudioStage(name),
+        stride_(stride),
+        extract_(std::move(extract)),
+        window_(std::max(window, stride)),
+        frame_(frame_size) {}
+
+  AudioQueue<In> &input() { return this->input_; }
+  AudioOutput<Out> &output() { return this->output_; }
+  void reset() override { std::fill(this->window_.begin(), this->window_.end(), In{}); }
+
+ protected:
+  size_t process() override {
+    size_t consumed = 0;
+    const size_t history = this->window_.size() - this->stride_;
+    while (this->input_.available() >= this->stride_ && this->output_.free() >= this->frame_.size()) {
+      memmove(this->window_.data(), this->window_.data() + this->stride_, history * sizeof(In));
+      this->input_.read(this->window_.data() + history, this->stride_);
+      consumed += this->stride_;
+      if (this->extract_(this->window_.data(), this->frame_.data()))
+        this->output_.write(this->frame_.data(), this->frame_.size());
+    }
+    return consumed;
+  }
+
+  size_t stride_;
+  Extractor extract_;
+  std::vector<In> window_;
+  std::vector<Out> frame_;
+  AudioQueue<In> input_;
+  AudioOutput<Out> output_;
+};
+
+/** Runs a graph of audio stages, from the main loop or on a task of its own.
+ *
+ * Each run() runs the stages once, in the order they were added. As that follows the flow of the audio, the samples
+ * read by the source pass through the whole graph in one run().
+ */
+class AudioPipeline {
+ public:
+  /// Add \p stage after the stages added before.
+  void add_stage(AudioStage *stage);
+  void remove_stage(AudioStage *stage);
+
+  /// Pass the samples of \p output to \p queue from now on. The queue is emptied first.
+  template<typename T> void connect(AudioOutput<T> &output, AudioQueue<T> &queue) {
+    LockGuard guard(this->lock_);
+    queue.reset();
+    output.connect_(&queue);
+  }
+  template<typename T> void disconnect(AudioOutput<T> &output, AudioQueue<T> &queue) {
+    LockGuard guard(this->lock_);
+    output.disconnect_(&queue);
+  }
+  /// Reset \p stage, e.g. before it gets audio again, while it isn't running.
+  void reset_stage(AudioStage *stage);
+
+  /// Run every stage once, return whether any did something.
+  bool run();
+
+  /** Call run() from a task of its own until stop_task(), so blocking reads and slow stages don't hold up the loop.
+   *
+   * Only supported on ESP32 and host, returns false elsewhere or when the task couldn't be started.
+   */
+  bool start_task(const char *name, uint32_t stack_size, uint8_t priority);
+  /// Ask the task to stop after its current run(); is_task_running() tells when it has.
+  void stop_task() { this->task_stop_requested_.store(true, std::memory_order_relaxed); }
+  bool is_task_running() const { return this->task_running_.load(std::memory_order_acquire); }
+
+  /// Log the counters of every stage and reset them.
+  void log_stats(const char *tag);
+
+ protected:
+  void task_loop_();
+
+  Mutex lock_;
+  std::vector<AudioStage *> stages_;
+  std::atomic<bool> task_running_{false};
+  std::atomic<bool> task_stop_requested_{false};
+};
+
+}  // namespace esphome
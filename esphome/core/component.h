@@ -5,6 +5,7 @@
 #include <functional>
 #include <string>
 
+#include "esphome/core/loop_profile.h"
 #include "esphome/core/optional.h"
 
 namespace esphome {
@@ -103,6 +104,14 @@ class Component {
    */
   virtual float get_loop_priority() const;
 
+  /** How long loop() may go without being called while the main loop has nothing else to do.
+   *
+   * Only used with the event-driven loop. By default, an enabled loop() keeps the main loop polling at the loop
+   * interval. Components that get woken when they have work, by a socket registered with App.register_socket_fd(),
+   * App.wake_loop_any_context() or a timeout, can return a longer interval, up to UINT32_MAX for "never".
+   */
+  virtual uint32_t get_idle_loop_interval() { return 0; }
+
   void call();
 
   virtual void on_shutdown() {}
@@ -142,6 +151,32 @@ class Component {
 
   bool has_overridden_loop() const;
 
+  /** Stop calling loop() for this component until enable_loop() is called.
+   *
+   * Components whose loop() only waits for an event (a flag set by an ISR, a queue filled by another task, ...)
+   * should disable their loop while idle, so that the main loop can sleep longer. Timeouts and intervals are not
+   * affected.
+   */
+  void disable_loop();
+
+  /// Resume calling loop() for this component. Must be called from the main loop.
+  void enable_loop();
+
+  /** Resume calling loop() for this component at the start of the next main loop iteration.
+   *
+   * Unlike enable_loop(), this is safe to call from ISRs and other tasks, and wakes the main loop if it is sleeping.
+   */
+  void enable_loop_soon_any_context();
+
+  bool is_loop_enabled() const { return !this->loop_disabled_; }
+
+#ifdef USE_LOOP_PROFILER
+  /// Timing statistics of this component's loop() calls.
+  LoopProfile &get_loop_profile() { return this->loop_profile_; }
+  /// Timing statistics of this component's timeouts, intervals and retries.
+  LoopProfile &get_scheduler_profile() { return this->scheduler_profile_; }
+#endif
+
   /** Set where this component was loaded from for some debug messages.
    *
    * This is set by the ESPHome core, and should not be called manually.
@@ -177,6 +212,12 @@ class Component {
    */
   void set_interval(const std::string &name, uint32_t interval, std::function<void()> &&f);  // NOLINT
 
+  /** Set an interval function with a static name.
+   *
+   * Same as set_interval(), but the name is not copied: it must be a string literal or otherwise outlive the interval.
+   */
+  void set_interval_static(const char *name, uint32_t interval, std::function<void()> &&f);  // NOLINT
+
   void set_interval(uint32_t interval, std::function<void()> &&f);  // NOLINT
 
   /** Cancel an interval function.
@@ -185,6 +226,7 @@ class Component {
    * @return Whether an interval functions was deleted.
    */
   bool cancel_interval(const std::string &name);  // NOLINT
+  bool cancel_interval(const char *name);         // NOLINT
 
   /** Set an retry function with a unique name. Empty name means no cancelling possible.
    *
@@ -245,6 +287,12 @@ class Component {
    */
   void set_timeout(const std::string &name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
+  /** Set a timeout function with a static name.
+   *
+   * Same as set_timeout(), but the name is not copied: it must be a string literal or otherwise outlive the timeout.
+   */
+  void set_timeout_static(const char *name, uint32_t timeout, std::function<void()> &&f);  // NOLINT
+
   void set_timeout(uint32_t timeout, std::function<void()> &&f);  // NOLINT
 
   /** Cancel a timeout function.
@@ -253,6 +301,7 @@ class Component {
    * @return Whether a timeout functions was deleted.
    */
   bool cancel_timeout(const std::string &name);  // NOLINT
+  bool cancel_timeout(const char *name);         // NOLINT
 
   /** Defer a callback to the next loop() call.
    *
@@ -262,16 +311,25 @@ class Component {
    * @param f The callback.
    */
   void defer(const std::string &name, std::function<void()> &&f);  // NOLINT
+  /// Same as defer(), but the name is not copied: it must be a string literal or otherwise outlive the callback.
+  void defer_static(const char *name, std::function<void()> &&f);  // NOLINT
 
   /// Defer a callback to the next loop() call.
   void defer(std::function<void()> &&f);  // NOLINT
 
   /// Cancel a defer callback using the specified name, name must not be empty.
   bool cancel_defer(const std::string &name);  // NOLINT
+  bool cancel_defer(const char *name);         // NOLINT
 
   uint32_t component_state_{0x0000};  ///< State of this component.
   float setup_priority_override_{NAN};
   const char *component_source_{nullptr};
+  bool loop_disabled_{false};
+  volatile bool pending_enable_loop_{false};
+#ifdef USE_LOOP_PROFILER
+  LoopProfile loop_profile_;
+  LoopProfile scheduler_profile_;
+#endif
 };
 
 /** This class simplifies creating components that periodically check a state.
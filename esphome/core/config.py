@@ -116,6 +116,7 @@ else:
 
 
 CONF_ESP8266_RESTORE_FROM_FLASH = "esp8266_restore_from_flash"
+CONF_EVENT_DRIVEN_LOOP = "event_driven_loop"
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -149,6 +150,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_INCLUDES, default=[]): cv.ensure_list(valid_include),
             cv.Optional(CONF_LIBRARIES, default=[]): cv.ensure_list(cv.string_strict),
             cv.Optional(CONF_NAME_ADD_MAC_SUFFIX, default=False): cv.boolean,
+            cv.Optional(CONF_EVENT_DRIVEN_LOOP, default=False): cv.boolean,
             cv.Optional(CONF_PROJECT): cv.Schema(
                 {
                     cv.Required(CONF_NAME): cv.All(
@@ -365,6 +367,9 @@ async def to_code(config):
 
     cg.add_build_flag("-fno-exceptions")
 
+    if config[CONF_EVENT_DRIVEN_LOOP]:
+        cg.add_define("USE_EVENT_DRIVEN_LOOP")
+
     # Libraries
     for lib in config[CONF_LIBRARIES]:
         if "@" in lib:
@@ -24,6 +24,7 @@
 #define USE_CLIMATE
 #define USE_COVER
 #define USE_DEEP_SLEEP
+#define USE_EVENT_DRIVEN_LOOP
 #define USE_FAN
 #define USE_GRAPH
 #define USE_HOMEASSISTANT_TIME
@@ -31,6 +32,7 @@
 #define USE_LIGHT
 #define USE_LOCK
 #define USE_LOGGER
+#define USE_LOOP_PROFILER
 #define USE_MDNS
 #define USE_MEDIA_PLAYER
 #define USE_MQTT
@@ -79,6 +81,7 @@
 #define USE_ESP32_BLE_SERVER
 #define USE_ESP32_CAMERA
 #define USE_IMPROV
+#define USE_LOGGER_TASK_LOG_BUFFER
 #define USE_SOCKET_IMPL_BSD_SOCKETS
 #define USE_WIFI_11KV_SUPPORT
 #define USE_BLUETOOTH_PROXY
@@ -126,6 +129,7 @@
 #endif
 
 #ifdef USE_HOST
+#define USE_LOGGER_TASK_LOG_BUFFER
 #define USE_SOCKET_IMPL_BSD_SOCKETS
 #endif
 
@@ -189,6 +189,14 @@ uint32_t fnv1_hash(const std::string &str) {
   }
   return hash;
 }
+uint32_t fnv1_hash(const char *str) {
+  uint32_t hash = 2166136261UL;
+  for (; *str != '\0'; str++) {
+    hash *= 16777619UL;
+    hash ^= *str;
+  }
+  return hash;
+}
 
 uint32_t random_uint32() {
 #ifdef USE_ESP32
@@ -517,12 +525,17 @@ void hsv_to_rgb(int hue, float saturation, float value, float &red, float &green
 }
 
 // System APIs
-#if defined(USE_ESP8266) || defined(USE_RP2040) || defined(USE_HOST)
+#if defined(USE_ESP8266) || defined(USE_RP2040)
 // ESP8266 doesn't have mutexes, but that shouldn't be an issue as it's single-core and non-preemptive OS.
 Mutex::Mutex() {}
 void Mutex::lock() {}
 bool Mutex::try_lock() { return true; }
 void Mutex::unlock() {}
+#elif defined(USE_HOST)
+Mutex::Mutex() {}
+void Mutex::lock() { this->mutex_.lock(); }
+bool Mutex::try_lock() { return this->mutex_.try_lock(); }
+void Mutex::unlock() { this->mutex_.unlock(); }
 #elif defined(USE_ESP32) || defined(USE_LIBRETINY)
 Mutex::Mutex() { handle_ = xSemaphoreCreateMutex(); }
 void Mutex::lock() { xSemaphoreTake(this->handle_, portMAX_DELAY); }
@@ -22,6 +22,10 @@
 #include <semphr.h>
 #endif
 
+#ifdef USE_HOST
+#include <mutex>
+#endif
+
 #define HOT __attribute__((hot))
 #define ESPDEPRECATED(msg, when) __attribute__((deprecated(msg)))
 #define ALWAYS_INLINE __attribute__((always_inline))
@@ -165,6 +169,8 @@ uint16_t crc16be(const uint8_t *data, uint16_t len, uint16_t crc = 0, uint16_t p
 
 /// Calculate a FNV-1 hash of \p str.
 uint32_t fnv1_hash(const std::string &str);
+/// Calculate a FNV-1 hash of the null-terminated string \p str.
+uint32_t fnv1_hash(const char *str);
 
 /// Return a random 32-bit unsigned integer.
 uint32_t random_uint32();
@@ -548,6 +554,9 @@ class Mutex {
  private:
 #if defined(USE_ESP32) || defined(USE_LIBRETINY)
   SemaphoreHandle_t handle_;
+#elif defined(USE_HOST)
+  // host components can run on threads of their own, e.g. an audio pipeline task
+  std::mutex mutex_;
 #endif
 };
 
@@ -673,6 +682,10 @@ template<class T> class ExternalRAMAllocator {
     free(p);  // NOLINT(cppcoreguidelines-owning-memory,cppcoreguidelines-no-malloc)
   }
 
+  // memory from any instance is released with free(), so containers can move it between instances
+  template<class U> bool operator==(const ExternalRAMAllocator<U> &other) const { return true; }
+  template<class U> bool operator!=(const ExternalRAMAllocator<U> &other) const { return false; }
+
  private:
   Flags flags_{Flags::NONE};
 };
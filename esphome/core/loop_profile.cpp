@@ -0,0 +1,61 @@
+#include "esphome/core/loop_profile.h"
+#include "esphome/core/hal.h"
+
+#ifdef USE_LOOP_PROFILER
+
+namespace esphome {
+
+static const uint32_t FIRST_BUCKET_LIMIT_US = 64;
+
+void LoopProfile::record(uint32_t duration_us) {
+  this->count_++;
+  this->total_us_ += duration_us;
+  if (duration_us < this->min_us_)
+    this->min_us_ = duration_us;
+  if (duration_us > this->max_us_)
+    this->max_us_ = duration_us;
+
+  uint8_t bucket = 0;
+  uint32_t limit = FIRST_BUCKET_LIMIT_US;
+  while (bucket < BUCKET_COUNT - 1 && duration_us >= limit) {
+    bucket++;
+    limit <<= 1;
+  }
+  if (this->buckets_[bucket] != UINT16_MAX)
+    this->buckets_[bucket]++;
+}
+void LoopProfile::reset() { *this = LoopProfile(); }
+uint32_t LoopProfile::get_avg_us() const {
+  if (this->count_ == 0)
+    return 0;
+  return this->total_us_ / this->count_;
+}
+uint32_t LoopProfile::get_percentile_us(uint8_t percentile) const {
+  // Bucket counts saturate, so use their sum rather than count_ as the total.
+  uint32_t total = 0;
+  for (uint16_t bucket : this->buckets_)
+    total += bucket;
+  if (total == 0)
+    return 0;
+
+  const uint32_t target = (total * percentile + 99) / 100;
+  uint32_t seen = 0;
+  uint32_t limit = FIRST_BUCKET_LIMIT_US;
+  for (uint8_t i = 0; i < BUCKET_COUNT - 1; i++, limit <<= 1) {
+    seen += this->buckets_[i];
+    if (seen >= target)
+      return limit < this->max_us_ ? limit : this->max_us_;
+  }
+  return this->max_us_;
+}
+
+LoopProfileGuard::LoopProfileGuard(LoopProfile *profile)
+    : profile_(profile), started_(profile == nullptr ? 0 : micros()) {}
+LoopProfileGuard::~LoopProfileGuard() {
+  if (this->profile_ != nullptr)
+    this->profile_->record(micros() - this->started_);
+}
+
+}  // namespace esphome
+
+#endif  // USE_LOOP_PROFILER
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOOP_PROFILER
+
+namespace esphome {
+
+/** Fixed-size latency statistics for a single source of main loop work (a component's loop(), its scheduler
+ * callbacks, or the handler of an API message type).
+ *
+ * Durations are recorded into a histogram of power-of-two buckets, so that percentiles can be estimated without
+ * keeping individual samples. Only compiled in with `USE_LOOP_PROFILER`.
+ */
+class LoopProfile {
+ public:
+  static const uint8_t BUCKET_COUNT = 12;
+
+  void record(uint32_t duration_us);
+  void reset();
+
+  uint32_t get_count() const { return this->count_; }
+  uint32_t get_min_us() const { return this->count_ == 0 ? 0 : this->min_us_; }
+  uint32_t get_max_us() const { return this->max_us_; }
+  uint32_t get_avg_us() const;
+  /// Estimate the given percentile (0-100) from the histogram, rounded up to the bucket boundary.
+  uint32_t get_percentile_us(uint8_t percentile) const;
+
+ protected:
+  uint32_t count_{0};
+  uint32_t min_us_{UINT32_MAX};
+  uint32_t max_us_{0};
+  uint64_t total_us_{0};
+  // Bucket i counts durations below 64us << i, the last bucket counts everything else.
+  uint16_t buckets_[BUCKET_COUNT]{};
+};
+
+/// Helper class that records the duration of its own lifetime into a LoopProfile. Does nothing if \p profile is null.
+class LoopProfileGuard {
+ public:
+  explicit LoopProfileGuard(LoopProfile *profile);
+  ~LoopProfileGuard();
+
+ protected:
+  LoopProfile *profile_;
+  uint32_t started_;
+};
+
+}  // namespace esphome
+
+#endif  // USE_LOOP_PROFILER
@@ -1,50 +1,102 @@
 #include "ring_buffer.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 
-#ifdef USE_ESP32
-
-#include "helpers.h"
-
 namespace esphome {
 
 static const char *const TAG = "ring_buffer";
 
+RingBuffer::~RingBuffer() {
+  if (this->storage_ != nullptr) {
+    ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
+    allocator.deallocate(this->storage_, this->size_);
+  }
+}
+
 std::unique_ptr<RingBuffer> RingBuffer::create(size_t len) {
   std::unique_ptr<RingBuffer> rb = make_unique<RingBuffer>();
 
   ExternalRAMAllocator<uint8_t> allocator(ExternalRAMAllocator<uint8_t>::ALLOW_FAILURE);
-  rb->storage_ = allocator.allocate(len + 1);
+  rb->storage_ = allocator.allocate(len);
   if (rb->storage_ == nullptr) {
     return nullptr;
   }
+  rb->size_ = len;
 
-  rb->handle_ = xStreamBufferCreateStatic(len + 1, 0, rb->storage_, &rb->structure_);
-  ESP_LOGD(TAG, "Created ring buffer with size %u", len);
+  ESP_LOGD(TAG, "Created ring buffer with size %zu", len);
   return rb;
 }
 
-size_t RingBuffer::read(void *data, size_t len, TickType_t ticks_to_wait) {
-  return xStreamBufferReceive(this->handle_, data, len, ticks_to_wait);
+size_t RingBuffer::read(void *data, size_t len) {
+  size_t bytes_read = 0;
+  // the data may wrap around the end of the storage once
+  for (int part = 0; part < 2 && bytes_read < len; part++) {
+    size_t peeked;
+    const uint8_t *span = this->peek_read(len - bytes_read, &peeked);
+    if (peeked == 0)
+      break;
+    memcpy(static_cast<uint8_t *>(data) + bytes_read, span, peeked);
+    this->consume(peeked);
+    bytes_read += peeked;
+  }
+  return bytes_read;
 }
 
-size_t RingBuffer::write(void *data, size_t len) {
-  size_t free = this->free();
-  if (free < len) {
-    size_t needed = len - free;
-    uint8_t discard[needed];
-    xStreamBufferReceive(this->handle_, discard, needed, 0);
+size_t RingBuffer::write(const void *data, size_t len) {
+  size_t bytes_written = 0;
+  for (int part = 0; part < 2 && bytes_written < len; part++) {
+    size_t acquired;
+    uint8_t *span = this->acquire_write(len - bytes_written, &acquired);
+    if (acquired == 0)
+      break;
+    memcpy(span, static_cast<const uint8_t *>(data) + bytes_written, acquired);
+    this->commit(acquired);
+    bytes_written += acquired;
   }
-  return xStreamBufferSend(this->handle_, data, len, 0);
+  return bytes_written;
+}
+
+uint8_t *RingBuffer::acquire_write(size_t len, size_t *acquired) {
+  const size_t head = this->head_.load(std::memory_order_relaxed);
+  const size_t tail = this->tail_.load(std::memory_order_acquire);
+  const size_t position = this->position_(head);
+  *acquired = std::min({len, this->size_ - this->used_(head, tail), this->size_ - position});
+  return this->storage_ + position;
 }
 
-size_t RingBuffer::available() const { return xStreamBufferBytesAvailable(this->handle_); }
+void RingBuffer::commit(size_t len) {
+  const size_t head = this->head_.load(std::memory_order_relaxed);
+  // publish the written bytes to the reader
+  this->head_.store(this->advance_(head, len), std::memory_order_release);
+}
 
-size_t RingBuffer::free() const { return xStreamBufferSpacesAvailable(this->handle_); }
+const uint8_t *RingBuffer::peek_read(size_t len, size_t *peeked) {
+  const size_t tail = this->tail_.load(std::memory_order_relaxed);
+  const size_t head = this->head_.load(std::memory_order_acquire);
+  const size_t position = this->position_(tail);
+  *peeked = std::min({len, this->used_(head, tail), this->size_ - position});
+  return this->storage_ + position;
+}
 
-BaseType_t RingBuffer::reset() { return xStreamBufferReset(this->handle_); }
+void RingBuffer::consume(size_t len) {
+  const size_t tail = this->tail_.load(std::memory_order_relaxed);
+  // hand the space back to the writer only after the reader is done with it
+  this->tail_.store(this->advance_(tail, len), std::memory_order_release);
+}
 
-}  // namespace esphome
+size_t RingBuffer::available() const {
+  return this->used_(this->head_.load(std::memory_order_acquire), this->tail_.load(std::memory_order_acquire));
+}
 
-#endif
+size_t RingBuffer::free() const { return this->size_ - this->available(); }
+
+void RingBuffer::reset() {
+  this->tail_.store(0, std::memory_order_relaxed);
+  this->head_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace esphome
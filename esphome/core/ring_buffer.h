@@ -1,34 +1,60 @@
 #pragma once
 
-#ifdef USE_ESP32
-
-#include <freertos/FreeRTOS.h>
-#include <freertos/stream_buffer.h>
-
+#include <atomic>
 #include <cinttypes>
+#include <cstddef>
 #include <memory>
 
 namespace esphome {
 
+/** Lock-free ring buffer of bytes for one writer and one reader, which may run on different tasks.
+ *
+ * Besides copying with read() and write(), the buffer can be accessed in place: acquire_write() returns contiguous
+ * free space to fill and commit(), and peek_read() returns contiguous data to process and consume(). A span ends at
+ * the end of the storage, so fewer bytes than requested may be returned even though more are free or available.
+ *
+ * Only the writer may call write(), acquire_write() and commit(), and only the reader read(), peek_read() and
+ * consume(). reset() must only be called while neither side is using the buffer, or when both run on the same task.
+ */
 class RingBuffer {
  public:
-  size_t read(void *data, size_t len, TickType_t ticks_to_wait = 0);
-
-  size_t write(void *data, size_t len);
+  ~RingBuffer();
+
+  /// Copy up to \p len bytes into \p data, return the number of bytes read.
+  size_t read(void *data, size_t len);
+  /// Copy as much of \p data as fits into the buffer, return the number of bytes written.
+  size_t write(const void *data, size_t len);
+
+  /// Get contiguous free space for up to \p len bytes, and store its size in \p acquired (0 when full).
+  uint8_t *acquire_write(size_t len, size_t *acquired);
+  /// Make \p len bytes written to the space returned by acquire_write() available to the reader.
+  void commit(size_t len);
+  /// Get up to \p len bytes of contiguous data, and store its size in \p peeked (0 when empty).
+  const uint8_t *peek_read(size_t len, size_t *peeked);
+  /// Release \p len bytes of the data returned by peek_read(), making room for the writer.
+  void consume(size_t len);
 
   size_t available() const;
   size_t free() const;
 
-  BaseType_t reset();
+  void reset();
 
   static std::unique_ptr<RingBuffer> create(size_t len);
 
  protected:
-  StreamBufferHandle_t handle_;
-  StaticStreamBuffer_t structure_;
-  uint8_t *storage_;
+  /// Number of bytes between the read index \p tail and the write index \p head.
+  size_t used_(size_t head, size_t tail) const { return head >= tail ? head - tail : head + 2 * this->size_ - tail; }
+  size_t position_(size_t index) const { return index < this->size_ ? index : index - this->size_; }
+  size_t advance_(size_t index, size_t len) const {
+    index += len;
+    return index < 2 * this->size_ ? index : index - 2 * this->size_;
+  }
+
+  uint8_t *storage_{nullptr};
+  size_t size_{0};
+  /// The indices count up to twice the size, so a full buffer can be told from an empty one without wasting a byte.
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
 };
 
 }  // namespace esphome
-
-#endif
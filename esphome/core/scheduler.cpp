@@ -1,15 +1,19 @@
 #include "scheduler.h"
+#include "esphome/core/application.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/hal.h"
 #include <algorithm>
 #include <cinttypes>
+#include <cstring>
 
 namespace esphome {
 
 static const char *const TAG = "scheduler";
 
 static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
+// Maximum number of finished items kept for reuse. Most nodes have far fewer timeouts in flight at any given time.
+static const size_t MAX_POOL_SIZE = 16;
 
 // Uncomment to debug scheduler
 // #define ESPHOME_DEBUG_SCHEDULER
@@ -17,65 +21,83 @@ static const uint32_t MAX_LOGICALLY_DELETED_ITEMS = 10;
 // A note on locking: the `lock_` lock protects the `items_` and `to_add_` containers. It must be taken when writing to
 // them (i.e. when adding/removing items, but not when changing items). As items are only deleted from the loop task,
 // iterating over them from the loop task is fine; but iterating from any other context requires the lock to be held to
-// avoid the main thread modifying the list while it is being accessed.
+// avoid the main thread modifying the list while it is being accessed. The same lock also protects `index_`, which
+// holds a pointer to every named item that hasn't been cancelled yet, regardless of which container it's in.
 
-void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
-                                std::function<void()> func) {
+void HOT Scheduler::set_timer_common_(Component *component, SchedulerItem::Type type, const char *name,
+                                      bool name_is_static, uint32_t delay, std::function<void()> func) {
   const uint32_t now = this->millis_();
 
-  if (!name.empty())
-    this->cancel_timeout(component, name);
+  if (name == nullptr)
+    name = "";
+  if (name[0] != '\0')
+    this->cancel_item_(component, name, type);
 
-  if (timeout == SCHEDULER_DONT_RUN)
+  if (delay == SCHEDULER_DONT_RUN)
     return;
 
-  ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%" PRIu32 ")", name.c_str(), timeout);
-
-  auto item = make_unique<SchedulerItem>();
+  auto item = this->acquire_item_();
   item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::TIMEOUT;
-  item->timeout = timeout;
+  if (name_is_static) {
+    item->name = name;
+  } else {
+    item->dynamic_name = name;
+    item->name = item->dynamic_name.c_str();
+  }
+  item->type = type;
+  item->interval = delay;
   item->last_execution = now;
   item->last_execution_major = this->millis_major_;
+  if (type == SchedulerItem::INTERVAL) {
+    // only put offset in lower half
+    uint32_t offset = 0;
+    if (delay != 0)
+      offset = (random_uint32() % delay) / 2;
+
+    ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", name, delay, offset);
+
+    item->last_execution = now - offset - delay;
+    if (item->last_execution > now)
+      item->last_execution_major--;
+  } else {
+    ESP_LOGVV(TAG, "set_timeout(name='%s', timeout=%" PRIu32 ")", name, delay);
+  }
   item->callback = std::move(func);
   item->remove = false;
+  item->key = name[0] == '\0' ? 0 : make_key_(component, name, type);
   this->push_(std::move(item));
+#ifdef USE_EVENT_DRIVEN_LOOP
+  // The main loop may be sleeping until a later deadline if this was called from another task.
+  App.wake_loop_any_context();
+#endif
+}
+
+void HOT Scheduler::set_timeout(Component *component, const std::string &name, uint32_t timeout,
+                                std::function<void()> func) {
+  this->set_timer_common_(component, SchedulerItem::TIMEOUT, name.c_str(), false, timeout, std::move(func));
+}
+void HOT Scheduler::set_timeout_static(Component *component, const char *name, uint32_t timeout,
+                                       std::function<void()> func) {
+  this->set_timer_common_(component, SchedulerItem::TIMEOUT, name, true, timeout, std::move(func));
 }
 bool HOT Scheduler::cancel_timeout(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name.c_str(), SchedulerItem::TIMEOUT);
+}
+bool HOT Scheduler::cancel_timeout(Component *component, const char *name) {
   return this->cancel_item_(component, name, SchedulerItem::TIMEOUT);
 }
 void HOT Scheduler::set_interval(Component *component, const std::string &name, uint32_t interval,
                                  std::function<void()> func) {
-  const uint32_t now = this->millis_();
-
-  if (!name.empty())
-    this->cancel_interval(component, name);
-
-  if (interval == SCHEDULER_DONT_RUN)
-    return;
-
-  // only put offset in lower half
-  uint32_t offset = 0;
-  if (interval != 0)
-    offset = (random_uint32() % interval) / 2;
-
-  ESP_LOGVV(TAG, "set_interval(name='%s', interval=%" PRIu32 ", offset=%" PRIu32 ")", name.c_str(), interval, offset);
-
-  auto item = make_unique<SchedulerItem>();
-  item->component = component;
-  item->name = name;
-  item->type = SchedulerItem::INTERVAL;
-  item->interval = interval;
-  item->last_execution = now - offset - interval;
-  item->last_execution_major = this->millis_major_;
-  if (item->last_execution > now)
-    item->last_execution_major--;
-  item->callback = std::move(func);
-  item->remove = false;
-  this->push_(std::move(item));
+  this->set_timer_common_(component, SchedulerItem::INTERVAL, name.c_str(), false, interval, std::move(func));
+}
+void HOT Scheduler::set_interval_static(Component *component, const char *name, uint32_t interval,
+                                        std::function<void()> func) {
+  this->set_timer_common_(component, SchedulerItem::INTERVAL, name, true, interval, std::move(func));
 }
 bool HOT Scheduler::cancel_interval(Component *component, const std::string &name) {
+  return this->cancel_item_(component, name.c_str(), SchedulerItem::INTERVAL);
+}
+bool HOT Scheduler::cancel_interval(Component *component, const char *name) {
   return this->cancel_item_(component, name, SchedulerItem::INTERVAL);
 }
 
@@ -157,12 +179,11 @@ void HOT Scheduler::call() {
     ESP_LOGVV(TAG, "Items: count=%u, now=%" PRIu32, this->items_.size(), now);
     while (!this->empty_()) {
       this->lock_.lock();
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
+      auto item = this->pop_raw_();
       this->lock_.unlock();
 
       ESP_LOGVV(TAG, "  %s '%s' interval=%" PRIu32 " last_execution=%" PRIu32 " (%u) next=%" PRIu32 " (%u)",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution,
+                item->get_type_str(), item->name, item->interval, item->last_execution,
                 item->last_execution_major, item->next_execution(), item->next_execution_major());
 
       old_items.push_back(std::move(item));
@@ -183,8 +204,7 @@ void HOT Scheduler::call() {
     std::vector<std::unique_ptr<SchedulerItem>> valid_items;
     while (!this->empty_()) {
       LockGuard guard{this->lock_};
-      auto item = std::move(this->items_[0]);
-      this->pop_raw_();
+      auto item = this->pop_raw_();
       valid_items.push_back(std::move(item));
     }
 
@@ -217,13 +237,15 @@ void HOT Scheduler::call() {
       // Don't run on failed components
       if (item->component != nullptr && item->component->is_failed()) {
         LockGuard guard{this->lock_};
-        this->pop_raw_();
+        auto failed = this->pop_raw_();
+        this->unindex_(failed.get());
+        this->recycle_item_(std::move(failed));
         continue;
       }
 
 #ifdef ESPHOME_LOG_HAS_VERY_VERBOSE
       ESP_LOGVV(TAG, "Running %s '%s' with interval=%" PRIu32 " last_execution=%" PRIu32 " (now=%" PRIu32 ")",
-                item->get_type_str(), item->name.c_str(), item->interval, item->last_execution, now);
+                item->get_type_str(), item->name, item->interval, item->last_execution, now);
 #endif
 
       // Warning: During callback(), a lot of stuff can happen, including:
@@ -231,37 +253,49 @@ void HOT Scheduler::call() {
       //  - timeouts/intervals get cancelled
       {
         WarnIfComponentBlockingGuard guard{item->component};
+#ifdef USE_LOOP_PROFILER
+        LoopProfileGuard profile_guard{item->component != nullptr ? &item->component->get_scheduler_profile()
+                                                                  : nullptr};
+#endif
         item->callback();
       }
     }
 
     {
-      this->lock_.lock();
-
-      // new scope, item from before might have been moved in the vector
-      auto item = std::move(this->items_[0]);
-
-      // Only pop after function call, this ensures we were reachable
-      // during the function call and know if we were cancelled.
-      this->pop_raw_();
-
-      this->lock_.unlock();
+      // Declared outside of the locked scope, so that a finished timeout is released without the lock held.
+      std::unique_ptr<SchedulerItem> item;
+      {
+        LockGuard guard{this->lock_};
 
-      if (item->remove) {
-        // We were removed/cancelled in the function call, stop
-        to_remove_--;
-        continue;
+        // Only pop after function call, this ensures we were reachable
+        // during the function call and know if we were cancelled.
+        // Callbacks only queue new items in to_add_, so the item that ran is still at the front.
+        item = this->pop_raw_();
+
+        if (item->remove) {
+          // We were removed/cancelled in the function call, stop
+          to_remove_--;
+        } else if (item->type == SchedulerItem::INTERVAL) {
+          if (item->interval != 0) {
+            const uint32_t before = item->last_execution;
+            const uint32_t amount = (now - item->last_execution) / item->interval;
+            item->last_execution += amount * item->interval;
+            if (item->last_execution < before)
+              item->last_execution_major++;
+          }
+          // Re-add while still holding the lock: the item stays in `index_` and must always be reachable by cancel.
+          item->pending = true;
+          this->to_add_.push_back(std::move(item));
+        } else {
+          this->unindex_(item.get());
+        }
       }
 
-      if (item->type == SchedulerItem::INTERVAL) {
-        if (item->interval != 0) {
-          const uint32_t before = item->last_execution;
-          const uint32_t amount = (now - item->last_execution) / item->interval;
-          item->last_execution += amount * item->interval;
-          if (item->last_execution < before)
-            item->last_execution_major++;
-        }
-        this->push_(std::move(item));
+      if (item) {
+        // Destroy the callback's captures before taking the lock, then keep the item around for reuse.
+        item->callback = nullptr;
+        LockGuard guard{this->lock_};
+        this->recycle_item_(std::move(item));
       }
     }
   }
@@ -272,9 +306,11 @@ void HOT Scheduler::process_to_add() {
   LockGuard guard{this->lock_};
   for (auto &it : this->to_add_) {
     if (it->remove) {
+      this->recycle_item_(std::move(it));
       continue;
     }
 
+    it->pending = false;
     this->items_.push_back(std::move(it));
     std::push_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
   }
@@ -290,31 +326,58 @@ void HOT Scheduler::cleanup_() {
 
     {
       LockGuard guard{this->lock_};
-      this->pop_raw_();
+      auto removed = this->pop_raw_();
+      this->recycle_item_(std::move(removed));
     }
   }
 }
-void HOT Scheduler::pop_raw_() {
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::pop_raw_() {
+  // pop_heap compares the items while moving the front to the back, so only take it out afterwards
   std::pop_heap(this->items_.begin(), this->items_.end(), SchedulerItem::cmp);
+  auto item = std::move(this->items_.back());
   this->items_.pop_back();
+  return item;
 }
 void HOT Scheduler::push_(std::unique_ptr<Scheduler::SchedulerItem> item) {
   LockGuard guard{this->lock_};
+  item->pending = true;
+  if (item->name[0] != '\0')
+    this->index_.emplace(item->key, item.get());
   this->to_add_.push_back(std::move(item));
 }
-bool HOT Scheduler::cancel_item_(Component *component, const std::string &name, Scheduler::SchedulerItem::Type type) {
+bool HOT Scheduler::cancel_item_(Component *component, const char *name, Scheduler::SchedulerItem::Type type) {
+  if (name == nullptr)
+    name = "";
+
   // obtain lock because this function iterates and can be called from non-loop task context
   LockGuard guard{this->lock_};
+
+  if (name[0] != '\0') {
+    // Named items are unique per (component, name, type), so a lookup in the index is enough.
+    auto range = this->index_.equal_range(make_key_(component, name, type));
+    for (auto it = range.first; it != range.second; ++it) {
+      SchedulerItem *item = it->second;
+      if (item->component != component || item->type != type || strcmp(item->name, name) != 0)
+        continue;
+      item->remove = true;
+      if (!item->pending)
+        to_remove_++;
+      this->index_.erase(it);
+      return true;
+    }
+    return false;
+  }
+
   bool ret = false;
   for (auto &it : this->items_) {
-    if (it->component == component && it->name == name && it->type == type && !it->remove) {
+    if (it->component == component && it->name[0] == '\0' && it->type == type && !it->remove) {
       to_remove_++;
       it->remove = true;
       ret = true;
     }
   }
   for (auto &it : this->to_add_) {
-    if (it->component == component && it->name == name && it->type == type) {
+    if (it->component == component && it->name[0] == '\0' && it->type == type) {
       it->remove = true;
       ret = true;
     }
@@ -322,6 +385,46 @@ bool HOT Scheduler::cancel_item_(Component *component, const std::string &name,
 
   return ret;
 }
+uint32_t HOT Scheduler::make_key_(Component *component, const char *name, Scheduler::SchedulerItem::Type type) {
+  uint32_t key = fnv1_hash(name);
+  key ^= static_cast<uint32_t>(reinterpret_cast<uintptr_t>(component)) * 2654435761UL;
+  key ^= static_cast<uint32_t>(type);
+  return key;
+}
+void HOT Scheduler::unindex_(SchedulerItem *item) {
+  if (item->name[0] == '\0')
+    return;
+  auto range = this->index_.equal_range(item->key);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == item) {
+      this->index_.erase(it);
+      return;
+    }
+  }
+}
+std::unique_ptr<Scheduler::SchedulerItem> HOT Scheduler::acquire_item_() {
+  {
+    LockGuard guard{this->lock_};
+    if (!this->item_pool_.empty()) {
+      auto item = std::move(this->item_pool_.back());
+      this->item_pool_.pop_back();
+      return item;
+    }
+    this->item_allocations_++;
+  }
+  return make_unique<SchedulerItem>();
+}
+// Must be called with `lock_` held.
+void HOT Scheduler::recycle_item_(std::unique_ptr<SchedulerItem> item) {
+  if (this->item_pool_.size() >= MAX_POOL_SIZE)
+    return;
+  item->callback = nullptr;
+  this->item_pool_.push_back(std::move(item));
+}
+size_t Scheduler::get_item_count() {
+  LockGuard guard{this->lock_};
+  return this->items_.size() + this->to_add_.size();
+}
 uint32_t Scheduler::millis_() {
   const uint32_t now = millis();
   if (now < this->last_millis_) {
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
@@ -13,9 +14,21 @@ class Component;
 class Scheduler {
  public:
   void set_timeout(Component *component, const std::string &name, uint32_t timeout, std::function<void()> func);
+  /** Set a timeout with a static name.
+   *
+   * The name is not copied, so it must outlive the timeout (i.e. be a string literal or another static string).
+   */
+  void set_timeout_static(Component *component, const char *name, uint32_t timeout, std::function<void()> func);
   bool cancel_timeout(Component *component, const std::string &name);
+  bool cancel_timeout(Component *component, const char *name);
   void set_interval(Component *component, const std::string &name, uint32_t interval, std::function<void()> func);
+  /** Set an interval with a static name.
+   *
+   * The name is not copied, so it must outlive the interval (i.e. be a string literal or another static string).
+   */
+  void set_interval_static(Component *component, const char *name, uint32_t interval, std::function<void()> func);
   bool cancel_interval(Component *component, const std::string &name);
+  bool cancel_interval(Component *component, const char *name);
 
   void set_retry(Component *component, const std::string &name, uint32_t initial_wait_time, uint8_t max_attempts,
                  std::function<RetryResult(uint8_t)> func, float backoff_increase_factor = 1.0f);
@@ -27,10 +40,18 @@ class Scheduler {
 
   void process_to_add();
 
+  /// Number of timeouts and intervals currently scheduled (including ones cancelled but not yet cleaned up).
+  size_t get_item_count();
+  /// Number of times a scheduler item had to be allocated on the heap because the item pool was empty.
+  uint32_t get_item_allocations() const { return this->item_allocations_; }
+
  protected:
   struct SchedulerItem {
     Component *component;
-    std::string name;
+    // Points either to a static string passed by the caller, or to `dynamic_name`.
+    const char *name;
+    // Storage for names passed as std::string. Kept when the item is recycled, so its buffer can be reused.
+    std::string dynamic_name;
     enum Type { TIMEOUT, INTERVAL } type;
     union {
       uint32_t interval;
@@ -39,7 +60,11 @@ class Scheduler {
     uint32_t last_execution;
     std::function<void()> callback;
     bool remove;
+    // Whether this item is still waiting in `to_add_` (and not yet part of the `items_` heap).
+    bool pending;
     uint8_t last_execution_major;
+    // Key into `index_`, derived from component, name and type. Only valid for named items.
+    uint32_t key;
 
     inline uint32_t next_execution() { return this->last_execution + this->timeout; }
     inline uint8_t next_execution_major() {
@@ -65,9 +90,16 @@ class Scheduler {
 
   uint32_t millis_();
   void cleanup_();
-  void pop_raw_();
+  /// Remove the front item from the heap and return it.
+  std::unique_ptr<SchedulerItem> pop_raw_();
   void push_(std::unique_ptr<SchedulerItem> item);
-  bool cancel_item_(Component *component, const std::string &name, SchedulerItem::Type type);
+  void set_timer_common_(Component *component, SchedulerItem::Type type, const char *name, bool name_is_static,
+                         uint32_t delay, std::function<void()> func);
+  bool cancel_item_(Component *component, const char *name, SchedulerItem::Type type);
+  static uint32_t make_key_(Component *component, const char *name, SchedulerItem::Type type);
+  void unindex_(SchedulerItem *item);
+  std::unique_ptr<SchedulerItem> acquire_item_();
+  void recycle_item_(std::unique_ptr<SchedulerItem> item);
   bool empty_() {
     this->cleanup_();
     return this->items_.empty();
@@ -76,6 +108,11 @@ class Scheduler {
   Mutex lock_;
   std::vector<std::unique_ptr<SchedulerItem>> items_;
   std::vector<std::unique_ptr<SchedulerItem>> to_add_;
+  // Live (not cancelled) named items by key, so that cancelling/re-arming a named timer doesn't need to scan all items.
+  std::unordered_multimap<uint32_t, SchedulerItem *> index_;
+  // Finished items kept around for reuse, so that steady-state timeouts don't allocate (and fragment) heap memory.
+  std::vector<std::unique_ptr<SchedulerItem>> item_pool_;
+  uint32_t item_allocations_{0};
   uint32_t last_millis_{0};
   uint8_t millis_major_{0};
   uint32_t to_remove_{0};
@@ -0,0 +1,144 @@
+// Host benchmark for the event-driven main loop: how often the loop runs, and how much CPU time it takes, on a node
+// with a logger, a native API server with one subscribed client and a sensor polled every 5 s. The client also
+// measures the round trip of ping requests, to show that the node stays responsive while it sleeps.
+//
+// Compare the polling loop with the event-driven one:
+//   tests/benchmarks/run.sh tests/benchmarks/core/idle_loop_bench.cpp
+//   CXXFLAGS=-DUSE_EVENT_DRIVEN_LOOP tests/benchmarks/run.sh tests/benchmarks/core/idle_loop_bench.cpp
+// BENCH_BATCH_DELAY=<ms> in the environment enables API batching.
+//
+// BENCH_DEFINES: USE_API USE_API_PLAINTEXT USE_LOGGER USE_LOGGER_TASK_LOG_BUFFER USE_SENSOR
+// BENCH_DEFINES: USE_SOCKET_IMPL_BSD_SOCKETS
+// BENCH_SOURCES: esphome/core/*.cpp esphome/components/host/core.cpp esphome/components/host/preferences.cpp
+// BENCH_SOURCES: esphome/components/logger/logger.cpp esphome/components/logger/logger_host.cpp
+// BENCH_SOURCES: esphome/components/logger/task_log_buffer.cpp esphome/components/api/*.cpp
+// BENCH_SOURCES: esphome/components/socket/*.cpp esphome/components/network/util.cpp
+// BENCH_SOURCES: esphome/components/sensor/sensor.cpp esphome/components/sensor/filter.cpp
+// BENCH_SOURCES: esphome/components/sensor/automation.cpp
+
+#include "esphome/components/api/api_server.h"
+#include "esphome/components/logger/logger.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/application.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using namespace esphome;
+
+static const uint32_t RUN_TIME_MS = 20000;
+static const int PING_COUNT = 8;
+
+class CounterSensor : public PollingComponent, public sensor::Sensor {
+ public:
+  CounterSensor() : PollingComponent(5000) {}
+  void update() override { this->publish_state(this->value_ += 1.0f); }
+
+ protected:
+  float value_{0};
+};
+
+static uint16_t port = 0;                           // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static std::atomic<uint32_t> received_bytes{0};     // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static std::atomic<uint32_t> max_round_trip_us{0};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t loops = 0;                          // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static uint32_t started = 0;                        // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+static void drain(int fd) {
+  uint8_t buf[512];
+  ssize_t len;
+  while ((len = ::recv(fd, buf, sizeof(buf), MSG_DONTWAIT)) > 0)
+    received_bytes += len;
+}
+
+static void run_client() {
+  usleep(300000);
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (::connect(fd, (sockaddr *) &addr, sizeof(addr)) != 0) {
+    perror("connect");
+    exit(1);
+  }
+  // Plaintext frames without payload: indicator 0x00, length 0, message type.
+  const uint8_t hello[] = {0, 0, 1}, connect[] = {0, 0, 3}, subscribe_states[] = {0, 0, 20}, ping[] = {0, 0, 7};
+  ::write(fd, hello, sizeof(hello));
+  ::write(fd, connect, sizeof(connect));
+  ::write(fd, subscribe_states, sizeof(subscribe_states));
+
+  for (int i = 0; i < PING_COUNT; i++) {
+    usleep(1300000);
+    drain(fd);
+    const uint32_t start = micros();
+    ::write(fd, ping, sizeof(ping));
+    uint8_t buf[512];
+    ssize_t len = ::read(fd, buf, sizeof(buf));
+    const uint32_t round_trip = micros() - start;
+    if (len > 0)
+      received_bytes += len;
+    if (round_trip > max_round_trip_us)
+      max_round_trip_us = round_trip;
+  }
+  uint8_t buf[512];
+  ssize_t len;
+  while ((len = ::read(fd, buf, sizeof(buf))) > 0)
+    received_bytes += len;
+}
+
+void setup() {
+  App.pre_setup("idle-bench", "", "", "", __DATE__ ", " __TIME__, false);
+  auto *log = new logger::Logger(0, 512);  // NOLINT(cppcoreguidelines-owning-memory)
+  log->pre_setup();
+  App.register_component(log);
+
+  auto *api_server = new api::APIServer();  // NOLINT(cppcoreguidelines-owning-memory)
+  port = 20000 + getpid() % 20000;
+  api_server->set_port(port);
+  api_server->set_reboot_timeout(0);
+  if (getenv("BENCH_BATCH_DELAY") != nullptr)
+    api_server->set_batch_delay(atoi(getenv("BENCH_BATCH_DELAY")));
+  App.register_component(api_server);
+
+  auto *counter = new CounterSensor();  // NOLINT(cppcoreguidelines-owning-memory)
+  counter->set_name("counter");
+  counter->set_object_id("counter");
+  App.register_sensor(counter);
+  App.register_component(counter);
+
+  App.setup();
+  std::thread(run_client).detach();
+  started = millis();
+}
+
+void loop() {
+  App.loop();
+  loops++;
+  if (millis() - started < RUN_TIME_MS)
+    return;
+
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  const double cpu_s = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+                       (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+#ifdef USE_EVENT_DRIVEN_LOOP
+  const char *mode = "event-driven";
+#else
+  const char *mode = "polling";
+#endif
+  printf("%s loop: %.1f loops/s, %.3f s CPU in %" PRIu32 " s, max ping round trip %.2f ms, %" PRIu32
+         " bytes received\n",
+         mode, loops * 1000.0 / RUN_TIME_MS, cpu_s, RUN_TIME_MS / 1000, max_round_trip_us / 1000.0,
+         (uint32_t) received_bytes);
+  exit(0);
+}
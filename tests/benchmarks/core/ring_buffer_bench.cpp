@@ -0,0 +1,131 @@
+// Host microbenchmark for RingBuffer: throughput of the microphone -> ring -> send pattern the audio components run
+// from loop(), copying through read()/write() against filling and sending spans in place with
+// acquire_write()/commit() and peek_read()/consume(). Before timing, a producer and a consumer thread pass 20 MB
+// through a small ring in odd sized chunks to check that no data is lost or reordered.
+//
+// BENCH_SOURCES: esphome/core/ring_buffer.cpp esphome/core/helpers.cpp esphome/core/log.cpp
+
+#include "esphome/core/ring_buffer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace esphome {
+
+uint32_t millis() { return 0; }
+uint32_t micros() { return 0; }
+void delay(uint32_t ms) {}
+void yield() {}
+void arch_feed_wdt() {}
+
+}  // namespace esphome
+
+using namespace esphome;
+
+static const size_t TOTAL_BYTES = size_t(512) << 20;
+static uint8_t source[1 << 20];   // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+static volatile uint32_t result;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// Stream TOTAL_BYTES through a ring of \p size bytes, written in \p in_chunk and sent in \p out_chunk byte chunks.
+/// Return the throughput in MB/s.
+template<bool SPANS> static double stream(size_t size, size_t in_chunk, size_t out_chunk) {
+  auto ring = RingBuffer::create(size);
+  std::vector<uint8_t> input(in_chunk), send(out_chunk);
+  size_t source_pos = 0;
+  uint32_t checksum = 0;
+  auto microphone = [&](uint8_t *data, size_t len) {
+    memcpy(data, source + source_pos, len);
+    source_pos = (source_pos + len) % (sizeof(source) - 8192);
+  };
+  auto sender = [&](const uint8_t *data, size_t len) { checksum += data[0] + data[len - 1]; };
+
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t streamed = 0; streamed < TOTAL_BYTES; streamed += in_chunk) {
+    size_t acquired = 0;
+    uint8_t *space = SPANS ? ring->acquire_write(in_chunk, &acquired) : nullptr;
+    if (acquired == in_chunk) {
+      microphone(space, in_chunk);
+      ring->commit(in_chunk);
+    } else {
+      // the chunk is split at the end of the storage
+      microphone(input.data(), in_chunk);
+      ring->write(input.data(), in_chunk);
+    }
+    while (ring->available() >= out_chunk) {
+      size_t peeked = 0;
+      const uint8_t *data = SPANS ? ring->peek_read(out_chunk, &peeked) : nullptr;
+      if (peeked == out_chunk) {
+        sender(data, out_chunk);
+        ring->consume(out_chunk);
+      } else {
+        ring->read(send.data(), out_chunk);
+        sender(send.data(), out_chunk);
+      }
+    }
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  result = checksum;
+  return TOTAL_BYTES / std::chrono::duration<double, std::micro>(elapsed).count();
+}
+
+/// Pass data from a writer thread to a reader thread and check that it arrives complete and in order.
+static bool check_threads() {
+  auto ring = RingBuffer::create(1000);
+  const size_t total = 20 << 20;
+  std::thread writer([&]() {
+    size_t written = 0;
+    while (written < total) {
+      size_t acquired;
+      uint8_t *space = ring->acquire_write(333, &acquired);
+      if (acquired == 0) {
+        std::this_thread::yield();
+        continue;
+      }
+      for (size_t i = 0; i < acquired; i++)
+        space[i] = uint8_t((written + i) * 7);
+      ring->commit(acquired);
+      written += acquired;
+    }
+  });
+  size_t read = 0;
+  bool ok = true;
+  uint8_t buffer[517];
+  while (read < total) {
+    size_t len = ring->read(buffer, sizeof(buffer));
+    if (len == 0) {
+      std::this_thread::yield();
+      continue;
+    }
+    for (size_t i = 0; i < len; i++)
+      ok &= buffer[i] == uint8_t((read + i) * 7);
+    read += len;
+  }
+  writer.join();
+  return ok;
+}
+
+int main() {
+  for (auto &byte : source)
+    byte = rand();  // NOLINT(cert-msc30-c, cert-msc50-cpp)
+  if (!check_threads()) {
+    printf("data passed between threads differs\n");
+    return 1;
+  }
+
+  struct Case {
+    size_t size;
+    size_t in_chunk;
+    size_t out_chunk;
+  };
+  printf("%6s %6s %6s %14s %14s\n", "ring", "in", "out", "copies MB/s", "spans MB/s");
+  for (const Case &c : {Case{32000, 1024, 1024}, Case{16000, 1024, 640}, Case{65536, 4096, 1400}}) {
+    double copies = stream<false>(c.size, c.in_chunk, c.out_chunk);
+    double spans = stream<true>(c.size, c.in_chunk, c.out_chunk);
+    printf("%6zu %6zu %6zu %14.0f %14.0f\n", c.size, c.in_chunk, c.out_chunk, copies, spans);
+  }
+  return 0;
+}
@@ -0,0 +1,269 @@
+// Host microbenchmark for drawing text and images: the per-pixel Font::print() and Image::draw() loops they had
+// before, against the row spans they draw now, on a memory-backed 320x480 display buffer that keeps a 16-bit copy of
+// the screen like the color TFT drivers. The font is synthetic, with strokes and anti-aliased edges for the 4 bpp
+// variant. Both paths are compared pixel by pixel in all four rotations before timing.
+//
+// BENCH_SOURCES: esphome/components/font/font.cpp esphome/components/image/image.cpp
+// BENCH_SOURCES: esphome/components/display/*.cpp esphome/core/color.cpp esphome/core/component.cpp
+// BENCH_SOURCES: esphome/core/application.cpp esphome/core/entity_base.cpp esphome/core/helpers.cpp
+// BENCH_SOURCES: esphome/core/log.cpp esphome/core/scheduler.cpp esphome/core/string_ref.cpp esphome/core/time.cpp
+// BENCH_SOURCES: esphome/core/util.cpp esphome/components/host/preferences.cpp
+
+#include "esphome/components/display/display_color_utils.h"
+#include "esphome/components/font/font.h"
+#include "esphome/components/image/image.h"
+#include "esphome/core/hal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esphome {
+
+// Application::feed_wdt() reads the clock on every call, like it does on the devices
+uint32_t micros() {
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+uint32_t millis() { return micros() / 1000; }
+void delay(uint32_t ms) {}
+void yield() {}
+void arch_feed_wdt() {}
+void arch_restart() { exit(1); }
+uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
+
+}  // namespace esphome
+
+using namespace esphome;
+using namespace esphome::display;
+
+/// A 320x480 display buffer in memory, with a 16-bit copy of the screen that marks changed pixels dirty.
+class BenchDisplay : public DisplayBuffer {
+ public:
+  static constexpr int WIDTH = 320;
+  static constexpr int HEIGHT = 480;
+
+  void reset() {
+    this->pixels_.assign(WIDTH * HEIGHT, Color(0, 0, 0, 0));
+    this->screen_.assign(WIDTH * HEIGHT, 0);
+    this->dirty_region_count_ = 0;
+  }
+  const std::vector<Color> &pixels() const { return this->pixels_; }
+
+  void update() override {}
+  DisplayType get_display_type() override { return DisplayType::DISPLAY_TYPE_COLOR; }
+
+ protected:
+  int get_width_internal() override { return WIDTH; }
+  int get_height_internal() override { return HEIGHT; }
+  void draw_absolute_pixel_internal(int x, int y, Color color) override {
+    if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+      return;
+    this->pixels_[y * WIDTH + x] = color;
+    uint16_t value = ColorUtil::color_to_565(color);
+    if (this->screen_[y * WIDTH + x] != value) {
+      this->screen_[y * WIDTH + x] = value;
+      this->mark_dirty_(x, y);
+    }
+  }
+
+  std::vector<Color> pixels_ = std::vector<Color>(WIDTH * HEIGHT);
+  std::vector<uint16_t> screen_ = std::vector<uint16_t>(WIDTH * HEIGHT);
+};
+
+/// Font::print() before it drew spans, with the green and blue blending fixed so the output is comparable.
+static void print_per_pixel(font::Font &font, int x_start, int y_start, Display *display, Color color,
+                            const char *text, Color background) {
+  int i = 0;
+  int x_at = x_start;
+  int scan_x1, scan_y1, scan_width, scan_height;
+  while (text[i] != '\0') {
+    int match_length;
+    int glyph_n = font.match_next_glyph((const uint8_t *) text + i, &match_length);
+    if (glyph_n < 0) {
+      int glyph_width = font.get_glyphs()[0].get_glyph_data()->width;
+      display->filled_rectangle(x_at, y_start, glyph_width, font.get_height(), color);
+      x_at += glyph_width;
+      i++;
+      continue;
+    }
+    const font::Glyph &glyph = font.get_glyphs()[glyph_n];
+    glyph.scan_area(&scan_x1, &scan_y1, &scan_width, &scan_height);
+    const uint8_t *data = glyph.get_glyph_data()->data;
+    const int max_x = x_at + scan_x1 + scan_width;
+    const int max_y = y_start + scan_y1 + scan_height;
+    uint8_t bitmask = 0;
+    uint8_t pixel_data = 0;
+    float bpp_max = (1 << font.get_bpp()) - 1;
+    for (int glyph_y = y_start + scan_y1; glyph_y != max_y; glyph_y++) {
+      for (int glyph_x = x_at + scan_x1; glyph_x != max_x; glyph_x++) {
+        uint8_t pixel = 0;
+        for (int bit_num = 0; bit_num != font.get_bpp(); bit_num++) {
+          if (bitmask == 0) {
+            pixel_data = progmem_read_byte(data++);
+            bitmask = 0x80;
+          }
+          pixel <<= 1;
+          if ((pixel_data & bitmask) != 0)
+            pixel |= 1;
+          bitmask >>= 1;
+        }
+        if (pixel == bpp_max) {
+          display->draw_pixel_at(glyph_x, glyph_y, color);
+        } else if (pixel != 0) {
+          float on = (float) pixel / bpp_max;
+          float off = 1.0 - on;
+          Color blended;
+          blended.r = color.r * on + background.r * off;
+          blended.g = color.g * on + background.g * off;
+          blended.b = color.b * on + background.b * off;
+          display->draw_pixel_at(glyph_x, glyph_y, blended);
+        }
+      }
+    }
+    x_at += glyph.get_glyph_data()->width + glyph.get_glyph_data()->offset_x;
+    i += match_length;
+  }
+}
+
+/// Image::draw() before it drew spans, for images without transparency.
+static void draw_image_per_pixel(image::Image &image, int x, int y, Display *display) {
+  for (int img_x = 0; img_x < image.get_width(); img_x++) {
+    for (int img_y = 0; img_y < image.get_height(); img_y++) {
+      auto color = image.get_pixel(img_x, img_y);
+      if (color.w >= 0x80)
+        display->draw_pixel_at(x + img_x, y + img_y, color);
+    }
+  }
+}
+
+/// A font with the printable ASCII characters; every glyph has a few strokes with soft edges.
+class SynthFont {
+ public:
+  SynthFont(int width, int height, uint8_t bpp) {
+    int max_value = (1 << bpp) - 1;
+    for (int c = 32; c < 127; c++)
+      this->chars_.emplace_back(1, static_cast<char>(c));
+    for (int c = 0; c < static_cast<int>(this->chars_.size()); c++) {
+      std::vector<uint8_t> data((width * height * bpp + 7) / 8);
+      int bit = 0;
+      for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+          int value = 0;
+          int stroke_x = (x * 7 + c * 3) % 9;
+          int stroke_y = abs(x - y * width / height + (c % 5));
+          if (stroke_x < 2 || stroke_y < 2 || y == height / 2 + c % 3) {
+            value = max_value;
+          } else if (stroke_x == 2 || stroke_y == 2) {
+            value = max_value / 2;
+          }
+          if (x == 0 || x == width - 1 || c == 0)
+            value = 0;
+          for (int b = bpp - 1; b >= 0; b--, bit++) {
+            if (value & (1 << b))
+              data[bit / 8] |= 0x80 >> (bit % 8);
+          }
+        }
+      }
+      this->data_.push_back(std::move(data));
+    }
+    for (size_t i = 0; i < this->chars_.size(); i++) {
+      this->glyphs_.push_back(
+          {(const uint8_t *) this->chars_[i].c_str(), this->data_[i].data(), 1, 2, width, height});
+    }
+    this->font_ = std::make_unique<font::Font>(this->glyphs_.data(), this->glyphs_.size(), height, height + 4, bpp);
+  }
+
+  font::Font &font() { return *this->font_; }
+
+ protected:
+  std::vector<std::string> chars_;
+  std::vector<std::vector<uint8_t>> data_;
+  std::vector<font::GlyphData> glyphs_;
+  std::unique_ptr<font::Font> font_;
+};
+
+/// Run \p f for 400 ms and return the time of one run in microseconds.
+template<typename F> static double us_per_run(F &&f) {
+  const auto start = std::chrono::steady_clock::now();
+  size_t runs = 0;
+  while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(400)) {
+    f();
+    runs++;
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::micro>(elapsed).count() / runs;
+}
+
+int main() {
+  static BenchDisplay before, after;
+  const char *lines[] = {"Temperature 21.4C", "Humidity 48%", "Pressure 1013hPa", "Wind 12km/h NW",
+                         "12:34:56",          "Living room: ON", "Power 1.21kW",   "Battery 87%"};
+  const Color color(255, 200, 40);
+  const Color background(0, 0, 30);
+
+  for (uint8_t bpp : {1, 4}) {
+    SynthFont synth(14, 22, bpp);
+    font::Font &font = synth.font();
+    auto page_per_pixel = [&](BenchDisplay &display) {
+      for (int row = 0; row < 20; row++)
+        print_per_pixel(font, 4, row * 24, &display, color, lines[row % 8], background);
+    };
+    auto page_spans = [&](BenchDisplay &display) {
+      for (int row = 0; row < 20; row++)
+        font.print(4, row * 24, &display, color, lines[row % 8], background);
+    };
+    for (int rotation : {0, 90, 180, 270}) {
+      before.reset();
+      after.reset();
+      before.set_rotation(static_cast<DisplayRotation>(rotation));
+      after.set_rotation(static_cast<DisplayRotation>(rotation));
+      page_per_pixel(before);
+      page_spans(after);
+      // the blend table rounds, the float blending truncated
+      for (size_t i = 0; i < before.pixels().size(); i++) {
+        const Color &a = before.pixels()[i];
+        const Color &b = after.pixels()[i];
+        if (std::max({abs(a.r - b.r), abs(a.g - b.g), abs(a.b - b.b)}) > 1) {
+          printf("text differs: %u bpp, rotation %d, pixel %zu\n", bpp, rotation, i);
+          return 1;
+        }
+      }
+    }
+    before.set_rotation(DISPLAY_ROTATION_0_DEGREES);
+    after.set_rotation(DISPLAY_ROTATION_0_DEGREES);
+    double per_pixel_us = us_per_run([&]() { page_per_pixel(before); });
+    double spans_us = us_per_run([&]() { page_spans(after); });
+    printf("text page, %u bpp font: %8.1f us -> %8.1f us\n", bpp, per_pixel_us, spans_us);
+  }
+
+  std::vector<uint8_t> rgb565(100 * 80 * 2), binary((100 + 7) / 8 * 80);
+  for (auto &byte : rgb565)
+    byte = rand();  // NOLINT(cert-msc30-c, cert-msc50-cpp)
+  for (auto &byte : binary)
+    byte = rand();  // NOLINT(cert-msc30-c, cert-msc50-cpp)
+  image::Image image_rgb565(rgb565.data(), 100, 80, image::IMAGE_TYPE_RGB565);
+  image::Image image_binary(binary.data(), 100, 80, image::IMAGE_TYPE_BINARY);
+  image_rgb565.set_transparency(false);
+  image_binary.set_transparency(false);
+  for (auto *image : {&image_rgb565, &image_binary}) {
+    const char *name = image == &image_rgb565 ? "RGB565" : "binary";
+    before.reset();
+    after.reset();
+    draw_image_per_pixel(*image, 10, 20, &before);
+    image->draw(10, 20, &after, COLOR_ON, COLOR_OFF);
+    if (memcmp(before.pixels().data(), after.pixels().data(), before.pixels().size() * sizeof(Color)) != 0) {
+      printf("%s image differs\n", name);
+      return 1;
+    }
+    double per_pixel_us = us_per_run([&]() { draw_image_per_pixel(*image, 10, 20, &before); });
+    double spans_us = us_per_run([&]() { image->draw(10, 20, &after, COLOR_ON, COLOR_OFF); });
+    printf("100x80 %s image:    %8.1f us -> %8.1f us\n", name, per_pixel_us, spans_us);
+  }
+  return 0;
+}
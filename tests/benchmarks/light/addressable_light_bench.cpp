@@ -0,0 +1,166 @@
+// Host microbenchmark for writing addressable light pixels: one ESPColorView at a time against the bulk
+// set_pixels()/fill() path, and the rainbow effect rendered pixel by pixel against 32-pixel chunks, on 30 and 1500
+// pixel RGB and RGBW strips. The strip describes its buffer layout like the esp32_rmt_led_strip driver; the output of
+// both paths is compared byte for byte before timing.
+//
+// BENCH_DEFINES: USE_LIGHT
+// BENCH_SOURCES: esphome/components/light/addressable_light.cpp esphome/components/light/esp_color_correction.cpp
+// BENCH_SOURCES: esphome/components/light/esp_hsv_color.cpp esphome/components/light/esp_range_view.cpp
+// BENCH_SOURCES: esphome/components/light/light_output.cpp esphome/components/light/light_state.cpp
+// BENCH_SOURCES: esphome/components/light/light_call.cpp esphome/components/light/light_json_schema.cpp
+// BENCH_SOURCES: esphome/core/application.cpp esphome/core/color.cpp esphome/core/component.cpp
+// BENCH_SOURCES: esphome/core/entity_base.cpp esphome/core/helpers.cpp esphome/core/log.cpp
+// BENCH_SOURCES: esphome/core/scheduler.cpp esphome/core/string_ref.cpp esphome/core/util.cpp
+// BENCH_SOURCES: esphome/components/host/preferences.cpp
+
+#include "esphome/components/light/addressable_light.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace esphome {
+
+uint32_t millis() { return 0; }
+uint32_t micros() { return 0; }
+void delay(uint32_t ms) {}
+void yield() {}
+void arch_feed_wdt() {}
+void arch_restart() { exit(1); }
+
+}  // namespace esphome
+
+using namespace esphome;
+using namespace esphome::light;
+
+/// A GRB(W) strip in memory; with \p layout it describes its buffer, without it only works through ESPColorView.
+class BenchStrip : public AddressableLight {
+ public:
+  BenchStrip(int32_t size, bool layout, bool white)
+      : size_(size), bytes_per_pixel_(white ? 4 : 3), layout_(layout), buf_(size * bytes_per_pixel_), effect_(size) {
+    this->correction_.calculate_gamma_table(2.8f);
+    this->correction_.set_local_brightness(200);
+    this->correction_.set_max_brightness(Color(255, 200, 180, 255));
+  }
+
+  int32_t size() const override { return this->size_; }
+  void clear_effect_data() override {}
+  LightTraits get_traits() override { return {}; }
+  void write_state(LightState *state) override {}
+  const std::vector<uint8_t> &buffer() const { return this->buf_; }
+
+ protected:
+  ESPColorView get_view_internal(int32_t index) const override {
+    uint8_t *pixel = const_cast<uint8_t *>(this->buf_.data()) + index * this->bytes_per_pixel_;
+    return {pixel + 1,
+            pixel + 0,
+            pixel + 2,
+            this->bytes_per_pixel_ == 4 ? pixel + 3 : nullptr,
+            const_cast<uint8_t *>(&this->effect_[index]),
+            &this->correction_};
+  }
+  bool get_pixel_layout_(PixelLayout *layout) const override {
+    *layout = {const_cast<uint8_t *>(this->buf_.data()), this->bytes_per_pixel_, 1, 0, 2,
+               static_cast<int8_t>(this->bytes_per_pixel_ == 4 ? 3 : -1)};
+    return this->layout_;
+  }
+
+  int32_t size_;
+  uint8_t bytes_per_pixel_;
+  bool layout_;
+  std::vector<uint8_t> buf_;
+  std::vector<uint8_t> effect_;
+};
+
+/// The rainbow effect before it rendered in chunks.
+static void rainbow_per_pixel(AddressableLight &it, uint32_t now) {
+  ESPHSVColor hsv;
+  hsv.value = 255;
+  hsv.saturation = 240;
+  uint16_t hue = (now * 10) % 0xFFFF;
+  const uint16_t add_hue = 0xFFFF / 50;
+  for (auto var : it) {
+    hsv.hue = hue >> 8;
+    var = hsv;
+    hue += add_hue;
+  }
+}
+
+/// The rainbow effect as AddressableRainbowLightEffect renders it now.
+static void rainbow_chunked(AddressableLight &it, uint32_t now) {
+  ESPHSVColor hsv;
+  hsv.value = 255;
+  hsv.saturation = 240;
+  uint16_t hue = (now * 10) % 0xFFFF;
+  const uint16_t add_hue = 0xFFFF / 50;
+  Color colors[32];
+  for (int32_t i = 0; i < it.size(); i += 32) {
+    int32_t count = std::min<int32_t>(32, it.size() - i);
+    for (int32_t j = 0; j < count; j++) {
+      hsv.hue = hue >> 8;
+      colors[j] = hsv.to_rgb();
+      hue += add_hue;
+    }
+    it.set_pixels(i, colors, count);
+  }
+}
+
+/// Run \p f for 300 ms and return the pixels written per second, in millions.
+template<typename F> static double mpx_per_s(int32_t pixels, F &&f) {
+  const auto start = std::chrono::steady_clock::now();
+  size_t runs = 0;
+  while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(300)) {
+    f();
+    runs++;
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return pixels * runs / std::chrono::duration<double, std::micro>(elapsed).count();
+}
+
+int main() {
+  printf("%6s %5s %22s %22s %22s\n", "pixels", "type", "rainbow Mpx/s", "span Mpx/s", "fill Mpx/s");
+  for (int32_t size : {30, 1500}) {
+    for (bool white : {false, true}) {
+      BenchStrip views(size, false, white), bulk(size, true, white), fallback(size, false, white);
+      std::vector<Color> colors(size);
+      for (auto &color : colors)
+        color = Color(rand(), rand(), rand(), rand());  // NOLINT(cert-msc30-c, cert-msc50-cpp)
+
+      // ESPColorView doesn't write white for an HSV color, the chunked rainbow does
+      rainbow_per_pixel(views, 1234);
+      rainbow_chunked(bulk, 1234);
+      bool rainbow_same = white || views.buffer() == bulk.buffer();
+      for (int32_t i = 0; i < size; i++)
+        views[i] = colors[i];
+      bulk.set_pixels(0, colors.data(), size);
+      fallback.set_pixels(0, colors.data(), size);
+      bool span_same = views.buffer() == bulk.buffer() && fallback.buffer() == bulk.buffer();
+      for (int32_t i = 0; i < size; i++)
+        views[i] = Color(1, 2, 3, 4);
+      bulk.all() = Color(1, 2, 3, 4);
+      bool fill_same = views.buffer() == bulk.buffer();
+      if (!rainbow_same || !span_same || !fill_same) {
+        printf("output differs: rainbow %d, span %d, fill %d\n", !rainbow_same, !span_same, !fill_same);
+        return 1;
+      }
+
+      double rainbow_before = mpx_per_s(size, [&]() { rainbow_per_pixel(views, 1); });
+      double rainbow_after = mpx_per_s(size, [&]() { rainbow_chunked(bulk, 1); });
+      double span_before = mpx_per_s(size, [&]() {
+        for (int32_t i = 0; i < size; i++)
+          views[i] = colors[i];
+      });
+      double span_after = mpx_per_s(size, [&]() { bulk.set_pixels(0, colors.data(), size); });
+      double fill_before = mpx_per_s(size, [&]() {
+        for (auto view : views)
+          view = Color(9, 8, 7, 6);
+      });
+      double fill_after = mpx_per_s(size, [&]() { bulk.all() = Color(9, 8, 7, 6); });
+      printf("%6d %5s %10.1f -> %8.1f %10.1f -> %8.1f %10.1f -> %8.1f\n", size, white ? "RGBW" : "RGB", rainbow_before,
+             rainbow_after, span_before, span_after, fill_before, fill_after);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,325 @@
+// Host harness for the microphone audio pipeline: plays WAV files through a simulated I2S microphone into the graph
+// micro_wake_word and voice_assistant build on it, i.e. [resampler ->] feature framer -> feature queue, and a 16-bit
+// queue drained in 512-sample chunks. The main loop also runs other components that every second block it for
+// 150 ms, like a display redraw. Both consumers run from the loop; the pipeline runs once in the loop or on its own
+// task. Reports the audio lost before the microphone was read (the simulated DMA buffer holds 64 ms at 16 kHz), the
+// samples dropped by full queues, how long the microphone held up the loop, the end-to-end latency of each consumer,
+// and the stage counters.
+//
+// Without arguments it plays a generated 16 kHz and 48 kHz file; otherwise the given 16-bit mono PCM WAV files. The
+// simulated clock runs SPEED times faster than real time, the stage timings are in real host microseconds.
+//
+// BENCH_SOURCES: esphome/components/microphone/microphone.cpp esphome/core/audio_pipeline.cpp
+// BENCH_SOURCES: esphome/core/helpers.cpp esphome/core/log.cpp esphome/core/ring_buffer.cpp
+
+#include "esphome/components/microphone/microphone.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace esphome {
+
+static uint64_t real_us() {
+  static const auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+uint32_t micros() { return real_us(); }
+uint32_t millis() { return real_us() / 1000; }
+void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+void yield() {}
+void arch_feed_wdt() {}
+
+}  // namespace esphome
+
+using namespace esphome;
+
+static const uint64_t SPEED = 10;
+static const size_t DMA_SAMPLES = 4 * 256;  // dma_buf_count * dma_buf_len of i2s_audio
+static const uint32_t STALL_EVERY_MS = 1000;
+static const uint32_t STALL_MS = 150;
+
+/// Time of the simulated device, in microseconds.
+static uint64_t device_us() { return real_us() * SPEED; }
+static void sleep_device_us(uint64_t us) { std::this_thread::sleep_for(std::chrono::microseconds(us / SPEED)); }
+
+struct Wav {
+  std::string name;
+  uint32_t sample_rate;
+  std::vector<int16_t> samples;
+};
+
+/// Load a 16-bit mono PCM WAV file, false if it isn't one.
+static bool load_wav(const char *path, Wav *wav) {
+  FILE *file = fopen(path, "rb");
+  if (file == nullptr)
+    return false;
+  std::vector<uint8_t> data;
+  uint8_t buffer[4096];
+  size_t len;
+  while ((len = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    data.insert(data.end(), buffer, buffer + len);
+  fclose(file);
+  if (data.size() < 12 || memcmp(data.data(), "RIFF", 4) != 0 || memcmp(data.data() + 8, "WAVE", 4) != 0)
+    return false;
+  auto u16 = [&](size_t at) { return uint16_t(data[at] | data[at + 1] << 8); };
+  auto u32 = [&](size_t at) { return uint32_t(u16(at) | u16(at + 2) << 16); };
+  bool format_ok = false;
+  for (size_t at = 12; at + 8 <= data.size(); at += 8 + u32(at + 4) + (u32(at + 4) & 1)) {
+    const uint32_t size = std::min<uint32_t>(u32(at + 4), data.size() - at - 8);
+    if (memcmp(data.data() + at, "fmt ", 4) == 0 && size >= 16) {
+      format_ok = u16(at + 8) == 1 && u16(at + 10) == 1 && u16(at + 22) == 16;
+      wav->sample_rate = u32(at + 12);
+    } else if (memcmp(data.data() + at, "data", 4) == 0 && format_ok) {
+      wav->samples.resize(size / 2);
+      memcpy(wav->samples.data(), data.data() + at + 8, wav->samples.size() * 2);
+      wav->name = path;
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Speech-like test audio: a few harmonics whose pitch and loudness change in syllables, over some noise.
+static Wav generate_wav(uint32_t sample_rate, uint32_t seconds) {
+  Wav wav{"generated " + std::to_string(sample_rate / 1000) + " kHz", sample_rate, {}};
+  wav.samples.resize(size_t(sample_rate) * seconds);
+  double phase = 0;
+  for (size_t i = 0; i < wav.samples.size(); i++) {
+    const double t = double(i) / sample_rate;
+    const double pitch = 140 + 40 * sin(2 * M_PI * 0.7 * t);
+    const double envelope = 0.5 + 0.5 * sin(2 * M_PI * 4 * t);
+    phase += 2 * M_PI * pitch / sample_rate;
+    const double voice = sin(phase) + 0.5 * sin(2 * phase) + 0.25 * sin(3 * phase);
+    const double noise = (rand() % 2001 - 1000) / 1000.0;  // NOLINT(cert-msc30-c, cert-msc50-cpp)
+    wav.samples[i] = int16_t(6000 * envelope * voice + 300 * noise);
+  }
+  return wav;
+}
+
+/// An I2S microphone that captures the WAV in the simulated time: like i2s_read(), read() waits up to 100 ms until
+/// it can fill the buffer, and the audio not read within DMA_SAMPLES is overwritten.
+class WavMicrophone : public microphone::Microphone {
+ public:
+  explicit WavMicrophone(const Wav &wav) : wav_(wav) {}
+
+  uint32_t get_sample_rate() const override { return this->wav_.sample_rate; }
+  void start() override {
+    this->start_us_ = device_us();
+    this->state_ = microphone::STATE_RUNNING;
+  }
+  void stop() override { this->state_ = microphone::STATE_STOPPING; }
+  void loop() {
+    if (this->state_ == microphone::STATE_RUNNING) {
+      this->run_pipeline_();
+    } else if (this->state_ == microphone::STATE_STOPPING && this->stop_pipeline_()) {
+      this->state_ = microphone::STATE_STOPPED;
+    }
+  }
+
+  size_t read(int16_t *buf, size_t len) override {
+    const size_t wanted = len / sizeof(int16_t);
+    if (this->position_ >= this->wav_.samples.size())
+      return 0;
+    for (int waited = 0; this->captured() - this->position_ < wanted && waited < 100; waited++)
+      sleep_device_us(1000);
+    size_t captured = this->captured();
+    if (captured - this->position_ > DMA_SAMPLES) {
+      this->overrun_ += captured - this->position_ - DMA_SAMPLES;
+      this->position_ = captured - DMA_SAMPLES;
+    }
+    const size_t count = std::min(wanted, captured - this->position_);
+    memcpy(buf, this->wav_.samples.data() + this->position_, count * sizeof(int16_t));
+    this->position_ += count;
+    this->reads_++;
+    {
+      std::lock_guard<std::mutex> guard(this->delivered_lock_);
+      this->delivered_.push_back({this->delivered_count_ += count, this->position_});
+    }
+    return count * sizeof(int16_t);
+  }
+
+  /// Samples the device has captured so far.
+  size_t captured() const {
+    return std::min<size_t>((device_us() - this->start_us_) * this->wav_.sample_rate / 1000000,
+                            this->wav_.samples.size());
+  }
+  bool finished() const { return this->captured() == this->wav_.samples.size(); }
+  /// Position in the WAV of the sample the microphone passed on as the \p index th one.
+  size_t wav_position(size_t index) {
+    std::lock_guard<std::mutex> guard(this->delivered_lock_);
+    auto it = std::lower_bound(this->delivered_.begin(), this->delivered_.end(), std::make_pair(index + 1, size_t(0)));
+    if (it == this->delivered_.end())
+      return this->position_;
+    return it->second - (it->first - index);
+  }
+  size_t get_overrun() const { return this->overrun_; }
+  size_t get_reads() const { return this->reads_; }
+  size_t get_delivered() const { return this->delivered_count_; }
+  AudioStage *get_source() { return &this->source_; }
+  bool is_task() const { return this->task_; }
+
+ protected:
+  const Wav &wav_;
+  uint64_t start_us_{0};
+  size_t position_{0};
+  size_t overrun_{0};
+  size_t reads_{0};
+  size_t delivered_count_{0};
+  std::mutex delivered_lock_;
+  /// Samples passed on after each read, and the WAV position after it.
+  std::vector<std::pair<size_t, size_t>> delivered_;
+};
+
+/// Latency of a consumer, from when the device captured the newest sample it got to when it got it.
+struct Latency {
+  double total_ms{0};
+  double max_ms{0};
+  size_t count{0};
+
+  void add(WavMicrophone &mic, size_t delivered_index) {
+    const double rate = mic.get_sample_rate();
+    const double ms = (double(mic.captured()) - double(mic.wav_position(delivered_index))) * 1000 / rate;
+    this->total_ms += ms;
+    this->max_ms = std::max(this->max_ms, ms);
+    this->count++;
+  }
+  double mean_ms() const { return this->count == 0 ? 0 : this->total_ms / this->count; }
+};
+
+static void run(const Wav &wav, bool task) {
+  static const uint32_t FEATURE_SAMPLE_RATE = 16000;
+  static const size_t WINDOW = 480, STRIDE = 320, FEATURES = 40;
+  static const size_t SEND_SAMPLES = 512;
+
+  WavMicrophone mic(wav);
+  mic.set_task(task);
+  AudioPipeline &pipeline = mic.get_pipeline();
+
+  // micro_wake_word: 40 log band energies per 30 ms window, every 20 ms; cheap, but in the place of the preprocessor
+  std::unique_ptr<AudioResampler> resampler;
+  AudioFramer<int16_t, int8_t> framer("features", WINDOW, STRIDE, FEATURES, [](const int16_t *window, int8_t *frame) {
+    for (size_t band = 0; band < FEATURES; band++) {
+      int64_t energy = 1;
+      for (size_t i = band * WINDOW / FEATURES; i < (band + 1) * WINDOW / FEATURES; i++)
+        energy += int32_t(window[i]) * window[i];
+      frame[band] = int8_t(std::log2(double(energy)) * 3 - 64);
+    }
+    return true;
+  });
+  AudioQueue<int8_t> features;
+  framer.input().init(FEATURE_SAMPLE_RATE / 1000 * 1000);
+  features.init(10 * FEATURES);
+  if (wav.sample_rate != FEATURE_SAMPLE_RATE) {
+    resampler = make_unique<AudioResampler>("resampler", wav.sample_rate, FEATURE_SAMPLE_RATE);
+    resampler->input().init(wav.sample_rate / 1000 * 1000);
+    pipeline.add_stage(resampler.get());
+  }
+  pipeline.add_stage(&framer);
+  AudioQueue<int16_t> &wake_input = resampler != nullptr ? resampler->input() : framer.input();
+  pipeline.connect(framer.output(), features);
+  if (resampler != nullptr)
+    pipeline.connect(resampler->output(), framer.input());
+  mic.add_sink(&wake_input);
+
+  // voice_assistant: a second of audio, sent in 512-sample chunks
+  AudioQueue<int16_t> send;
+  send.init(wav.sample_rate);
+  mic.add_sink(&send);
+
+  Latency wake_latency, send_latency;
+  size_t frames = 0, sent = 0;
+  uint64_t mic_us = 0, mic_max_us = 0, loops = 0;
+  int8_t frame[FEATURES];
+  int16_t chunk[SEND_SAMPLES];
+  const double ratio = double(wav.sample_rate) / FEATURE_SAMPLE_RATE;
+  mic.start();
+  const uint64_t start_us = device_us();
+  uint64_t next_stall_us = start_us + STALL_EVERY_MS * 1000;
+  while (!mic.finished()) {
+    const uint64_t loop_start_us = device_us();
+    mic.loop();
+    const uint64_t held_us = device_us() - loop_start_us;
+    mic_us += held_us;
+    mic_max_us = std::max(mic_max_us, held_us);
+    loops++;
+
+    while (features.available() >= FEATURES) {
+      features.read(frame, FEATURES);
+      frames++;
+      // the newest sample of the frame, counting the samples dropped for the wake word as passed through
+      wake_latency.add(mic, size_t((frames * STRIDE) * ratio) + wake_input.get_dropped() - 1);
+    }
+    while (send.available() >= SEND_SAMPLES) {
+      sent += send.read(chunk, SEND_SAMPLES);
+      send_latency.add(mic, sent + send.get_dropped() - 1);
+    }
+
+    // the other components
+    if (device_us() >= next_stall_us) {
+      sleep_device_us(STALL_MS * 1000);
+      next_stall_us += STALL_EVERY_MS * 1000;
+    } else {
+      sleep_device_us(1000);
+    }
+  }
+  const double audio_s = (device_us() - start_us) / 1e6;
+
+  // stop the task before reading its counters
+  pipeline.stop_task();
+  while (pipeline.is_task_running())
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  printf("%s, %s: %.1f s of audio, %zu reads of %.0f samples on average\n", wav.name.c_str(),
+         mic.is_task() ? "task" : "loop", audio_s, mic.get_reads(), double(mic.get_delivered()) / mic.get_reads());
+  printf("  lost before read: %.1f%%, microphone held the loop %.2f ms on average, %.1f ms at most\n",
+         100.0 * mic.get_overrun() / mic.captured(), mic_us / 1000.0 / loops, mic_max_us / 1000.0);
+  printf("  wake word: %zu frames, %u samples dropped, latency %.1f ms mean, %.1f ms max\n", frames,
+         wake_input.get_dropped(), wake_latency.mean_ms(), wake_latency.max_ms);
+  printf("  assistant: %zu samples, %u dropped, latency %.1f ms mean, %.1f ms max\n", sent, send.get_dropped(),
+         send_latency.mean_ms(), send_latency.max_ms);
+  std::vector<AudioStage *> stages = {mic.get_source()};
+  if (resampler != nullptr)
+    stages.push_back(resampler.get());
+  stages.push_back(&framer);
+  for (auto *stage : stages) {
+    const AudioStage::Stats &stats = stage->get_stats();
+    printf("  %-10s %7u runs %9llu samples %8.1f us average %8u us max\n", stage->get_name(), stats.runs,
+           (unsigned long long) stats.samples, stats.runs == 0 ? 0.0 : double(stats.total_us) / stats.runs,
+           stats.max_us);
+  }
+
+  mic.remove_sink(&send);
+  mic.remove_sink(&wake_input);
+  mic.stop();
+  while (!mic.is_stopped())
+    mic.loop();
+}
+
+int main(int argc, char **argv) {
+  std::vector<Wav> wavs;
+  for (int i = 1; i < argc; i++) {
+    Wav wav;
+    if (!load_wav(argv[i], &wav)) {
+      printf("%s is not a 16-bit mono PCM WAV file\n", argv[i]);
+      return 1;
+    }
+    wavs.push_back(std::move(wav));
+  }
+  if (wavs.empty()) {
+    wavs.push_back(generate_wav(16000, 20));
+    wavs.push_back(generate_wav(48000, 20));
+  }
+  for (const Wav &wav : wavs) {
+    run(wav, false);
+    run(wav, true);
+  }
+  return 0;
+}
@@ -0,0 +1,140 @@
+// Host benchmark for planning Modbus reads: the read commands, bus bytes and time at 9600 baud one update takes for
+// real register maps, reading contiguous registers only against merging ranges across small gaps. Each sensor parses
+// its value out of the simulated responses, in which every register holds its own address, and has to find the
+// right one.
+//
+// The register maps are an Eastron SDM120 and SDM630, a Growatt inverter, a sparse inverter map with a DWORD every
+// 5 registers, and a 300 register block that has to be split at the frame limit. MAX_REGISTERS_PER_READ in the
+// environment caps the registers per read, like the max_registers_per_read option.
+//
+// BENCH_SOURCES: esphome/components/modbus_controller/modbus_controller.cpp esphome/components/modbus/modbus.cpp
+// BENCH_SOURCES: esphome/components/uart/uart.cpp esphome/components/uart/uart_component.cpp
+// BENCH_SOURCES: esphome/core/application.cpp esphome/core/color.cpp esphome/core/component.cpp
+// BENCH_SOURCES: esphome/core/entity_base.cpp esphome/core/helpers.cpp esphome/core/log.cpp
+// BENCH_SOURCES: esphome/core/scheduler.cpp esphome/core/string_ref.cpp esphome/core/util.cpp
+// BENCH_SOURCES: esphome/components/host/preferences.cpp
+
+#include "esphome/components/modbus_controller/modbus_controller.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace esphome {
+
+uint32_t millis() { return 0; }
+uint32_t micros() { return 0; }
+void delay(uint32_t ms) {}
+void yield() {}
+void arch_feed_wdt() {}
+void arch_restart() { exit(1); }
+
+}  // namespace esphome
+
+using namespace esphome;
+using namespace esphome::modbus_controller;
+
+// Bytes on the bus per read command besides the data: request, response frame and the silent intervals before them.
+static const size_t COMMAND_BYTES = 8 + 5 + 7;
+
+/// A sensor that checks it parsed the value of its own register.
+class CheckedItem : public SensorItem {
+ public:
+  CheckedItem(ModbusRegisterType type, uint16_t address, uint8_t count) {
+    this->register_type = type;
+    this->sensor_value_type = count == 1 ? SensorValueType::U_WORD : SensorValueType::U_DWORD;
+    this->start_address = address;
+    this->bitmask = 0xFFFFFFFF;
+    this->offset = 0;
+    this->register_count = count;
+    this->skip_updates = 0;
+    this->address_ = address;
+  }
+
+  void parse_and_publish(const std::vector<uint8_t> &data) override {
+    this->parsed_ = get_data<uint16_t>(data, this->offset) == this->address_;
+  }
+  bool parsed() const { return this->parsed_; }
+
+ protected:
+  uint16_t address_;
+  bool parsed_{false};
+};
+
+class BenchController : public ModbusController {
+ public:
+  using ModbusController::create_register_ranges_;
+  using ModbusController::register_ranges_;
+};
+
+struct Register {
+  uint16_t address;
+  uint8_t count;
+};
+
+static bool run(const char *name, ModbusRegisterType type, const std::vector<Register> &map) {
+  bool ok = true;
+  for (bool merge : {false, true}) {
+    BenchController controller;
+    controller.set_merge_gaps(merge);
+    if (getenv("MAX_REGISTERS_PER_READ") != nullptr)
+      controller.set_max_registers_per_read(atoi(getenv("MAX_REGISTERS_PER_READ")));
+    std::vector<std::unique_ptr<CheckedItem>> items;
+    for (const Register &reg : map) {
+      items.emplace_back(new CheckedItem(type, reg.address, reg.count));
+      controller.add_sensor_item(items.back().get());
+    }
+    controller.create_register_ranges_();
+
+    size_t bytes = 0, longest = 0;
+    for (const RegisterRange &range : controller.register_ranges_) {
+      bytes += COMMAND_BYTES + 2 * range.register_count;
+      longest = std::max<size_t>(longest, range.register_count);
+      std::vector<uint8_t> response;
+      for (uint16_t address = range.start_address; address < range.start_address + range.register_count; address++) {
+        response.push_back(address >> 8);
+        response.push_back(address & 0xFF);
+      }
+      for (auto *item : range.sensors)
+        item->parse_and_publish(response);
+    }
+    size_t wrong = std::count_if(items.begin(), items.end(), [](const auto &item) { return !item->parsed(); });
+    // a Modbus frame holds at most 125 registers
+    ok &= wrong == 0 && longest <= 125;
+    printf("%-17s %-10s %7zu %9zu %6zu %8.1f %8zu %6zu\n", name, merge ? "merge gaps" : "contiguous", map.size(),
+           controller.register_ranges_.size(), bytes, bytes * 10 / 9.6, longest, wrong);
+  }
+  return ok;
+}
+
+int main() {
+  printf("%-17s %-10s %7s %9s %6s %8s %8s %6s\n", "map", "ranges", "sensors", "commands", "bytes", "ms@9600", "longest",
+         "wrong");
+  bool ok = true;
+  // Eastron SDM120 input registers, all FP32
+  ok &= run("sdm120", ModbusRegisterType::READ,
+            {{0x00, 2}, {0x06, 2}, {0x0C, 2}, {0x12, 2}, {0x18, 2}, {0x1E, 2}, {0x24, 2}, {0x46, 2}, {0x48, 2},
+             {0x4A, 2}, {0x4C, 2}, {0x4E, 2}, {0x156, 2}, {0x158, 2}});
+  // Eastron SDM630, the registers the sdm_meter component reads plus the totals
+  ok &= run("sdm630", ModbusRegisterType::READ,
+            {{0x00, 2}, {0x02, 2}, {0x04, 2}, {0x06, 2}, {0x08, 2}, {0x0A, 2}, {0x0C, 2}, {0x0E, 2}, {0x10, 2},
+             {0x12, 2}, {0x14, 2}, {0x16, 2}, {0x18, 2}, {0x1A, 2}, {0x1C, 2}, {0x1E, 2}, {0x20, 2}, {0x22, 2},
+             {0x24, 2}, {0x26, 2}, {0x28, 2}, {0x34, 2}, {0x38, 2}, {0x3C, 2}, {0x3E, 2}, {0x42, 2}, {0x46, 2},
+             {0x48, 2}, {0x4A, 2}, {0xC8, 2}, {0xCA, 2}, {0xCC, 2}, {0xE0, 2}, {0x156, 2}, {0x158, 2}});
+  // Growatt inverter input registers, U_WORD and U_DWORD
+  ok &= run("growatt-inverter", ModbusRegisterType::READ,
+            {{0, 1},  {1, 2},  {3, 1},  {4, 1},  {5, 2},  {7, 1},  {8, 1},  {9, 2},  {35, 2}, {37, 1},
+             {38, 1}, {39, 1}, {40, 2}, {53, 2}, {55, 2}, {57, 2}, {93, 1}, {94, 1}, {98, 1}, {104, 1}});
+  // 40 DWORDs, one every 5 registers
+  std::vector<Register> sparse;
+  for (uint16_t address = 1000; sparse.size() < 40; address += 5)
+    sparse.push_back({address, 2});
+  ok &= run("sparse-inverter", ModbusRegisterType::HOLDING, sparse);
+  std::vector<Register> block;
+  for (uint16_t address = 0; address < 300; address += 2)
+    block.push_back({address, 2});
+  ok &= run("contiguous-300", ModbusRegisterType::HOLDING, block);
+  return ok ? 0 : 1;
+}
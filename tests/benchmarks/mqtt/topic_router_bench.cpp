@@ -0,0 +1,152 @@
+// Host microbenchmark for routing received MQTT messages: the topic trie against comparing the topic to every
+// subscription, as MQTTClientComponent did before, for 10 to 10,000 entity command subscriptions plus a few wildcard
+// ones. Before timing, the trie is checked against the linear matcher on random topics, and on more subscriptions
+// than the trie has node indices for.
+//
+// BENCH_DEFINES: USE_MQTT
+// BENCH_SOURCES: esphome/components/mqtt/mqtt_topic_router.cpp
+
+#include "esphome/components/mqtt/mqtt_topic_router.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace esphome::mqtt;
+
+// The linear matcher of MQTTClientComponent before the trie, as the reference.
+static bool topic_match(const char *message, const char *subscription, bool is_normal, bool past_separator) {
+  if (*message == '\0' && *subscription == '\0')
+    return true;
+  if (*message == '\0' || *subscription == '\0')
+    return false;
+  bool do_wildcards = is_normal || past_separator;
+  if (*subscription == '+' && do_wildcards) {
+    subscription++;
+    while (*message != '\0' && *message != '/')
+      message++;
+    return topic_match(message, subscription, is_normal, true);
+  }
+  if (*subscription == '#' && do_wildcards)
+    return true;
+  if (*message != *subscription)
+    return false;
+  past_separator = past_separator || *subscription == '/';
+  return topic_match(message + 1, subscription + 1, is_normal, past_separator);
+}
+
+static bool topic_match(const char *message, const char *subscription) {
+  return topic_match(message, subscription, *message != '\0' && *message != '$', false);
+}
+
+static std::vector<size_t> linear_match(const std::vector<std::string> &subscriptions, const std::string &topic) {
+  std::vector<size_t> matches;
+  for (size_t i = 0; i < subscriptions.size(); i++) {
+    if (topic_match(topic.c_str(), subscriptions[i].c_str()))
+      matches.push_back(i);
+  }
+  return matches;
+}
+
+/// Compare the router with the linear matcher on random topics made of a few short levels, including wildcards in
+/// valid and invalid places, empty levels and `$` topics.
+static size_t check_random(std::mt19937 &rng) {
+  const char *levels[] = {"a", "b", "", "$S", "ab", "+", "#", "a+", "#b", "x#"};
+  auto random_topic = [&](bool subscription) {
+    std::string topic;
+    int count = 1 + rng() % 4;
+    for (int i = 0; i < count; i++) {
+      if (i != 0)
+        topic += '/';
+      // received topics never contain wildcards
+      topic += levels[rng() % (subscription ? 10 : 5)];
+    }
+    return topic;
+  };
+  size_t mismatches = 0;
+  for (int round = 0; round < 2000; round++) {
+    std::vector<std::string> subscriptions;
+    for (int i = 0; i < 30; i++)
+      subscriptions.push_back(random_topic(true));
+    MQTTTopicRouter router;
+    for (size_t i = 0; i < subscriptions.size(); i++)
+      router.add(i, subscriptions[i].c_str());
+    for (int i = 0; i < 50; i++) {
+      std::string topic = random_topic(false);
+      if (router.match(topic.c_str()) != linear_match(subscriptions, topic))
+        mismatches++;
+    }
+  }
+  return mismatches;
+}
+
+/// Add more subscriptions than the trie has node indices for; the ones that don't fit have to match linearly.
+static size_t check_overflow() {
+  std::vector<std::string> subscriptions;
+  for (size_t i = 0; i < 70000; i++)
+    subscriptions.push_back("device/entity_" + std::to_string(i) + "/command");
+  subscriptions.push_back("device/+/command");
+  MQTTTopicRouter router;
+  for (size_t i = 0; i < subscriptions.size(); i++)
+    router.add(i, subscriptions[i].c_str());
+  size_t mismatches = 0;
+  for (size_t i : {0, 1000, 65532, 65533, 65534, 65535, 69999}) {
+    const auto &topic = subscriptions[i];
+    if (router.match(topic.c_str()) != linear_match(subscriptions, topic))
+      mismatches++;
+  }
+  return mismatches;
+}
+
+template<typename F> static double us_per_op(size_t ops, F &&f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::micro>(elapsed).count() / ops;
+}
+
+int main() {
+  std::mt19937 rng(1);
+  size_t random_mismatches = check_random(rng);
+  size_t overflow_mismatches = check_overflow();
+  printf("mismatches: random %zu, overflow %zu\n", random_mismatches, overflow_mismatches);
+
+  const char *domains[] = {"switch", "light", "number", "select", "button", "fan", "cover", "climate"};
+  printf("%14s %14s %14s\n", "subscriptions", "trie us/msg", "linear us/msg");
+  for (size_t count : {10, 100, 1000, 10000}) {
+    std::vector<std::string> subscriptions;
+    for (size_t i = 0; i < count; i++) {
+      subscriptions.push_back(std::string("livingroom/") + domains[i % 8] + "/entity_" + std::to_string(i) +
+                              "/command");
+    }
+    subscriptions.emplace_back("homeassistant/status");
+    subscriptions.emplace_back("livingroom/+/entity_7/brightness/command");
+    MQTTTopicRouter router;
+    for (size_t i = 0; i < subscriptions.size(); i++)
+      router.add(i, subscriptions[i].c_str());
+
+    std::vector<std::string> topics;
+    for (int i = 0; i < 1000; i++)
+      topics.push_back(subscriptions[rng() % subscriptions.size()]);
+    size_t matched = 0;
+    double trie_us = us_per_op(100 * topics.size(), [&]() {
+      for (int round = 0; round < 100; round++) {
+        for (auto &topic : topics)
+          matched += router.match(topic.c_str()).size();
+      }
+    });
+    size_t linear_rounds = count >= 1000 ? 2 : 100;
+    double linear_us = us_per_op(linear_rounds * topics.size(), [&]() {
+      for (size_t round = 0; round < linear_rounds; round++) {
+        for (auto &topic : topics)
+          matched += linear_match(subscriptions, topic).size();
+      }
+    });
+    printf("%14zu %14.3f %14.3f\n", count, trie_us, linear_us);
+    if (matched == 0)
+      return 1;
+  }
+  return random_mismatches + overflow_mismatches == 0 ? 0 : 1;
+}
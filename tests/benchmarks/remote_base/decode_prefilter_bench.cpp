@@ -0,0 +1,231 @@
+// Host microbenchmark for routing received remote frames: handing every frame to all 26 protocol dumpers, as the
+// receiver did before, against skipping the dumpers whose RemoteSignature can't match it. The corpus has encoded IR
+// frames, RF frames and the short random pulses an idle 433 MHz receiver picks up most of the time. Before timing,
+// the frames and 50 copies of each with +/-20% timing jitter are checked: no frame that a dumper decodes may be
+// skipped by its signature.
+//
+// BENCH_DEFINES: USE_BINARY_SENSOR
+// BENCH_SOURCES: esphome/components/remote_base/*.cpp esphome/components/binary_sensor/*.cpp
+// BENCH_SOURCES: esphome/core/application.cpp esphome/core/color.cpp esphome/core/component.cpp
+// BENCH_SOURCES: esphome/core/entity_base.cpp esphome/core/helpers.cpp esphome/core/log.cpp
+// BENCH_SOURCES: esphome/core/scheduler.cpp esphome/core/string_ref.cpp esphome/core/util.cpp
+// BENCH_SOURCES: esphome/components/host/preferences.cpp
+
+#include "esphome/components/remote_base/abbwelcome_protocol.h"
+#include "esphome/components/remote_base/aeha_protocol.h"
+#include "esphome/components/remote_base/byronsx_protocol.h"
+#include "esphome/components/remote_base/canalsat_protocol.h"
+#include "esphome/components/remote_base/coolix_protocol.h"
+#include "esphome/components/remote_base/dish_protocol.h"
+#include "esphome/components/remote_base/dooya_protocol.h"
+#include "esphome/components/remote_base/drayton_protocol.h"
+#include "esphome/components/remote_base/haier_protocol.h"
+#include "esphome/components/remote_base/jvc_protocol.h"
+#include "esphome/components/remote_base/keeloq_protocol.h"
+#include "esphome/components/remote_base/lg_protocol.h"
+#include "esphome/components/remote_base/magiquest_protocol.h"
+#include "esphome/components/remote_base/midea_protocol.h"
+#include "esphome/components/remote_base/nec_protocol.h"
+#include "esphome/components/remote_base/nexa_protocol.h"
+#include "esphome/components/remote_base/panasonic_protocol.h"
+#include "esphome/components/remote_base/pioneer_protocol.h"
+#include "esphome/components/remote_base/rc5_protocol.h"
+#include "esphome/components/remote_base/rc6_protocol.h"
+#include "esphome/components/remote_base/rc_switch_protocol.h"
+#include "esphome/components/remote_base/remote_base.h"
+#include "esphome/components/remote_base/samsung36_protocol.h"
+#include "esphome/components/remote_base/samsung_protocol.h"
+#include "esphome/components/remote_base/sony_protocol.h"
+#include "esphome/components/remote_base/toshiba_ac_protocol.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace esphome {
+
+uint32_t millis() { return 0; }
+uint32_t micros() { return 0; }
+void delay(uint32_t ms) {}
+void yield() {}
+void arch_feed_wdt() {}
+void arch_restart() { exit(1); }
+
+}  // namespace esphome
+
+using namespace esphome;
+using namespace esphome::remote_base;
+
+static const uint8_t TOLERANCE = 25;
+
+/// A receiver that is handed its frames instead of capturing them.
+class BenchReceiver : public RemoteReceiverBase {
+ public:
+  BenchReceiver() : RemoteReceiverBase(nullptr) { this->tolerance_ = TOLERANCE; }
+
+  void receive(const PackedTimings &frame) {
+    this->temp_ = frame;
+    this->call_listeners_dumpers_();
+  }
+};
+
+/// The receiver before it checked signatures.
+static void dump_all(const std::vector<RemoteReceiverDumperBase *> &dumpers, const PackedTimings &frame) {
+  const RemoteReceiveData src(frame, TOLERANCE);
+  bool success = false;
+  for (auto *dumper : dumpers) {
+    if (!dumper->is_secondary() && dumper->dump(src))
+      success = true;
+  }
+  if (!success) {
+    for (auto *dumper : dumpers) {
+      if (dumper->is_secondary())
+        dumper->dump(src);
+    }
+  }
+}
+
+static PackedTimings pack(const RawTimings &timings) {
+  PackedTimings packed;
+  for (int32_t length : timings)
+    packed.push_back(length);
+  return packed;
+}
+
+template<typename P> static PackedTimings encode(const typename P::ProtocolData &data) {
+  RemoteTransmitData dst;
+  P().encode(&dst, data);
+  return pack(dst.get_data());
+}
+
+/// Run \p f for 500 ms and return the time per frame in microseconds.
+template<typename F> static double us_per_frame(size_t frames, F &&f) {
+  const auto start = std::chrono::steady_clock::now();
+  size_t runs = 0;
+  while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(500)) {
+    f();
+    runs++;
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::micro>(elapsed).count() / runs / frames;
+}
+
+int main() {
+  std::vector<PackedTimings> ir, rf, noise;
+  ir.push_back(encode<NECProtocol>({0x1234, 0x5678, 1}));
+  ir.push_back(encode<SamsungProtocol>({0xE0E040BF, 32}));
+  ir.push_back(encode<SonyProtocol>({0xA90, 12}));
+  ir.push_back(encode<LGProtocol>({0x20DF10EF, 32}));
+  ir.push_back(encode<JVCProtocol>({0xC5E8}));
+  ir.push_back(encode<PanasonicProtocol>({0x4004, 0x100BCBD}));
+  ir.push_back(encode<RC5Protocol>({0x1, 0xC}));
+  ir.push_back(encode<RC6Protocol>({0, 0, 0x1, 0xC}));
+  ir.push_back(encode<PioneerProtocol>({0xA556, 0}));
+  ir.push_back(encode<DishProtocol>({1, 0x1F}));
+  ir.push_back(encode<Samsung36Protocol>({0x400, 0xE817}));
+  ir.push_back(encode<AEHAProtocol>({0x2002, {0x80, 0x3D}}));
+  ir.push_back(encode<CoolixProtocol>({0xB2BF40, 0xB2BF40}));
+  ir.push_back(encode<MagiQuestProtocol>({0x15, 0x1234}));
+  rf.push_back(encode<NexaProtocol>({0x1234567, 0, 1, 2, 0}));
+  rf.push_back(encode<DooyaProtocol>({0x123456, 1, 2, 3}));
+  rf.push_back(encode<DraytonProtocol>({0x1234, 3, 0x12}));
+  rf.push_back(encode<KeeloqProtocol>({0x12345678, 0x123456, 2, false, false}));
+  for (int protocol = 1; protocol <= 8; protocol++) {
+    RemoteTransmitData dst;
+    RC_SWITCH_PROTOCOLS[protocol].transmit(&dst, 0x5A5A5A, 24);
+    rf.push_back(pack(dst.get_data()));
+  }
+  std::mt19937 rng(1);
+  for (int i = 0; i < 400; i++) {
+    RawTimings timings;
+    int count = 4 + rng() % 120;
+    for (int j = 0; j < count; j++) {
+      int32_t length = 60 + rng() % 900;
+      timings.push_back(j % 2 ? -length : length);
+    }
+    noise.push_back(pack(timings));
+  }
+
+  std::vector<std::unique_ptr<RemoteReceiverDumperBase>> owned;
+  owned.emplace_back(new ABBWelcomeDumper());
+  owned.emplace_back(new AEHADumper());
+  owned.emplace_back(new ByronSXDumper());
+  owned.emplace_back(new CanalSatDumper());
+  owned.emplace_back(new CanalSatLDDumper());
+  owned.emplace_back(new CoolixDumper());
+  owned.emplace_back(new DishDumper());
+  owned.emplace_back(new DooyaDumper());
+  owned.emplace_back(new DraytonDumper());
+  owned.emplace_back(new HaierDumper());
+  owned.emplace_back(new JVCDumper());
+  owned.emplace_back(new KeeloqDumper());
+  owned.emplace_back(new LGDumper());
+  owned.emplace_back(new MagiQuestDumper());
+  owned.emplace_back(new MideaDumper());
+  owned.emplace_back(new NECDumper());
+  owned.emplace_back(new NexaDumper());
+  owned.emplace_back(new PanasonicDumper());
+  owned.emplace_back(new PioneerDumper());
+  owned.emplace_back(new RC5Dumper());
+  owned.emplace_back(new RC6Dumper());
+  owned.emplace_back(new RCSwitchDumper());
+  owned.emplace_back(new Samsung36Dumper());
+  owned.emplace_back(new SamsungDumper());
+  owned.emplace_back(new SonyDumper());
+  owned.emplace_back(new ToshibaAcDumper());
+  std::vector<RemoteReceiverDumperBase *> dumpers;
+  BenchReceiver receiver;
+  for (auto &dumper : owned) {
+    dumpers.push_back(dumper.get());
+    receiver.register_dumper(dumper.get());
+  }
+
+  // every frame a dumper decodes has to pass its signature, also with timing jitter
+  std::vector<PackedTimings> checked = ir;
+  checked.insert(checked.end(), rf.begin(), rf.end());
+  for (size_t i = 0, frames = checked.size(); i < frames; i++) {
+    for (int copy = 0; copy < 50; copy++) {
+      PackedTimings jittered;
+      for (size_t j = 0; j < checked[i].size(); j++)
+        jittered.push_back(checked[i][j] * (80 + int32_t(rng() % 41)) / 100);
+      checked.push_back(jittered);
+    }
+  }
+  checked.insert(checked.end(), noise.begin(), noise.end());
+  size_t decoded = 0, wrongly_skipped = 0, skipped = 0;
+  for (const auto &frame : checked) {
+    const RemoteReceiveData src(frame, TOLERANCE);
+    for (auto *dumper : dumpers) {
+      const bool dumped = dumper->dump(src);
+      const bool matches = src.matches(dumper->get_signature());
+      decoded += dumped;
+      skipped += !matches;
+      wrongly_skipped += dumped && !matches;
+    }
+  }
+  printf("check: %zu frames, %zu decoded, %zu of %zu dumper calls skipped, %zu wrongly\n", checked.size(), decoded,
+         skipped, checked.size() * dumpers.size(), wrongly_skipped);
+  if (wrongly_skipped != 0)
+    return 1;
+
+  printf("%-6s %7s %18s %18s\n", "frames", "count", "all dumpers us", "signatures us");
+  struct Corpus {
+    const char *name;
+    const std::vector<PackedTimings> *frames;
+  };
+  for (const Corpus &corpus : {Corpus{"IR", &ir}, Corpus{"RF", &rf}, Corpus{"noise", &noise}}) {
+    double all_us = us_per_frame(corpus.frames->size(), [&]() {
+      for (const auto &frame : *corpus.frames)
+        dump_all(dumpers, frame);
+    });
+    double signatures_us = us_per_frame(corpus.frames->size(), [&]() {
+      for (const auto &frame : *corpus.frames)
+        receiver.receive(frame);
+    });
+    printf("%-6s %7zu %18.2f %18.2f\n", corpus.name, corpus.frames->size(), all_us, signatures_us);
+  }
+  return 0;
+}
@@ -0,0 +1,29 @@
+#!/usr/bin/env bash
+# Build and run a host benchmark, e.g.: tests/benchmarks/run.sh tests/benchmarks/scheduler/scheduler_bench.cpp
+#
+# Like a firmware build, the sources are copied and get a generated esphome/core/defines.h. A benchmark lists the
+# feature flags it needs in `// BENCH_DEFINES:` comments and the sources it links besides itself in
+# `// BENCH_SOURCES:` comments. Extra compiler flags can be passed in CXXFLAGS, arguments after the benchmark are
+# passed to it.
+set -euo pipefail
+
+cd "$(dirname "$0")/../.."
+bench="$(realpath "$1")"
+shift
+
+work="$(mktemp -d)"
+trap 'rm -rf "$work"' EXIT
+cp -r esphome "$work/"
+{
+  echo '#pragma once'
+  echo '#include "esphome/core/macros.h"'
+  echo '#define ESPHOME_BOARD "host"'
+  echo '#define ESPHOME_VARIANT "host"'
+  sed -n 's|^// BENCH_DEFINES: ||p' "$bench" | tr ' ' '\n' | sed -n 's|^\(.\+\)$|#define \1|p'
+} >"$work/esphome/core/defines.h"
+sources=$(sed -n 's|^// BENCH_SOURCES: ||p' "$bench" | tr '\n' ' ')
+
+cd "$work"
+# shellcheck disable=SC2086
+g++ -std=gnu++17 -O2 -DUSE_HOST '-DUSE_ESPHOME_HOST_MAC_ADDRESS={0x02, 0, 0, 0, 0, 1}' -I. ${CXXFLAGS:-} "$bench" $sources -lpthread -o bench
+./bench "$@"
@@ -0,0 +1,86 @@
+// Host microbenchmark for the scheduler: cost of re-arming, cancelling and expiring named timers as the number of
+// live timers grows from 10 to 10,000. Time is simulated, so only the scheduler's own work is measured.
+//
+// BENCH_SOURCES: esphome/core/scheduler.cpp esphome/core/component.cpp esphome/core/helpers.cpp
+// BENCH_SOURCES: esphome/core/log.cpp
+
+#include "esphome/core/application.h"
+#include "esphome/core/scheduler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace esphome {
+
+Application App;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+void Application::wake_loop_any_context() {}
+void Application::feed_wdt() {}
+
+static uint32_t fake_now = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+uint32_t millis() { return fake_now; }
+uint32_t micros() { return fake_now * 1000; }
+void delay(uint32_t ms) { fake_now += ms; }
+void yield() {}
+void arch_feed_wdt() {}
+
+}  // namespace esphome
+
+using namespace esphome;
+
+class BenchComponent : public Component {};
+
+template<typename F> static double ns_per_op(size_t ops, F &&f) {
+  const auto start = std::chrono::steady_clock::now();
+  f();
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(elapsed).count() / ops;
+}
+
+int main() {
+  printf("%8s %12s %12s %12s\n", "timers", "re-arm ns", "cancel ns", "expire ns");
+  for (size_t count : {10, 100, 1000, 10000}) {
+    Scheduler scheduler;
+    BenchComponent component;
+    std::vector<std::string> names;
+    for (size_t i = 0; i < count; i++)
+      names.push_back("timer_" + std::to_string(i));
+    uint32_t fired = 0;
+
+    // Arm every timer far in the future, then re-arm them in a scattered order, like debounce filters do.
+    for (auto &name : names)
+      scheduler.set_timeout(&component, name, 1000000, [&fired]() { fired++; });
+    scheduler.call();
+    const size_t rearms = 100000;
+    double rearm_ns = ns_per_op(rearms, [&]() {
+      for (size_t i = 0; i < rearms; i++) {
+        scheduler.set_timeout(&component, names[(i * 7919) % count], 1000000 + i % 1000, [&fired]() { fired++; });
+        if (i % count == count - 1)
+          scheduler.call();
+      }
+    });
+    scheduler.call();
+
+    double cancel_ns = ns_per_op(count, [&]() {
+      for (auto &name : names)
+        scheduler.cancel_timeout(&component, name);
+    });
+    scheduler.call();
+
+    // Arm all timers with spread out deadlines and let them expire.
+    for (size_t i = 0; i < count; i++)
+      scheduler.set_timeout(&component, names[i], 1 + i % 1000, [&fired]() { fired++; });
+    scheduler.call();
+    fired = 0;
+    double expire_ns = ns_per_op(count, [&]() {
+      while (fired < count) {
+        fake_now++;
+        scheduler.call();
+      }
+    });
+
+    printf("%8zu %12.1f %12.1f %12.1f\n", count, rearm_ns, cancel_ns, expire_ns);
+  }
+  return 0;
+}